@@ -439,6 +439,64 @@ private Q_SLOTS:
 
         QCOMPARE(albumsModel.data(albumsModel.index(2, 0), AlbumModel::TrackNumberRole).toInt(), 5);
     }
+
+    void loadTracksOnDemand()
+    {
+        auto configDirectory = QDir(QStandardPaths::writableLocation(QStandardPaths::QStandardPaths::AppDataLocation));
+        auto rootDirectory = QDir::root();
+        rootDirectory.mkpath(configDirectory.path());
+        auto fileName = configDirectory.filePath(QStringLiteral("elisaMusicDatabase.sqlite"));
+        QFile dbFile(fileName);
+        auto dbExists = dbFile.exists();
+
+        if (dbExists) {
+            QCOMPARE(dbFile.remove(), true);
+        }
+
+        DatabaseInterface musicDb;
+        AlbumModel albumsModel;
+
+        connect(&albumsModel, &AlbumModel::albumTracksRequested,
+                &musicDb, &DatabaseInterface::loadAlbumTracks);
+        connect(&musicDb, &DatabaseInterface::albumTracksLoaded,
+                &albumsModel, &AlbumModel::albumTracksLoaded);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QSignalSpy beginInsertRowsSpy(&albumsModel, &AlbumModel::rowsAboutToBeInserted);
+        QSignalSpy endInsertRowsSpy(&albumsModel, &AlbumModel::rowsInserted);
+        QSignalSpy albumTracksRequestedSpy(&albumsModel, &AlbumModel::albumTracksRequested);
+
+        auto allAlbums = musicDb.allAlbums();
+
+        QCOMPARE(allAlbums.count(), 4);
+
+        auto firstAlbum = allAlbums[0];
+
+        QCOMPARE(firstAlbum.tracksLoaded(), false);
+        QCOMPARE(firstAlbum.tracksCount(), 4);
+        QCOMPARE(firstAlbum.allTracksTitle().count(), 4);
+        QCOMPARE(firstAlbum.allArtists().count(), 4);
+        QCOMPARE(firstAlbum.highestTrackRating(), 4);
+
+        albumsModel.setAlbumData(firstAlbum);
+
+        QCOMPARE(albumsModel.rowCount(), 0);
+        QCOMPARE(beginInsertRowsSpy.count(), 0);
+        QCOMPARE(endInsertRowsSpy.count(), 0);
+
+        QVERIFY(albumTracksRequestedSpy.wait());
+
+        QCOMPARE(albumTracksRequestedSpy.count(), 1);
+        QCOMPARE(albumTracksRequestedSpy.at(0).at(0).toULongLong(), firstAlbum.databaseId());
+
+        QCOMPARE(albumsModel.rowCount(), 4);
+        QCOMPARE(beginInsertRowsSpy.count(), 1);
+        QCOMPARE(endInsertRowsSpy.count(), 1);
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), AlbumModel::TitleRole).toString(), QStringLiteral("track1"));
+    }
 };
 
 QTEST_MAIN(AlbumModelTests)
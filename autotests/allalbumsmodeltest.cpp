@@ -21,6 +21,7 @@
 #include "musicaudiotrack.h"
 #include "databaseinterface.h"
 #include "allalbumsmodel.h"
+#include "albumfilterproxymodel.h"
 
 #include <QObject>
 #include <QUrl>
@@ -32,6 +33,9 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QSet>
+#include <QCollator>
+#include <QPersistentModelIndex>
 
 #include <QDebug>
 
@@ -46,6 +50,41 @@ private:
     QList<MusicAudioTrack> mNewTracks;
     QHash<QString, QUrl> mNewCovers;
 
+    void checkAlbumsOrder(const AllAlbumsModel &albumsModel)
+    {
+        QCollator collator;
+        collator.setCaseSensitivity(Qt::CaseInsensitive);
+
+        auto albumsIds = QSet<qulonglong>();
+
+        for (int i = 0; i < albumsModel.rowCount(); ++i) {
+            const auto &currentIndex = albumsModel.index(i, 0);
+
+            QVERIFY(currentIndex.isValid());
+            QCOMPARE(albumsModel.parent(currentIndex).isValid(), false);
+
+            albumsIds.insert(albumsModel.data(currentIndex, AllAlbumsModel::DatabaseIdRole).toULongLong());
+
+            if (i == 0) {
+                continue;
+            }
+
+            const auto &previousIndex = albumsModel.index(i - 1, 0);
+
+            auto result = collator.compare(albumsModel.data(previousIndex, AllAlbumsModel::ArtistRole).toString(),
+                                           albumsModel.data(currentIndex, AllAlbumsModel::ArtistRole).toString());
+            if (result == 0) {
+                result = collator.compare(albumsModel.data(previousIndex, AllAlbumsModel::TitleRole).toString(),
+                                          albumsModel.data(currentIndex, AllAlbumsModel::TitleRole).toString());
+            }
+
+            QVERIFY(result <= 0);
+        }
+
+        QCOMPARE(albumsIds.size(), albumsModel.rowCount());
+        QCOMPARE(albumsModel.data(albumsModel.index(albumsModel.rowCount(), 0), AllAlbumsModel::TitleRole).isValid(), false);
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -163,7 +202,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 18);
+        QCOMPARE(dataChangedSpy.count(), 4);
 
         auto trackId = musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track1"), QStringLiteral("album1"), QStringLiteral("artist1"));
 
@@ -175,7 +214,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 19);
+        QCOMPARE(dataChangedSpy.count(), 5);
     }
 
     void removeOneAlbum()
@@ -221,7 +260,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 18);
+        QCOMPARE(dataChangedSpy.count(), 4);
 
         auto firstTrackId = musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track1"), QStringLiteral("album1"), QStringLiteral("artist1"));
         auto firstTrack = musicDb.trackFromDatabaseId(firstTrackId);
@@ -238,7 +277,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 1);
         QCOMPARE(endRemoveRowsSpy.count(), 1);
-        QCOMPARE(dataChangedSpy.count(), 22);
+        QCOMPARE(dataChangedSpy.count(), 4);
     }
 
     void addOneTrack()
@@ -284,7 +323,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 18);
+        QCOMPARE(dataChangedSpy.count(), 4);
 
         auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track6"),
                 QStringLiteral("artist2"), QStringLiteral("album4"), QStringLiteral("artist2"), 6, 1, QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/$19"))},
@@ -298,7 +337,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 19);
+        QCOMPARE(dataChangedSpy.count(), 5);
     }
 
     void addOneAlbum()
@@ -349,7 +388,7 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 4);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 18);
+        QCOMPARE(dataChangedSpy.count(), 4);
 
         auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track1"),
                 QStringLiteral("artist2"), QStringLiteral("album5"), QStringLiteral("artist2"), 1, 1, QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/$19"))},
@@ -372,7 +411,281 @@ private Q_SLOTS:
         QCOMPARE(endInsertRowsSpy.count(), 5);
         QCOMPARE(beginRemoveRowsSpy.count(), 0);
         QCOMPARE(endRemoveRowsSpy.count(), 0);
-        QCOMPARE(dataChangedSpy.count(), 19);
+        QCOMPARE(dataChangedSpy.count(), 5);
+    }
+
+    void addAlbumsInOneRange()
+    {
+        auto configDirectory = QDir(QStandardPaths::writableLocation(QStandardPaths::QStandardPaths::AppDataLocation));
+        auto rootDirectory = QDir::root();
+        rootDirectory.mkpath(configDirectory.path());
+        auto fileName = configDirectory.filePath(QStringLiteral("elisaMusicDatabase.sqlite"));
+        QFile dbFile(fileName);
+        auto dbExists = dbFile.exists();
+
+        if (dbExists) {
+            QCOMPARE(dbFile.remove(), true);
+        }
+
+        DatabaseInterface musicDb;
+        AllAlbumsModel albumsModel;
+
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &albumsModel, &AllAlbumsModel::albumsAdded);
+        connect(&musicDb, &DatabaseInterface::albumsModified,
+                &albumsModel, &AllAlbumsModel::albumsModified);
+        connect(&musicDb, &DatabaseInterface::albumsRemoved,
+                &albumsModel, &AllAlbumsModel::albumsRemoved);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy beginInsertRowsSpy(&albumsModel, &AllAlbumsModel::rowsAboutToBeInserted);
+        QSignalSpy endInsertRowsSpy(&albumsModel, &AllAlbumsModel::rowsInserted);
+        QSignalSpy beginRemoveRowsSpy(&albumsModel, &AllAlbumsModel::rowsAboutToBeRemoved);
+        QSignalSpy endRemoveRowsSpy(&albumsModel, &AllAlbumsModel::rowsRemoved);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(beginInsertRowsSpy.count(), 1);
+        QCOMPARE(endInsertRowsSpy.count(), 1);
+        QCOMPARE(beginRemoveRowsSpy.count(), 0);
+        QCOMPARE(endRemoveRowsSpy.count(), 0);
+
+        QCOMPARE(beginInsertRowsSpy.at(0).at(1).toInt(), 0);
+        QCOMPARE(beginInsertRowsSpy.at(0).at(2).toInt(), 3);
+        QCOMPARE(albumsModel.rowCount(), 4);
+    }
+
+    void sortAlbums()
+    {
+        DatabaseInterface musicDb;
+        AllAlbumsModel albumsModel;
+
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &albumsModel, &AllAlbumsModel::albumsAdded);
+
+        musicDb.init(QStringLiteral("testDbSortAlbums"));
+
+        QCOMPARE(albumsModel.sortRole(), AllAlbumsModel::ArtistRole);
+
+        musicDb.insertTracksList(mNewTracks.mid(10), mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(albumsModel.rowCount(), 2);
+
+        QSignalSpy beginInsertRowsSpy(&albumsModel, &AllAlbumsModel::rowsAboutToBeInserted);
+
+        musicDb.insertTracksList(mNewTracks.mid(0, 10), mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(beginInsertRowsSpy.count(), 2);
+        QCOMPARE(albumsModel.rowCount(), 4);
+
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album2"));
+        QCOMPARE(albumsModel.data(albumsModel.index(1, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album3"));
+        QCOMPARE(albumsModel.data(albumsModel.index(2, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album4"));
+        QCOMPARE(albumsModel.data(albumsModel.index(3, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album1"));
+
+        QSignalSpy sortRoleChangedSpy(&albumsModel, &AllAlbumsModel::sortRoleChanged);
+
+        albumsModel.setSortRole(AllAlbumsModel::TitleRole);
+
+        QCOMPARE(sortRoleChangedSpy.count(), 1);
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album1"));
+        QCOMPARE(albumsModel.data(albumsModel.index(1, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album2"));
+        QCOMPARE(albumsModel.data(albumsModel.index(2, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album3"));
+        QCOMPARE(albumsModel.data(albumsModel.index(3, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album4"));
+    }
+
+    void moveModifiedAlbums()
+    {
+        DatabaseInterface musicDb;
+        AllAlbumsModel albumsModel;
+
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &albumsModel, &AllAlbumsModel::albumsAdded);
+
+        musicDb.init(QStringLiteral("testDbMoveModifiedAlbums"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(albumsModel.rowCount(), 4);
+        checkAlbumsOrder(albumsModel);
+
+        QSignalSpy beginMoveRowsSpy(&albumsModel, &AllAlbumsModel::rowsAboutToBeMoved);
+        QSignalSpy endMoveRowsSpy(&albumsModel, &AllAlbumsModel::rowsMoved);
+        QSignalSpy dataChangedSpy(&albumsModel, &AllAlbumsModel::dataChanged);
+
+        auto movedAlbum = albumsModel.data(albumsModel.index(0, 0), AllAlbumsModel::AlbumDataRole).value<MusicAlbum>();
+        QPersistentModelIndex movedIndex(albumsModel.index(0, 0));
+
+        movedAlbum.setArtist(QStringLiteral("zzz"));
+        albumsModel.albumsModified({movedAlbum});
+
+        QCOMPARE(beginMoveRowsSpy.count(), 1);
+        QCOMPARE(endMoveRowsSpy.count(), 1);
+        QCOMPARE(beginMoveRowsSpy.at(0).at(1).toInt(), 0);
+        QCOMPARE(beginMoveRowsSpy.at(0).at(2).toInt(), 0);
+        QCOMPARE(beginMoveRowsSpy.at(0).at(4).toInt(), 4);
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 3);
+        QCOMPARE(movedIndex.row(), 3);
+        QCOMPARE(albumsModel.rowCount(), 4);
+        QCOMPARE(albumsModel.data(albumsModel.index(3, 0), AllAlbumsModel::DatabaseIdRole).toULongLong(), movedAlbum.databaseId());
+        checkAlbumsOrder(albumsModel);
+
+        movedAlbum.setArtist(QStringLiteral("aaa"));
+        albumsModel.albumsModified({movedAlbum});
+
+        QCOMPARE(beginMoveRowsSpy.count(), 2);
+        QCOMPARE(endMoveRowsSpy.count(), 2);
+        QCOMPARE(beginMoveRowsSpy.at(1).at(1).toInt(), 3);
+        QCOMPARE(beginMoveRowsSpy.at(1).at(2).toInt(), 3);
+        QCOMPARE(beginMoveRowsSpy.at(1).at(4).toInt(), 0);
+        QCOMPARE(dataChangedSpy.count(), 2);
+        QCOMPARE(dataChangedSpy.at(1).at(0).toModelIndex().row(), 0);
+        QCOMPARE(movedIndex.row(), 0);
+        QCOMPARE(albumsModel.rowCount(), 4);
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), AllAlbumsModel::DatabaseIdRole).toULongLong(), movedAlbum.databaseId());
+        checkAlbumsOrder(albumsModel);
+
+        movedAlbum.setTitle(QStringLiteral("album0"));
+        albumsModel.albumsModified({movedAlbum});
+
+        QCOMPARE(beginMoveRowsSpy.count(), 2);
+        QCOMPARE(endMoveRowsSpy.count(), 2);
+        QCOMPARE(dataChangedSpy.count(), 3);
+        QCOMPARE(dataChangedSpy.at(2).at(0).toModelIndex().row(), 0);
+        QCOMPARE(movedIndex.row(), 0);
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album0"));
+        checkAlbumsOrder(albumsModel);
+    }
+
+    void removeAndModifyAlbumsInRanges()
+    {
+        DatabaseInterface musicDb;
+        AllAlbumsModel albumsModel;
+
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &albumsModel, &AllAlbumsModel::albumsAdded);
+
+        musicDb.init(QStringLiteral("testDbRemoveAlbumsInRanges"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(albumsModel.rowCount(), 4);
+
+        auto allAlbums = QList<MusicAlbum>();
+        for (int i = 0; i < albumsModel.rowCount(); ++i) {
+            allAlbums.push_back(albumsModel.data(albumsModel.index(i, 0), AllAlbumsModel::AlbumDataRole).value<MusicAlbum>());
+        }
+
+        QSignalSpy dataChangedSpy(&albumsModel, &AllAlbumsModel::dataChanged);
+        QSignalSpy beginRemoveRowsSpy(&albumsModel, &AllAlbumsModel::rowsAboutToBeRemoved);
+        QSignalSpy endRemoveRowsSpy(&albumsModel, &AllAlbumsModel::rowsRemoved);
+
+        albumsModel.albumsModified({allAlbums[3], allAlbums[0], allAlbums[1]});
+
+        QCOMPARE(dataChangedSpy.count(), 2);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 0);
+        QCOMPARE(dataChangedSpy.at(0).at(1).toModelIndex().row(), 1);
+        QCOMPARE(dataChangedSpy.at(1).at(0).toModelIndex().row(), 3);
+        QCOMPARE(dataChangedSpy.at(1).at(1).toModelIndex().row(), 3);
+
+        albumsModel.albumsRemoved({allAlbums[0], allAlbums[3], allAlbums[1]});
+
+        QCOMPARE(beginRemoveRowsSpy.count(), 2);
+        QCOMPARE(endRemoveRowsSpy.count(), 2);
+        QCOMPARE(beginRemoveRowsSpy.at(0).at(1).toInt(), 3);
+        QCOMPARE(beginRemoveRowsSpy.at(0).at(2).toInt(), 3);
+        QCOMPARE(beginRemoveRowsSpy.at(1).at(1).toInt(), 0);
+        QCOMPARE(beginRemoveRowsSpy.at(1).at(2).toInt(), 1);
+        QCOMPARE(albumsModel.rowCount(), 1);
+        QCOMPARE(albumsModel.data(albumsModel.index(0, 0), AllAlbumsModel::DatabaseIdRole).toULongLong(), allAlbums[2].databaseId());
+
+        albumsModel.albumRemoved(allAlbums[2]);
+
+        QCOMPARE(beginRemoveRowsSpy.count(), 3);
+        QCOMPARE(albumsModel.rowCount(), 0);
+    }
+
+    void filterFromSearchResults()
+    {
+        DatabaseInterface musicDb;
+        AllAlbumsModel albumsModel;
+        AlbumFilterProxyModel proxyModel;
+
+        proxyModel.setSourceModel(&albumsModel);
+
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &albumsModel, &AllAlbumsModel::albumsAdded);
+        connect(&musicDb, &DatabaseInterface::albumsModified,
+                &albumsModel, &AllAlbumsModel::albumsModified);
+        connect(&musicDb, &DatabaseInterface::searchResultsReady,
+                &proxyModel, &AlbumFilterProxyModel::setSearchResults);
+
+        musicDb.init(QStringLiteral("testDbFilterFromSearchResults"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(proxyModel.rowCount(), 4);
+
+        QSignalSpy layoutChangedSpy(&proxyModel, &AlbumFilterProxyModel::layoutChanged);
+        QSignalSpy rowsRemovedSpy(&proxyModel, &AlbumFilterProxyModel::rowsRemoved);
+
+        proxyModel.setFilterText(QStringLiteral("artist3"));
+
+        QCOMPARE(proxyModel.rowCount(), 4);
+        QCOMPARE(rowsRemovedSpy.count(), 0);
+        QCOMPARE(layoutChangedSpy.count(), 0);
+
+        musicDb.searchItems(proxyModel.filterText());
+
+        QCOMPARE(proxyModel.rowCount(), 1);
+        QCOMPARE(proxyModel.data(proxyModel.index(0, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album1"));
+
+        proxyModel.setFilterText(QStringLiteral("album"));
+
+        QCOMPARE(proxyModel.rowCount(), 1);
+
+        musicDb.searchItems(QStringLiteral("artist"));
+
+        QCOMPARE(proxyModel.rowCount(), 1);
+
+        musicDb.searchItems(proxyModel.filterText());
+
+        QCOMPARE(proxyModel.rowCount(), 4);
+
+        proxyModel.setFilterText(QStringLiteral("album2 artist1"));
+
+        QCOMPARE(proxyModel.rowCount(), 4);
+
+        musicDb.searchItems(proxyModel.filterText());
+
+        QCOMPARE(proxyModel.rowCount(), 1);
+        QCOMPARE(proxyModel.data(proxyModel.index(0, 0), AllAlbumsModel::TitleRole).toString(), QStringLiteral("album2"));
+
+        const auto layoutChangedCount = layoutChangedSpy.count();
+
+        proxyModel.setFilterText(QStringLiteral("album2 artist"));
+        musicDb.searchItems(proxyModel.filterText());
+
+        QCOMPARE(proxyModel.rowCount(), 1);
+        QCOMPARE(layoutChangedSpy.count(), layoutChangedCount);
+
+        auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track1"),
+                QStringLiteral("artist5"), QStringLiteral("album2 artist1 live"), QStringLiteral("artist5"), 1, 1, QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/$19"))},
+        {QUrl::fromLocalFile(QStringLiteral("file://image$19"))}, 1};
+
+        musicDb.insertTracksList({newTrack}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(proxyModel.rowCount(), 1);
+
+        musicDb.searchItems(proxyModel.filterText());
+
+        QCOMPARE(proxyModel.rowCount(), 2);
+
+        proxyModel.setFilterText({});
+
+        QCOMPARE(proxyModel.rowCount(), 5);
     }
 };
 
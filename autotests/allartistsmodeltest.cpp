@@ -32,6 +32,9 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QSet>
+#include <QCollator>
+#include <QPersistentModelIndex>
 
 #include <QDebug>
 
@@ -46,6 +49,35 @@ private:
     QList<MusicAudioTrack> mNewTracks;
     QHash<QString, QUrl> mNewCovers;
 
+    void checkArtistsOrder(const AllArtistsModel &artistsModel)
+    {
+        QCollator collator;
+        collator.setCaseSensitivity(Qt::CaseInsensitive);
+
+        auto artistsNames = QSet<QString>();
+
+        for (int i = 0; i < artistsModel.rowCount(); ++i) {
+            const auto &currentIndex = artistsModel.index(i, 0);
+
+            QVERIFY(currentIndex.isValid());
+            QCOMPARE(artistsModel.parent(currentIndex).isValid(), false);
+
+            artistsNames.insert(artistsModel.data(currentIndex, AllArtistsModel::NameRole).toString());
+
+            if (i == 0) {
+                continue;
+            }
+
+            const auto &previousIndex = artistsModel.index(i - 1, 0);
+
+            QVERIFY(collator.compare(artistsModel.data(previousIndex, AllArtistsModel::NameRole).toString(),
+                                     artistsModel.data(currentIndex, AllArtistsModel::NameRole).toString()) <= 0);
+        }
+
+        QCOMPARE(artistsNames.size(), artistsModel.rowCount());
+        QCOMPARE(artistsModel.data(artistsModel.index(artistsModel.rowCount(), 0), AllArtistsModel::NameRole).isValid(), false);
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -252,6 +284,152 @@ private Q_SLOTS:
         QCOMPARE(endRemoveRowsSpy.count(), 0);
         QCOMPARE(dataChangedSpy.count(), 0);
     }
+
+    void modifyOneArtist()
+    {
+        DatabaseInterface musicDb;
+        AllArtistsModel artistsModel;
+
+        connect(&musicDb, &DatabaseInterface::artistsAdded,
+                &artistsModel, &AllArtistsModel::artistsAdded);
+        connect(&musicDb, &DatabaseInterface::artistsModified,
+                &artistsModel, &AllArtistsModel::artistsModified);
+        connect(&musicDb, &DatabaseInterface::artistsRemoved,
+                &artistsModel, &AllArtistsModel::artistsRemoved);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy beginRemoveRowsSpy(&artistsModel, &AllArtistsModel::rowsAboutToBeRemoved);
+        QSignalSpy dataChangedSpy(&artistsModel, &AllArtistsModel::dataChanged);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(artistsModel.rowCount(), 6);
+        QCOMPARE(beginRemoveRowsSpy.count(), 0);
+        QCOMPARE(dataChangedSpy.count(), 0);
+
+        auto artistRow = -1;
+        for (int i = 0; i < artistsModel.rowCount(); ++i) {
+            if (artistsModel.data(artistsModel.index(i, 0), AllArtistsModel::NameRole).toString() == QStringLiteral("artist2")) {
+                artistRow = i;
+            }
+        }
+
+        QVERIFY(artistRow != -1);
+        QCOMPARE(artistsModel.data(artistsModel.index(artistRow, 0), AllArtistsModel::ArtistsCountRole).toInt(), 2);
+
+        auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track1"),
+                QStringLiteral("artist2"), QStringLiteral("album5"), QStringLiteral("artist2"), 1, 1, QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/$19"))},
+        {QUrl::fromLocalFile(QStringLiteral("file://image$19"))}, 5};
+
+        musicDb.insertTracksList({newTrack}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(artistsModel.rowCount(), 6);
+        QCOMPARE(beginRemoveRowsSpy.count(), 0);
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), artistRow);
+        QCOMPARE(dataChangedSpy.at(0).at(1).toModelIndex().row(), artistRow);
+        QCOMPARE(artistsModel.data(artistsModel.index(artistRow, 0), AllArtistsModel::ArtistsCountRole).toInt(), 3);
+
+        musicDb.removeTracksList({newTrack.resourceURI()});
+
+        QCOMPARE(artistsModel.rowCount(), 6);
+        QCOMPARE(beginRemoveRowsSpy.count(), 0);
+        QCOMPARE(dataChangedSpy.count(), 2);
+        QCOMPARE(artistsModel.data(artistsModel.index(artistRow, 0), AllArtistsModel::ArtistsCountRole).toInt(), 2);
+    }
+
+    void sortArtists()
+    {
+        DatabaseInterface musicDb;
+        AllArtistsModel artistsModel;
+
+        connect(&musicDb, &DatabaseInterface::artistsAdded,
+                &artistsModel, &AllArtistsModel::artistsAdded);
+
+        musicDb.init(QStringLiteral("testDbSortArtists"));
+
+        musicDb.insertTracksList(mNewTracks.mid(10), mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(artistsModel.rowCount(), 1);
+
+        QSignalSpy beginInsertRowsSpy(&artistsModel, &AllArtistsModel::rowsAboutToBeInserted);
+
+        musicDb.insertTracksList(mNewTracks.mid(0, 10), mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(beginInsertRowsSpy.count(), 2);
+        QCOMPARE(artistsModel.rowCount(), 6);
+
+        QCOMPARE(artistsModel.data(artistsModel.index(0, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("artist1"));
+        QCOMPARE(artistsModel.data(artistsModel.index(1, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("artist1 and artist2"));
+        QCOMPARE(artistsModel.data(artistsModel.index(2, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("artist2"));
+        QCOMPARE(artistsModel.data(artistsModel.index(3, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("artist3"));
+        QCOMPARE(artistsModel.data(artistsModel.index(4, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("artist4"));
+        QCOMPARE(artistsModel.data(artistsModel.index(5, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("Various Artists"));
+        checkArtistsOrder(artistsModel);
+    }
+
+    void moveModifiedArtists()
+    {
+        DatabaseInterface musicDb;
+        AllArtistsModel artistsModel;
+
+        connect(&musicDb, &DatabaseInterface::artistsAdded,
+                &artistsModel, &AllArtistsModel::artistsAdded);
+
+        musicDb.init(QStringLiteral("testDbMoveModifiedArtists"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(artistsModel.rowCount(), 6);
+        checkArtistsOrder(artistsModel);
+
+        auto movedArtist = MusicArtist();
+        for (const auto &oneArtist : musicDb.allArtists()) {
+            if (oneArtist.name() == QStringLiteral("artist1")) {
+                movedArtist = oneArtist;
+            }
+        }
+
+        QVERIFY(movedArtist.isValid());
+        QCOMPARE(artistsModel.data(artistsModel.index(0, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("artist1"));
+
+        QSignalSpy beginMoveRowsSpy(&artistsModel, &AllArtistsModel::rowsAboutToBeMoved);
+        QSignalSpy endMoveRowsSpy(&artistsModel, &AllArtistsModel::rowsMoved);
+        QSignalSpy dataChangedSpy(&artistsModel, &AllArtistsModel::dataChanged);
+
+        QPersistentModelIndex movedIndex(artistsModel.index(0, 0));
+
+        movedArtist.setName(QStringLiteral("zzz"));
+        artistsModel.artistsModified({movedArtist});
+
+        QCOMPARE(beginMoveRowsSpy.count(), 1);
+        QCOMPARE(endMoveRowsSpy.count(), 1);
+        QCOMPARE(beginMoveRowsSpy.at(0).at(1).toInt(), 0);
+        QCOMPARE(beginMoveRowsSpy.at(0).at(2).toInt(), 0);
+        QCOMPARE(beginMoveRowsSpy.at(0).at(4).toInt(), 6);
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 5);
+        QCOMPARE(movedIndex.row(), 5);
+        QCOMPARE(artistsModel.rowCount(), 6);
+        QCOMPARE(artistsModel.data(artistsModel.index(5, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("zzz"));
+        checkArtistsOrder(artistsModel);
+
+        movedArtist.setName(QStringLiteral("aaa"));
+        artistsModel.artistsModified({movedArtist});
+
+        QCOMPARE(beginMoveRowsSpy.count(), 2);
+        QCOMPARE(endMoveRowsSpy.count(), 2);
+        QCOMPARE(beginMoveRowsSpy.at(1).at(1).toInt(), 5);
+        QCOMPARE(beginMoveRowsSpy.at(1).at(2).toInt(), 5);
+        QCOMPARE(beginMoveRowsSpy.at(1).at(4).toInt(), 0);
+        QCOMPARE(dataChangedSpy.count(), 2);
+        QCOMPARE(dataChangedSpy.at(1).at(0).toModelIndex().row(), 0);
+        QCOMPARE(movedIndex.row(), 0);
+        QCOMPARE(artistsModel.rowCount(), 6);
+        QCOMPARE(artistsModel.data(artistsModel.index(0, 0), AllArtistsModel::NameRole).toString(), QStringLiteral("aaa"));
+        checkArtistsOrder(artistsModel);
+    }
 };
 
 QTEST_MAIN(AllArtistsModelTests)
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "abstractfile/coverresolver.h"
+
+#include "tagfixtures.h"
+
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QString>
+#include <QByteArray>
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QCryptographicHash>
+#include <QTemporaryDir>
+
+#include <QDebug>
+
+#include <QtTest>
+
+using namespace TagFixtures;
+
+class CoverResolverTest: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    QByteArray pngPicture(int width, int height) const
+    {
+        QImage picture(width, height, QImage::Format_RGB32);
+        picture.fill(Qt::darkCyan);
+
+        QByteArray pictureData;
+        QBuffer pictureBuffer(&pictureData);
+        pictureBuffer.open(QIODevice::WriteOnly);
+        picture.save(&pictureBuffer, "PNG");
+
+        return pictureData;
+    }
+
+    QByteArray jpegPicture(int width, int height) const
+    {
+        QImage picture(width, height, QImage::Format_RGB32);
+        picture.fill(Qt::darkCyan);
+
+        QByteArray pictureData;
+        QBuffer pictureBuffer(&pictureData);
+        pictureBuffer.open(QIODevice::WriteOnly);
+        picture.save(&pictureBuffer, "JPG");
+
+        return pictureData;
+    }
+
+    QByteArray apicTag(const QByteArray &mimeType, const QByteArray &picture) const
+    {
+        const auto &apicFrame = QByteArray(1, '\0') + mimeType + QByteArray(1, '\0') +
+                QByteArray(1, '\x03') + QByteArray("front") + QByteArray(1, '\0') + picture;
+
+        return id3v2Tag(3, id3v2Frame(3, "APIC", apicFrame));
+    }
+
+    QByteArray flacPictureBlock(const QByteArray &picture) const
+    {
+        const auto &mimeType = QByteArray("image/png");
+
+        return bigEndian32(3) + bigEndian32(mimeType.size()) + mimeType + bigEndian32(0) +
+                bigEndian32(0) + bigEndian32(0) + bigEndian32(0) + bigEndian32(0) +
+                bigEndian32(picture.size()) + picture;
+    }
+
+    void writeFile(const QString &fileName, const QByteArray &content) const
+    {
+        QFile newFile(fileName);
+        QCOMPARE(newFile.open(QIODevice::WriteOnly), true);
+        QCOMPARE(newFile.write(content), static_cast<qint64>(content.size()));
+    }
+
+private Q_SLOTS:
+
+    void directoryCoverByPriority()
+    {
+        QTemporaryDir musicDirectory;
+        QTemporaryDir cacheDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+        QCOMPARE(cacheDirectory.isValid(), true);
+
+        const auto &picture = pngPicture(16, 16);
+
+        writeFile(musicDirectory.path() + QStringLiteral("/front.png"), picture);
+        writeFile(musicDirectory.path() + QStringLiteral("/Folder.PNG"), picture);
+        writeFile(musicDirectory.path() + QStringLiteral("/track.ogg"), QByteArray());
+
+        CoverResolver resolver(cacheDirectory.path());
+
+        const auto &trackUrl = QUrl::fromLocalFile(musicDirectory.path() + QStringLiteral("/track.ogg"));
+
+        QCOMPARE(resolver.coverForTrack(trackUrl, QStringLiteral("album")),
+                 QUrl::fromLocalFile(musicDirectory.path() + QStringLiteral("/Folder.PNG")));
+
+        writeFile(musicDirectory.path() + QStringLiteral("/cover.jpg"), picture);
+
+        QCOMPARE(resolver.coverForTrack(trackUrl, QStringLiteral("album")),
+                 QUrl::fromLocalFile(musicDirectory.path() + QStringLiteral("/Folder.PNG")));
+
+        resolver.invalidateDirectory(musicDirectory.path());
+
+        QCOMPARE(resolver.coverForTrack(trackUrl, QStringLiteral("album")),
+                 QUrl::fromLocalFile(musicDirectory.path() + QStringLiteral("/cover.jpg")));
+    }
+
+    void embeddedId3v2Picture()
+    {
+        QTemporaryDir musicDirectory;
+        QTemporaryDir cacheDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+        QCOMPARE(cacheDirectory.isValid(), true);
+
+        const auto &picture = pngPicture(1024, 768);
+
+        const auto &trackFileName = musicDirectory.path() + QStringLiteral("/track.mp3");
+        writeFile(trackFileName, apicTag("image/png", picture) + QByteArray(128, '\xff'));
+
+        QCOMPARE(CoverResolver::embeddedPicture(trackFileName), picture);
+
+        CoverResolver resolver(cacheDirectory.path());
+
+        const auto &coverUrl = resolver.coverForTrack(QUrl::fromLocalFile(trackFileName), QStringLiteral("album"));
+
+        const auto &pictureHash = QString::fromLatin1(QCryptographicHash::hash(picture, QCryptographicHash::Sha1).toHex());
+        QCOMPARE(coverUrl, QUrl::fromLocalFile(cacheDirectory.path() + QStringLiteral("/") + pictureHash + QStringLiteral(".png")));
+
+        QImage cachedCover(coverUrl.toLocalFile());
+        QCOMPARE(cachedCover.width(), 512);
+        QCOMPARE(cachedCover.height(), 384);
+
+        QCOMPARE(CoverResolver(cacheDirectory.path()).coverForTrack(QUrl::fromLocalFile(trackFileName), QStringLiteral("album")), coverUrl);
+    }
+
+    void largeEmbeddedJpegPicture()
+    {
+        QTemporaryDir musicDirectory;
+        QTemporaryDir cacheDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+        QCOMPARE(cacheDirectory.isValid(), true);
+
+        const auto &picture = jpegPicture(1024, 768);
+
+        const auto &trackFileName = musicDirectory.path() + QStringLiteral("/track.mp3");
+        writeFile(trackFileName, apicTag("image/jpeg", picture) + QByteArray(128, '\xff'));
+
+        CoverResolver resolver(cacheDirectory.path());
+
+        const auto &coverUrl = resolver.coverForTrack(QUrl::fromLocalFile(trackFileName), QStringLiteral("album"));
+
+        const auto &pictureHash = QString::fromLatin1(QCryptographicHash::hash(picture, QCryptographicHash::Sha1).toHex());
+        QCOMPARE(coverUrl, QUrl::fromLocalFile(cacheDirectory.path() + QStringLiteral("/") + pictureHash + QStringLiteral(".jpg")));
+
+        QFile cachedCoverFile(coverUrl.toLocalFile());
+        QCOMPARE(cachedCoverFile.open(QIODevice::ReadOnly), true);
+        QCOMPARE(cachedCoverFile.peek(2), QByteArray("\xff\xd8"));
+
+        QImage cachedCover(coverUrl.toLocalFile());
+        QCOMPARE(cachedCover.width(), 512);
+        QCOMPARE(cachedCover.height(), 384);
+    }
+
+    void pruneUnusedCachedCovers()
+    {
+        QTemporaryDir musicDirectory;
+        QTemporaryDir cacheDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+        QCOMPARE(cacheDirectory.isValid(), true);
+
+        const auto &usedCoverFileName = cacheDirectory.path() + QStringLiteral("/used.png");
+        const auto &unusedCoverFileName = cacheDirectory.path() + QStringLiteral("/unused.png");
+
+        writeFile(usedCoverFileName, pngPicture(16, 16));
+        writeFile(unusedCoverFileName, pngPicture(16, 16));
+
+        QTest::qWait(1100);
+
+        CoverResolver resolver(cacheDirectory.path());
+
+        const auto &trackFileName = musicDirectory.path() + QStringLiteral("/track.mp3");
+        writeFile(trackFileName, apicTag("image/png", pngPicture(32, 32)) + QByteArray(128, '\xff'));
+
+        const auto &newCoverUrl = resolver.coverForTrack(QUrl::fromLocalFile(trackFileName), QStringLiteral("album"));
+        QCOMPARE(newCoverUrl.isEmpty(), false);
+
+        resolver.pruneCache({QUrl::fromLocalFile(usedCoverFileName)});
+
+        QCOMPARE(QFileInfo::exists(usedCoverFileName), true);
+        QCOMPARE(QFileInfo::exists(unusedCoverFileName), false);
+        QCOMPARE(QFileInfo::exists(newCoverUrl.toLocalFile()), true);
+    }
+
+    void embeddedFlacPicture()
+    {
+        QTemporaryDir musicDirectory;
+        QTemporaryDir cacheDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+        QCOMPARE(cacheDirectory.isValid(), true);
+
+        const auto &picture = pngPicture(32, 32);
+        const auto &pictureBlock = flacPictureBlock(picture);
+
+        auto pictureBlockHeader = QByteArray(1, '\x86');
+        pictureBlockHeader.append(bigEndian32(pictureBlock.size()).mid(1));
+
+        const auto &trackFileName = musicDirectory.path() + QStringLiteral("/track.flac");
+        writeFile(trackFileName, QByteArray("fLaC") + QByteArray(1, '\0') + QByteArray(2, '\0') + QByteArray(1, '\x22') +
+                  QByteArray(34, '\0') + pictureBlockHeader + pictureBlock);
+
+        QCOMPARE(CoverResolver::embeddedPicture(trackFileName), picture);
+
+        CoverResolver resolver(cacheDirectory.path());
+
+        const auto &coverUrl = resolver.coverForTrack(QUrl::fromLocalFile(trackFileName), QStringLiteral("album"));
+
+        QCOMPARE(QImage(coverUrl.toLocalFile()).size(), QSize(32, 32));
+    }
+
+    void embeddedVorbisPicture()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &picture = pngPicture(64, 64);
+        const auto &pictureComment = QByteArray("metadata_block_picture=") + flacPictureBlock(picture).toBase64();
+        const auto &titleComment = QByteArray("TITLE=track");
+
+        const auto &identificationPacket = QByteArray("\x01vorbis") + QByteArray(23, '\0');
+        const auto &commentPacket = QByteArray("\x03vorbis") + vorbisComments({titleComment, pictureComment}) + QByteArray(1, '\x01');
+
+        const auto &trackFileName = musicDirectory.path() + QStringLiteral("/track.ogg");
+        writeFile(trackFileName, oggPage(0, 0, identificationPacket) + oggPage(1, 0, commentPacket));
+
+        QCOMPARE(CoverResolver::embeddedPicture(trackFileName), picture);
+    }
+
+    void embeddedMp4Picture()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &picture = pngPicture(48, 48);
+
+        const auto &dataAtom = mp4Atom("data", bigEndian32(14) + bigEndian32(0) + picture);
+        const auto &metaAtom = mp4Atom("meta", bigEndian32(0) + mp4Atom("hdlr", QByteArray(25, '\0')) +
+                                       mp4Atom("ilst", mp4Atom("covr", dataAtom)));
+        const auto &moovAtom = mp4Atom("moov", mp4Atom("mvhd", QByteArray(100, '\0')) + mp4Atom("udta", metaAtom));
+
+        const auto &trackFileName = musicDirectory.path() + QStringLiteral("/track.m4a");
+        writeFile(trackFileName, mp4Atom("ftyp", QByteArray("M4A ") + bigEndian32(0)) + moovAtom + mp4Atom("mdat", QByteArray(64, '\0')));
+
+        QCOMPARE(CoverResolver::embeddedPicture(trackFileName), picture);
+    }
+
+    void noEmbeddedPicture()
+    {
+        const auto &trackFileName = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg");
+
+        QCOMPARE(CoverResolver::embeddedPicture(trackFileName).isEmpty(), true);
+    }
+};
+
+QTEST_GUILESS_MAIN(CoverResolverTest)
+
+
+#include "coverresolvertest.moc"
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "databaseinterface.h"
+#include "musicalbum.h"
+#include "musicaudiotrack.h"
+#include "musicartist.h"
+#include "allalbumsmodel.h"
+#include "albumfilterproxymodel.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QTime>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+
+#include <QDebug>
+
+#include <QtTest>
+
+#include <algorithm>
+
+class DatabaseInterfaceBenchmark: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    void librarySizes()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        auto maximumTracksCount = qEnvironmentVariableIsSet("ELISA_BENCHMARK_MAX_TRACKS") ?
+                    qgetenv("ELISA_BENCHMARK_MAX_TRACKS").toInt() : 10000;
+
+        for (auto tracksCount : {1000, 10000, 100000, 500000, 1000000}) {
+            if (tracksCount > maximumTracksCount) {
+                break;
+            }
+
+            QTest::newRow(QByteArray::number(tracksCount).constData()) << tracksCount;
+        }
+    }
+
+    void generateLibrary(int tracksCount, QList<MusicAudioTrack> &tracks, QHash<QString, QUrl> &covers) const
+    {
+        qsrand(tracksCount);
+
+        const auto artistsCount = std::max(1, tracksCount / 50);
+
+        tracks.reserve(tracksCount);
+
+        for (int albumIndex = 0; tracks.size() < tracksCount; ++albumIndex) {
+            const auto artistIndex = (qrand() % artistsCount) * (qrand() % artistsCount) / artistsCount;
+            const auto isCompilation = (qrand() % 10) == 0;
+            const auto &albumArtist = isCompilation ? QStringLiteral("Various Artists") : QStringLiteral("artist%1").arg(artistIndex);
+            const auto &albumName = QStringLiteral("album%1").arg(albumIndex);
+
+            auto albumTracksCount = 6 + qrand() % 15;
+            if ((qrand() % 20) == 0) {
+                albumTracksCount = 50 + qrand() % 150;
+            }
+            albumTracksCount = std::min(albumTracksCount, tracksCount - tracks.size());
+
+            const auto discsCount = ((qrand() % 8) == 0) ? 2 + qrand() % 2 : 1;
+
+            covers[albumName] = QUrl::fromLocalFile(QStringLiteral("/library/covers/%1.jpg").arg(albumIndex));
+
+            for (int trackIndex = 0; trackIndex < albumTracksCount; ++trackIndex) {
+                const auto &trackArtist = isCompilation ? QStringLiteral("artist%1").arg(qrand() % artistsCount) : albumArtist;
+                const auto &fileName = QStringLiteral("/library/%1/%2/%3.ogg").arg(albumArtist, albumName).arg(trackIndex);
+                const auto discNumber = 1 + trackIndex * discsCount / albumTracksCount;
+
+                tracks.push_back({true, fileName, QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                                  trackArtist, albumName, albumArtist, trackIndex + 1, discNumber,
+                                  QTime::fromMSecsSinceStartOfDay(120000 + qrand() % 300000),
+                                  {QUrl::fromLocalFile(fileName)}, covers[albumName], (qrand() % 6) * 2});
+            }
+        }
+    }
+
+    QString databaseName(int tracksCount) const
+    {
+        return QStringLiteral("%1%2").arg(QString::fromLatin1(QTest::currentTestFunction())).arg(tracksCount);
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+        qRegisterMetaType<QList<MusicAudioTrack>>("QList<MusicAudioTrack>");
+        qRegisterMetaType<MusicArtist>("MusicArtist");
+        qRegisterMetaType<QList<MusicAlbum>>("QList<MusicAlbum>");
+        qRegisterMetaType<QList<MusicArtist>>("QList<MusicArtist>");
+    }
+
+    void benchmarkInsertTracksList_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkInsertTracksList()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(databaseName(tracksCount));
+
+        QBENCHMARK_ONCE {
+            musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+        }
+
+        QCOMPARE(musicDb.allTracks().count(), tracksCount);
+    }
+
+    void benchmarkModifyTracksList_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkModifyTracksList()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(databaseName(tracksCount));
+        musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+
+        auto modifiedTracks = QList<MusicAudioTrack>();
+        for (int trackIndex = 0; trackIndex < newTracks.size(); trackIndex += 100) {
+            auto oneTrack = newTracks[trackIndex];
+            oneTrack.setRating((oneTrack.rating() + 2) % 12);
+            modifiedTracks.push_back(oneTrack);
+        }
+
+        QBENCHMARK_ONCE {
+            musicDb.modifyTracksList(modifiedTracks, newCovers);
+        }
+
+        QCOMPARE(musicDb.allTracks().count(), tracksCount);
+    }
+
+    void benchmarkRemoveTracksList_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkRemoveTracksList()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(databaseName(tracksCount));
+        musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+
+        auto removedFiles = QList<QUrl>();
+        for (int trackIndex = 0; trackIndex < newTracks.size(); trackIndex += 100) {
+            removedFiles.push_back(newTracks[trackIndex].resourceURI());
+        }
+
+        QBENCHMARK_ONCE {
+            musicDb.removeTracksList(removedFiles);
+        }
+
+        QCOMPARE(musicDb.allTracks().count(), tracksCount - removedFiles.size());
+    }
+
+    void benchmarkAllAlbums_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkAllAlbums()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(databaseName(tracksCount));
+        musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+
+        auto allAlbums = QList<MusicAlbum>();
+
+        QBENCHMARK {
+            allAlbums = musicDb.allAlbums();
+        }
+
+        QCOMPARE(allAlbums.count(), newCovers.count());
+    }
+
+    void benchmarkAllArtists_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkAllArtists()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(databaseName(tracksCount));
+        musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+
+        auto allArtists = QList<MusicArtist>();
+
+        QBENCHMARK {
+            allArtists = musicDb.allArtists();
+        }
+
+        QCOMPARE(allArtists.isEmpty(), false);
+    }
+
+    void benchmarkTracksFromAuthor_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkTracksFromAuthor()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(databaseName(tracksCount));
+        musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+
+        auto authorTracks = QList<MusicAudioTrack>();
+
+        QBENCHMARK {
+            authorTracks = musicDb.tracksFromAuthor(QStringLiteral("artist0"));
+        }
+
+        QCOMPARE(authorTracks.isEmpty(), false);
+    }
+
+    void benchmarkReloadExistingDatabase_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkReloadExistingDatabase()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        QTemporaryDir databaseDirectory;
+        QCOMPARE(databaseDirectory.isValid(), true);
+
+        const auto &databaseFileName = databaseDirectory.path() + QStringLiteral("/benchmark.db");
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(databaseName(tracksCount), databaseFileName);
+            musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+        }
+
+        DatabaseInterface reloadedDb;
+
+        QSignalSpy reloadedTracksSpy(&reloadedDb, &DatabaseInterface::tracksAdded);
+
+        QBENCHMARK_ONCE {
+            reloadedDb.init(databaseName(tracksCount) + QStringLiteral("Reload"), databaseFileName);
+        }
+
+        QCOMPARE(reloadedTracksSpy.count(), 1);
+        QCOMPARE(reloadedTracksSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), tracksCount);
+    }
+
+    void benchmarkSearchAndFilterAlbums_data()
+    {
+        librarySizes();
+    }
+
+    void benchmarkSearchAndFilterAlbums()
+    {
+        QFETCH(int, tracksCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+        generateLibrary(tracksCount, newTracks, newCovers);
+
+        DatabaseInterface musicDb;
+        AllAlbumsModel albumsModel;
+        AlbumFilterProxyModel proxyModel;
+
+        proxyModel.setSourceModel(&albumsModel);
+
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &albumsModel, &AllAlbumsModel::albumsAdded);
+        connect(&musicDb, &DatabaseInterface::searchResultsReady,
+                &proxyModel, &AlbumFilterProxyModel::setSearchResults);
+
+        musicDb.init(databaseName(tracksCount));
+        musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("benchmark"));
+
+        QCOMPARE(albumsModel.rowCount(), newCovers.count());
+
+        proxyModel.setFilterText(QStringLiteral("artist1"));
+        musicDb.searchItems(proxyModel.filterText());
+
+        proxyModel.setFilterText(QStringLiteral("album1"));
+
+        QElapsedTimer searchTimer;
+        searchTimer.start();
+
+        QBENCHMARK_ONCE {
+            musicDb.searchItems(proxyModel.filterText());
+        }
+
+        const auto elapsedTime = searchTimer.elapsed();
+
+        qInfo() << "DatabaseInterfaceBenchmark::benchmarkSearchAndFilterAlbums" << tracksCount << "tracks" << albumsModel.rowCount()
+                << "albums searched and filtered in" << elapsedTime << "ms";
+
+        QVERIFY(proxyModel.rowCount() > 0);
+        QVERIFY(proxyModel.rowCount() < albumsModel.rowCount());
+        QVERIFY2(elapsedTime < 10, "search and filter should stay under 10 ms");
+    }
+};
+
+QTEST_MAIN(DatabaseInterfaceBenchmark)
+
+
+#include "databaseinterfacebenchmark.moc"
@@ -20,6 +20,7 @@
 #include "databaseinterface.h"
 #include "musicalbum.h"
 #include "musicaudiotrack.h"
+#include "allartistsmodel.h"
 
 #include <QObject>
 #include <QUrl>
@@ -32,11 +33,16 @@
 #include <QDir>
 #include <QFile>
 #include <QTemporaryFile>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
 
 #include <QDebug>
 
 #include <QtTest>
 
+#include <algorithm>
+
 class DatabaseMetadataFetcher : public QObject
 {
     Q_OBJECT
@@ -159,6 +165,9 @@ private Q_SLOTS:
         qRegisterMetaType<QVector<qlonglong>>("QVector<qlonglong>");
         qRegisterMetaType<QHash<qlonglong,int>>("QHash<qlonglong,int>");
         qRegisterMetaType<MusicArtist>("MusicArtist");
+        qRegisterMetaType<QList<MusicAlbum>>("QList<MusicAlbum>");
+        qRegisterMetaType<QList<MusicArtist>>("QList<MusicArtist>");
+        qRegisterMetaType<QList<qulonglong>>("QList<qulonglong>");
     }
 
     void avoidCrashInTrackIdFromTitleAlbumArtist()
@@ -1269,7 +1278,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto allAlbums = musicDb.allAlbums();
@@ -1302,7 +1311,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 1);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 15);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 5);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto removedTrackId = musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track1"), QStringLiteral("album1"), QStringLiteral("artist1"));
@@ -1371,7 +1380,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto allAlbums = musicDb.allAlbums();
@@ -1408,8 +1417,8 @@ private Q_SLOTS:
         QCOMPARE(musicDbArtistRemovedSpy.count(), 2);
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 1);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 4);
-        QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 18);
+        QCOMPARE(musicDbArtistModifiedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto removedAlbum = musicDb.albumFromTitle(QStringLiteral("album1"));
@@ -1479,7 +1488,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto allAlbums = musicDb.allAlbums();
@@ -1511,7 +1520,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 1);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 15);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 5);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
     }
     void addOneTrack()
@@ -1576,7 +1585,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track6"),
@@ -1598,7 +1607,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 15);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 5);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
     }
 
@@ -1665,7 +1674,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto modifiedTrack = MusicAudioTrack{true, QStringLiteral("$3"), QStringLiteral("0"), QStringLiteral("track3"),
@@ -1683,7 +1692,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 15);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 5);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 2);
 
         auto trackId = musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track3"), QStringLiteral("album1"), QStringLiteral("artist3"));
@@ -1756,7 +1765,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track1"),
@@ -1781,8 +1790,8 @@ private Q_SLOTS:
         QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
-        QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 15);
+        QCOMPARE(musicDbArtistModifiedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 5);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
     }
 
@@ -1848,7 +1857,7 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 14);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 4);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
 
         auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track6"),
@@ -1875,9 +1884,636 @@ private Q_SLOTS:
         QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
         QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
         QCOMPARE(musicDbArtistModifiedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 15);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 5);
         QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
     }
+
+    void readOnlyConnection()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbWriter"), myTempDatabase.fileName());
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        DatabaseInterface readOnlyDb;
+
+        QCOMPARE(readOnlyDb.isInitialized(), false);
+
+        QSignalSpy readOnlyDbInitDoneSpy(&readOnlyDb, &DatabaseInterface::requestsInitDone);
+
+        readOnlyDb.initReadOnly(QStringLiteral("testDbReader"), myTempDatabase.fileName());
+
+        QCOMPARE(readOnlyDbInitDoneSpy.count(), 1);
+        QCOMPARE(readOnlyDb.isInitialized(), true);
+        QCOMPARE(readOnlyDb.allAlbums().count(), musicDb.allAlbums().count());
+        QCOMPARE(readOnlyDb.allArtists().count(), musicDb.allArtists().count());
+
+        auto trackId = readOnlyDb.trackIdFromTitleAlbumArtist(QStringLiteral("track1"), QStringLiteral("album1"), QStringLiteral("artist1"));
+
+        QCOMPARE(trackId, musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track1"), QStringLiteral("album1"), QStringLiteral("artist1")));
+        QCOMPARE(readOnlyDb.trackFromDatabaseId(trackId).title(), QStringLiteral("track1"));
+
+        auto newTrack = MusicAudioTrack{true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track1"),
+                QStringLiteral("artist2"), QStringLiteral("album5"), QStringLiteral("artist2"), 1, 1, QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/$19"))},
+        {QUrl::fromLocalFile(QStringLiteral("album5"))}, 5};
+
+        musicDb.insertTracksList({newTrack}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(readOnlyDb.allAlbums().count(), musicDb.allAlbums().count());
+    }
+
+    void batchedChangeNotifications()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbBatchedNotifications"));
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistAdded);
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::trackAdded);
+        QSignalSpy musicDbArtistsAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumsAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTracksAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbTracksRemovedSpy(&musicDb, &DatabaseInterface::tracksRemoved);
+        QSignalSpy musicDbAlbumsRemovedSpy(&musicDb, &DatabaseInterface::albumsRemoved);
+        QSignalSpy musicDbArtistsRemovedSpy(&musicDb, &DatabaseInterface::artistsRemoved);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDbArtistsAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumsAddedSpy.count(), 1);
+        QCOMPARE(musicDbTracksAddedSpy.count(), 1);
+        QCOMPARE(musicDbTracksRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumsRemovedSpy.count(), 0);
+        QCOMPARE(musicDbArtistsRemovedSpy.count(), 0);
+
+        QCOMPARE(musicDbArtistsAddedSpy.at(0).at(0).value<QList<MusicArtist>>().count(), musicDbArtistAddedSpy.count());
+        QCOMPARE(musicDbAlbumsAddedSpy.at(0).at(0).value<QList<MusicAlbum>>().count(), musicDbAlbumAddedSpy.count());
+        QCOMPARE(musicDbTracksAddedSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), musicDbTrackAddedSpy.count());
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDbArtistsAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumsAddedSpy.count(), 1);
+        QCOMPARE(musicDbTracksAddedSpy.count(), 1);
+
+        auto removedFiles = QList<QUrl>();
+        for (const auto &oneTrack : mNewTracks) {
+            removedFiles.push_back(oneTrack.resourceURI());
+        }
+
+        musicDb.removeTracksList(removedFiles);
+
+        QCOMPARE(musicDb.allAlbums().count(), 0);
+        QCOMPARE(musicDbTracksRemovedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumsRemovedSpy.count(), 1);
+        QCOMPARE(musicDbArtistsRemovedSpy.count(), 1);
+
+        QCOMPARE(musicDbTracksRemovedSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), musicDbTrackAddedSpy.count());
+        QCOMPARE(musicDbAlbumsRemovedSpy.at(0).at(0).value<QList<MusicAlbum>>().count(), musicDbAlbumAddedSpy.count());
+    }
+
+    void updateAlbumOncePerTransaction()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbAlbumOncePerTransaction"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+
+        auto firstTrackId = musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track1"), QStringLiteral("album1"), QStringLiteral("artist1"));
+        auto firstTrack = musicDb.trackFromDatabaseId(firstTrackId);
+        auto secondTrackId = musicDb.trackIdFromTitleAlbumArtist(QStringLiteral("track2"), QStringLiteral("album1"), QStringLiteral("artist2"));
+        auto secondTrack = musicDb.trackFromDatabaseId(secondTrackId);
+
+        musicDb.removeTracksList({firstTrack.resourceURI(), secondTrack.resourceURI()});
+
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 1);
+
+        auto modifiedAlbum = musicDbAlbumModifiedSpy.at(0).at(0).value<MusicAlbum>();
+
+        QCOMPARE(modifiedAlbum.title(), QStringLiteral("album1"));
+        QCOMPARE(modifiedAlbum.tracksCount(), 2);
+
+        auto album = musicDb.albumFromTitle(QStringLiteral("album1"));
+
+        QCOMPARE(album.tracksCount(), 2);
+    }
+
+    void restoredTracksWithFileStat()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbRestoredTracksWithFileStat"));
+
+        QSignalSpy restoredTracksSpy(&musicDb, &DatabaseInterface::restoredTracks);
+
+        auto newTracks = mNewTracks;
+        newTracks[0].setFileSize(1000);
+        newTracks[0].setFileModificationTime(QDateTime::fromMSecsSinceEpoch(1500000000000));
+        newTracks[0].setFileInode(42);
+
+        musicDb.insertTracksList(newTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        musicDb.askRestoredTracks(QStringLiteral("autoTest"));
+
+        QCOMPARE(restoredTracksSpy.count(), 1);
+        QCOMPARE(restoredTracksSpy.at(0).at(0).toString(), QStringLiteral("autoTest"));
+
+        auto restoredFiles = restoredTracksSpy.at(0).at(1).value<QList<MusicAudioTrack>>();
+        auto itFirstFile = std::find_if(restoredFiles.begin(), restoredFiles.end(),
+                                        [](const MusicAudioTrack &oneFile) {return oneFile.resourceURI() == QUrl::fromLocalFile(QStringLiteral("/$1"));});
+        auto itSecondFile = std::find_if(restoredFiles.begin(), restoredFiles.end(),
+                                         [](const MusicAudioTrack &oneFile) {return oneFile.resourceURI() == QUrl::fromLocalFile(QStringLiteral("/$2"));});
+
+        QCOMPARE(itFirstFile != restoredFiles.end(), true);
+        QCOMPARE(itFirstFile->fileSize(), qint64(1000));
+        QCOMPARE(itFirstFile->fileModificationTime(), QDateTime::fromMSecsSinceEpoch(1500000000000));
+        QCOMPARE(itFirstFile->fileInode(), qulonglong(42));
+        QCOMPARE(itSecondFile != restoredFiles.end(), true);
+        QCOMPARE(itSecondFile->fileModificationTime().isValid(), false);
+
+        auto modifiedTrack = newTracks[0];
+        modifiedTrack.setFileSize(2000);
+        modifiedTrack.setFileModificationTime(QDateTime::fromMSecsSinceEpoch(1600000000000));
+
+        musicDb.modifyTracksList({modifiedTrack}, mNewCovers);
+
+        musicDb.askRestoredTracks(QStringLiteral("autoTest"));
+        musicDb.askRestoredTracks(QStringLiteral("otherSource"));
+
+        QCOMPARE(restoredTracksSpy.count(), 3);
+
+        restoredFiles = restoredTracksSpy.at(1).at(1).value<QList<MusicAudioTrack>>();
+        itFirstFile = std::find_if(restoredFiles.begin(), restoredFiles.end(),
+                                   [](const MusicAudioTrack &oneFile) {return oneFile.resourceURI() == QUrl::fromLocalFile(QStringLiteral("/$1"));});
+
+        QCOMPARE(itFirstFile != restoredFiles.end(), true);
+        QCOMPARE(itFirstFile->fileSize(), qint64(2000));
+        QCOMPARE(itFirstFile->fileModificationTime(), QDateTime::fromMSecsSinceEpoch(1600000000000));
+
+        QCOMPARE(restoredTracksSpy.at(2).at(1).value<QList<MusicAudioTrack>>().isEmpty(), true);
+    }
+
+    void sweepUnseenTracksAfterSourceScan()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbSweepUnseenTracksAfterSourceScan"));
+
+        QSignalSpy trackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy restoredTracksSpy(&musicDb, &DatabaseInterface::restoredTracks);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        const auto initialTracksCount = musicDb.allTracks().count();
+
+        auto seenTracks = QList<QUrl>();
+        for (const auto &oneTrack : mNewTracks) {
+            if (oneTrack.resourceURI() != QUrl::fromLocalFile(QStringLiteral("/$1"))) {
+                seenTracks.push_back(oneTrack.resourceURI());
+            }
+        }
+
+        const auto seenDirectories = QHash<QUrl, QDateTime>({{QUrl::fromLocalFile(QStringLiteral("/")), QDateTime::fromMSecsSinceEpoch(1600000000000)}});
+
+        auto newTrack = mNewTracks[0];
+        newTrack.setTitle(QStringLiteral("track1Bis"));
+        newTrack.setResourceURI(QUrl::fromLocalFile(QStringLiteral("/$1Bis")));
+
+        musicDb.beginSourceScan(QStringLiteral("autoTest"));
+        musicDb.markSeenTracksList(seenTracks, seenDirectories, QStringLiteral("autoTest"));
+        musicDb.insertTracksList({newTrack}, mNewCovers, QStringLiteral("autoTest"));
+        musicDb.finishSourceScan(QStringLiteral("otherSource"));
+
+        QCOMPARE(trackRemovedSpy.count(), 0);
+
+        musicDb.finishSourceScan(QStringLiteral("autoTest"));
+
+        QCOMPARE(trackRemovedSpy.count(), 1);
+        QCOMPARE(trackRemovedSpy.at(0).at(0).value<MusicAudioTrack>().resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$1")));
+        QCOMPARE(musicDb.allTracks().count(), initialTracksCount);
+
+        musicDb.askRestoredTracks(QStringLiteral("autoTest"));
+
+        QCOMPARE(restoredTracksSpy.count(), 1);
+
+        auto restoredFiles = restoredTracksSpy.at(0).at(1).value<QList<MusicAudioTrack>>();
+
+        QCOMPARE(std::any_of(restoredFiles.begin(), restoredFiles.end(),
+                             [](const MusicAudioTrack &oneFile) {return oneFile.resourceURI() == QUrl::fromLocalFile(QStringLiteral("/$1"));}), false);
+        QCOMPARE(std::any_of(restoredFiles.begin(), restoredFiles.end(),
+                             [](const MusicAudioTrack &oneFile) {return oneFile.resourceURI() == QUrl::fromLocalFile(QStringLiteral("/$1Bis"));}), true);
+
+        musicDb.beginSourceScan(QStringLiteral("autoTest"));
+        musicDb.markSeenTracksList(seenTracks + QList<QUrl>({newTrack.resourceURI()}), seenDirectories, QStringLiteral("autoTest"));
+        musicDb.finishSourceScan(QStringLiteral("autoTest"));
+
+        QCOMPARE(trackRemovedSpy.count(), 1);
+        QCOMPARE(musicDb.allTracks().count(), initialTracksCount);
+    }
+
+    void unchangedRescanDoesNotWriteDatabase()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbUnchangedRescan"), myTempDatabase.fileName());
+
+        QSignalSpy trackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        auto seenTracks = QList<QUrl>();
+        for (const auto &oneTrack : mNewTracks) {
+            seenTracks.push_back(oneTrack.resourceURI());
+        }
+
+        auto seenDirectories = QHash<QUrl, QDateTime>({{QUrl::fromLocalFile(QStringLiteral("/")), QDateTime::fromMSecsSinceEpoch(1600000000000)}});
+
+        musicDb.beginSourceScan(QStringLiteral("autoTest"));
+        musicDb.markSeenTracksList(seenTracks, seenDirectories, QStringLiteral("autoTest"));
+        musicDb.finishSourceScan(QStringLiteral("autoTest"));
+
+        QCOMPARE(trackRemovedSpy.count(), 0);
+
+        {
+            auto writesCounterDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("testDbUnchangedRescanCounter"));
+            writesCounterDatabase.setDatabaseName(myTempDatabase.fileName());
+
+            QCOMPARE(writesCounterDatabase.open(), true);
+
+            const auto &allTables = writesCounterDatabase.tables();
+
+            QSqlQuery createCounterQuery(writesCounterDatabase);
+
+            QCOMPARE(createCounterQuery.exec(QStringLiteral("CREATE TABLE `DatabaseWrites` (`Count` INTEGER NOT NULL)")), true);
+            QCOMPARE(createCounterQuery.exec(QStringLiteral("INSERT INTO `DatabaseWrites` (`Count`) VALUES (0)")), true);
+
+            for (const auto &oneTable : allTables) {
+                for (const auto &oneOperation : {QStringLiteral("INSERT"), QStringLiteral("UPDATE"), QStringLiteral("DELETE")}) {
+                    QCOMPARE(createCounterQuery.exec(QStringLiteral("CREATE TRIGGER `%1%2Counter` AFTER %2 ON `%1` "
+                                                                    "BEGIN UPDATE `DatabaseWrites` SET `Count` = `Count` + 1; END").arg(oneTable, oneOperation)), true);
+                }
+            }
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("testDbUnchangedRescanCounter"));
+
+        musicDb.beginSourceScan(QStringLiteral("autoTest"));
+        musicDb.markSeenTracksList(seenTracks, seenDirectories, QStringLiteral("autoTest"));
+        musicDb.finishSourceScan(QStringLiteral("autoTest"));
+
+        QCOMPARE(trackRemovedSpy.count(), 0);
+
+        {
+            auto writesCounterDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("testDbUnchangedRescanCounter"));
+            writesCounterDatabase.setDatabaseName(myTempDatabase.fileName());
+
+            QCOMPARE(writesCounterDatabase.open(), true);
+
+            QSqlQuery selectCounterQuery(writesCounterDatabase);
+
+            QCOMPARE(selectCounterQuery.exec(QStringLiteral("SELECT `Count` FROM `DatabaseWrites`")), true);
+            QCOMPARE(selectCounterQuery.next(), true);
+            QCOMPARE(selectCounterQuery.value(0).toInt(), 0);
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("testDbUnchangedRescanCounter"));
+
+        seenDirectories[QUrl::fromLocalFile(QStringLiteral("/"))] = QDateTime::fromMSecsSinceEpoch(1600000001000);
+
+        musicDb.beginSourceScan(QStringLiteral("autoTest"));
+        musicDb.markSeenTracksList(seenTracks.mid(1), seenDirectories, QStringLiteral("autoTest"));
+        musicDb.finishSourceScan(QStringLiteral("autoTest"));
+
+        QCOMPARE(trackRemovedSpy.count(), 1);
+        QCOMPARE(trackRemovedSpy.at(0).at(0).value<MusicAudioTrack>().resourceURI(), seenTracks.first());
+
+        musicDb.beginSourceScan(QStringLiteral("autoTest"));
+        musicDb.markSeenTracksList({}, {}, QStringLiteral("autoTest"));
+        musicDb.finishSourceScan(QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDb.allTracks().isEmpty(), true);
+    }
+
+    void upgradeTracksMappingFromFileNames_data()
+    {
+        QTest::addColumn<QString>("oldTableName");
+
+        QTest::newRow("old schema") << QStringLiteral("TracksMapping");
+        QTest::newRow("interrupted upgrade") << QStringLiteral("TracksMappingWithFileName");
+    }
+
+    void upgradeTracksMappingFromFileNames()
+    {
+        QFETCH(QString, oldTableName);
+
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        auto ratings = QHash<QUrl, int>();
+        auto fileSizes = QHash<QUrl, qint64>();
+        auto fileModificationTimes = QHash<QUrl, QDateTime>();
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDbUpgradeWriter"), myTempDatabase.fileName());
+
+            auto newTracks = mNewTracks;
+            for (int trackIndex = 0; trackIndex < newTracks.size(); ++trackIndex) {
+                newTracks[trackIndex].setFileSize(1000 + trackIndex);
+                newTracks[trackIndex].setFileModificationTime(QDateTime::fromMSecsSinceEpoch(1500000000000 + trackIndex * 1000));
+                newTracks[trackIndex].setFileInode(100 + trackIndex);
+            }
+
+            musicDb.insertTracksList(newTracks, mNewCovers, QStringLiteral("autoTest"));
+
+            for (const auto &oneTrack : musicDb.allTracks()) {
+                ratings[oneTrack.resourceURI()] = oneTrack.rating();
+            }
+            for (const auto &oneTrack : newTracks) {
+                fileSizes[oneTrack.resourceURI()] = oneTrack.fileSize();
+                fileModificationTimes[oneTrack.resourceURI()] = oneTrack.fileModificationTime();
+            }
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("testDbUpgradeWriter"));
+
+        {
+            auto oldSchemaDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("testDbUpgradeOldSchema"));
+            oldSchemaDatabase.setDatabaseName(myTempDatabase.fileName());
+
+            QCOMPARE(oldSchemaDatabase.open(), true);
+
+            QSqlQuery oldSchemaQuery(oldSchemaDatabase);
+
+            QCOMPARE(oldSchemaQuery.exec(QStringLiteral("CREATE TABLE `OldTracksMapping` ("
+                                                        "`TrackID` INTEGER NULL, "
+                                                        "`DiscoverID` INTEGER NOT NULL, "
+                                                        "`FileName` VARCHAR(255) NOT NULL, "
+                                                        "`Priority` INTEGER NOT NULL, "
+                                                        "`TrackValid` BOOLEAN NOT NULL, "
+                                                        "`FileSize` INTEGER NULL, "
+                                                        "`FileModifiedTime` INTEGER NULL, "
+                                                        "`FileInode` INTEGER NULL, "
+                                                        "`ScanGeneration` INTEGER NOT NULL DEFAULT 0, "
+                                                        "PRIMARY KEY (`FileName`))")), true);
+            QCOMPARE(oldSchemaQuery.exec(QStringLiteral("INSERT INTO `OldTracksMapping` "
+                                                        "SELECT tracksMapping.`TrackID`, tracksMapping.`DiscoverID`, directory.`Path` || tracksMapping.`FileName`, "
+                                                        "tracksMapping.`Priority`, tracksMapping.`TrackValid`, tracksMapping.`FileSize`, "
+                                                        "tracksMapping.`FileModifiedTime`, tracksMapping.`FileInode`, tracksMapping.`ScanGeneration` "
+                                                        "FROM `TracksMapping` tracksMapping, `Directories` directory "
+                                                        "WHERE tracksMapping.`DirectoryID` = directory.`ID`")), true);
+            QCOMPARE(oldSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksMapping`")), true);
+            QCOMPARE(oldSchemaQuery.exec(QStringLiteral("DROP TABLE `ScannedDirectories`")), true);
+            QCOMPARE(oldSchemaQuery.exec(QStringLiteral("DROP TABLE `Directories`")), true);
+            QCOMPARE(oldSchemaQuery.exec(QStringLiteral("ALTER TABLE `OldTracksMapping` RENAME TO `%1`").arg(oldTableName)), true);
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("testDbUpgradeOldSchema"));
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy restoredTracksSpy(&musicDb, &DatabaseInterface::restoredTracks);
+
+        musicDb.init(QStringLiteral("testDbUpgradeReader"), myTempDatabase.fileName());
+
+        const auto &allTracks = musicDb.allTracks();
+
+        QCOMPARE(allTracks.count(), ratings.count());
+
+        for (const auto &oneTrack : allTracks) {
+            QCOMPARE(ratings.contains(oneTrack.resourceURI()), true);
+            QCOMPARE(oneTrack.rating(), ratings.value(oneTrack.resourceURI()));
+        }
+
+        musicDb.askRestoredTracks(QStringLiteral("autoTest"));
+
+        QCOMPARE(restoredTracksSpy.count(), 1);
+
+        const auto &restoredFiles = restoredTracksSpy.at(0).at(1).value<QList<MusicAudioTrack>>();
+
+        QCOMPARE(restoredFiles.count(), allTracks.count());
+
+        for (const auto &oneFile : restoredFiles) {
+            QCOMPARE(fileSizes.contains(oneFile.resourceURI()), true);
+            QCOMPARE(oneFile.fileSize(), fileSizes.value(oneFile.resourceURI()));
+            QCOMPARE(oneFile.fileModificationTime(), fileModificationTimes.value(oneFile.resourceURI()));
+        }
+
+        auto newTrack = mNewTracks[0];
+        newTrack.setTitle(QStringLiteral("track1Bis"));
+        newTrack.setResourceURI(QUrl::fromLocalFile(QStringLiteral("/$1Bis")));
+
+        musicDb.insertTracksList({newTrack}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDb.allTracks().count(), ratings.count() + 1);
+    }
+
+    void removeDirectoryTree()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbRemoveDirectoryTree"));
+
+        QSignalSpy trackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        const auto &trackFiles = QStringList({QStringLiteral("/music/album/1.ogg"), QStringLiteral("/music/album/cd2/2.ogg"),
+                                              QStringLiteral("/music/album/cd2/bonus/3.ogg"), QStringLiteral("/music/album2/4.ogg"),
+                                              QStringLiteral("/music/album-live/5.ogg")});
+
+        for (int trackIndex = 0; trackIndex < trackFiles.size(); ++trackIndex) {
+            newTracks.push_back({true, QStringLiteral("$%1").arg(trackIndex + 100), QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                                 QStringLiteral("artist1"), QStringLiteral("album%1").arg(trackIndex), QStringLiteral("artist1"), 1, 1,
+                                 QTime::fromMSecsSinceStartOfDay(1000), {QUrl::fromLocalFile(trackFiles[trackIndex])},
+                                 {QUrl::fromLocalFile(QStringLiteral("album%1").arg(trackIndex))}, 0});
+        }
+
+        musicDb.insertTracksList(newTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDb.allTracks().count(), 5);
+
+        musicDb.removeDirectoryTree(QUrl::fromLocalFile(QStringLiteral("/music/album")));
+
+        QCOMPARE(trackRemovedSpy.count(), 3);
+        QCOMPARE(musicDb.allTracks().count(), 2);
+
+        auto remainingFiles = QList<QUrl>();
+        for (const auto &oneTrack : musicDb.allTracks()) {
+            remainingFiles.push_back(oneTrack.resourceURI());
+        }
+
+        QCOMPARE(remainingFiles.contains(QUrl::fromLocalFile(QStringLiteral("/music/album2/4.ogg"))), true);
+        QCOMPARE(remainingFiles.contains(QUrl::fromLocalFile(QStringLiteral("/music/album-live/5.ogg"))), true);
+
+        musicDb.insertTracksList({newTracks[1]}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDb.allTracks().count(), 3);
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/music/album-live/5.ogg")), QUrl::fromLocalFile(QStringLiteral("/music/album/cd2/2.ogg")),
+                                  QUrl::fromLocalFile(QStringLiteral("/music/album/cd2")), QUrl::fromLocalFile(QStringLiteral("/music/album"))});
+
+        QCOMPARE(trackRemovedSpy.count(), 5);
+        QCOMPARE(musicDb.allTracks().count(), 1);
+        QCOMPARE(musicDb.allTracks().first().resourceURI(), QUrl::fromLocalFile(QStringLiteral("/music/album2/4.ogg")));
+    }
+
+    void searchItems()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDbSearchItems"));
+
+        QSignalSpy searchResultsSpy(&musicDb, &DatabaseInterface::searchResultsReady);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        musicDb.searchItems(QStringLiteral("Artist2"));
+
+        QCOMPARE(searchResultsSpy.count(), 1);
+        QCOMPARE(searchResultsSpy.at(0).at(0).toString(), QStringLiteral("Artist2"));
+        QCOMPARE(searchResultsSpy.at(0).at(1).value<QList<qulonglong>>().count(), 3);
+        QCOMPARE(searchResultsSpy.at(0).at(2).value<QList<qulonglong>>().count(), 2);
+        QCOMPARE(searchResultsSpy.at(0).at(3).value<QList<qulonglong>>().count(), 5);
+
+        musicDb.searchItems(QStringLiteral("alb"));
+
+        QCOMPARE(searchResultsSpy.count(), 2);
+        QCOMPARE(searchResultsSpy.at(1).at(1).value<QList<qulonglong>>().count(), 3);
+        QCOMPARE(searchResultsSpy.at(1).at(2).value<QList<qulonglong>>().count(), 0);
+        QCOMPARE(searchResultsSpy.at(1).at(3).value<QList<qulonglong>>().count(), 13);
+
+        musicDb.searchItems(QStringLiteral("album3"));
+
+        QCOMPARE(searchResultsSpy.count(), 3);
+        QCOMPARE(searchResultsSpy.at(2).at(1).value<QList<qulonglong>>().count(), 1);
+        QCOMPARE(searchResultsSpy.at(2).at(1).value<QList<qulonglong>>().first(), musicDb.albumFromTitle(QStringLiteral("album3")).databaseId());
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$11")), QUrl::fromLocalFile(QStringLiteral("/$12")), QUrl::fromLocalFile(QStringLiteral("/$13"))});
+
+        musicDb.searchItems(QStringLiteral("album3"));
+
+        QCOMPARE(searchResultsSpy.count(), 4);
+        QCOMPARE(searchResultsSpy.at(3).at(1).value<QList<qulonglong>>().count(), 0);
+        QCOMPARE(searchResultsSpy.at(3).at(3).value<QList<qulonglong>>().count(), 0);
+
+        musicDb.searchItems(QStringLiteral(" "));
+
+        QCOMPARE(searchResultsSpy.count(), 5);
+        QCOMPARE(searchResultsSpy.at(4).at(1).value<QList<qulonglong>>().count(), 0);
+    }
+
+    void benchmarkInsertTracksList()
+    {
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+
+        for (int albumIndex = 0; albumIndex < 200; ++albumIndex) {
+            const auto &albumName = QStringLiteral("album%1").arg(albumIndex);
+            const auto &albumArtist = QStringLiteral("artist%1").arg(albumIndex % 50);
+
+            newCovers[albumName] = QUrl::fromLocalFile(albumName);
+
+            for (int trackIndex = 1; trackIndex <= 25; ++trackIndex) {
+                const auto &fileName = QStringLiteral("/benchmark/%1/%2").arg(albumIndex).arg(trackIndex);
+
+                newTracks.push_back({true, fileName, QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                                     albumArtist, albumName, albumArtist, trackIndex, 1, QTime::fromMSecsSinceStartOfDay(trackIndex * 1000),
+                                     {QUrl::fromLocalFile(fileName)}, {QUrl::fromLocalFile(albumName)}, trackIndex % 6});
+            }
+        }
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("benchmarkDb"));
+
+        QElapsedTimer insertTimer;
+        insertTimer.start();
+
+        QBENCHMARK_ONCE {
+            musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("autoTest"));
+        }
+
+        auto elapsedTime = std::max(insertTimer.elapsed(), qint64(1));
+        qInfo() << "DatabaseInterfaceTests::benchmarkInsertTracksList" << newTracks.size() << "tracks inserted at"
+                << newTracks.size() * 1000 / elapsedTime << "tracks per second";
+
+        QCOMPARE(musicDb.allTracks().count(), newTracks.size());
+        QCOMPARE(musicDb.allAlbums().count(), 200);
+    }
+
+    void benchmarkAllArtists_data()
+    {
+        QTest::addColumn<int>("artistsCount");
+
+        QTest::newRow("100 artists") << 100;
+        QTest::newRow("1000 artists") << 1000;
+        QTest::newRow("10000 artists") << 10000;
+    }
+
+    void benchmarkAllArtists()
+    {
+        QFETCH(int, artistsCount);
+
+        auto newTracks = QList<MusicAudioTrack>();
+        auto newCovers = QHash<QString, QUrl>();
+
+        for (int artistIndex = 0; artistIndex < artistsCount; ++artistIndex) {
+            const auto &artistName = QStringLiteral("artist%1").arg(artistIndex);
+            const auto &albumName = QStringLiteral("album%1").arg(artistIndex);
+            const auto &fileName = QStringLiteral("/benchmark/%1").arg(artistIndex);
+
+            newTracks.push_back({true, fileName, QStringLiteral("0"), QStringLiteral("track1"),
+                                 artistName, albumName, artistName, 1, 1, QTime::fromMSecsSinceStartOfDay(1000),
+                                 {QUrl::fromLocalFile(fileName)}, {QUrl::fromLocalFile(albumName)}, 0});
+        }
+
+        QTemporaryFile myDatabaseFile;
+        myDatabaseFile.open();
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("benchmarkArtistsDb%1").arg(artistsCount), myDatabaseFile.fileName());
+
+            musicDb.insertTracksList(newTracks, newCovers, QStringLiteral("autoTest"));
+        }
+
+        DatabaseInterface reloadedDb;
+        AllArtistsModel artistsModel;
+
+        connect(&reloadedDb, &DatabaseInterface::artistsAdded,
+                &artistsModel, &AllArtistsModel::artistsAdded);
+
+        QElapsedTimer startupTimer;
+        auto firstPopulationTime = qint64(-1);
+
+        connect(&artistsModel, &AllArtistsModel::rowsInserted, [&startupTimer, &firstPopulationTime]() {
+            if (firstPopulationTime < 0) {
+                firstPopulationTime = startupTimer.elapsed();
+            }
+        });
+
+        startupTimer.start();
+
+        reloadedDb.init(QStringLiteral("benchmarkArtistsReloadDb%1").arg(artistsCount), myDatabaseFile.fileName());
+
+        QVERIFY(firstPopulationTime >= 0);
+
+        QTest::setBenchmarkResult(firstPopulationTime, QTest::WalltimeMilliseconds);
+
+        QCOMPARE(artistsModel.rowCount(), artistsCount);
+        QCOMPARE(artistsModel.data(artistsModel.index(0, 0), AllArtistsModel::ArtistsCountRole).toInt(), 1);
+    }
 };
 
 QTEST_MAIN(DatabaseInterfaceTests)
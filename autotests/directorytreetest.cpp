@@ -0,0 +1,132 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "abstractfile/directorytree.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QSet>
+#include <QString>
+
+#include <QDebug>
+
+#include <QtTest/QtTest>
+
+class DirectoryTreeTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryTreeTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void addAndRemoveEntries()
+    {
+        DirectoryTree myTree;
+
+        const auto &musicDirectory = QUrl::fromLocalFile(QStringLiteral("/home/user/Music"));
+        const auto &albumDirectory = QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album"));
+        const auto &firstTrack = QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album/track1.ogg"));
+        const auto &secondTrack = QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album/track2.ogg"));
+
+        QCOMPARE(myTree.containsDirectory(musicDirectory), false);
+
+        myTree.addDirectory(musicDirectory);
+        myTree.addEntry(musicDirectory, albumDirectory);
+        myTree.addEntry(albumDirectory, firstTrack);
+        myTree.addEntry(albumDirectory, secondTrack);
+
+        QCOMPARE(myTree.directoriesCount(), 2);
+        QCOMPARE(myTree.containsDirectory(musicDirectory), true);
+        QCOMPARE(myTree.containsDirectory(albumDirectory), true);
+        QCOMPARE(myTree.containsDirectory(QUrl::fromLocalFile(QStringLiteral("/home/user"))), false);
+        QCOMPARE(myTree.containsEntry(albumDirectory, firstTrack), true);
+        QCOMPARE(myTree.containsEntry(musicDirectory, firstTrack), false);
+        QCOMPARE(myTree.entries(albumDirectory), QSet<QUrl>({firstTrack, secondTrack}));
+        QCOMPARE(myTree.entries(musicDirectory), QSet<QUrl>({albumDirectory}));
+        QCOMPARE(myTree.directoryUrl(myTree.directoryId(albumDirectory)), albumDirectory);
+
+        myTree.removeEntry(albumDirectory, firstTrack);
+
+        QCOMPARE(myTree.containsEntry(albumDirectory, firstTrack), false);
+        QCOMPARE(myTree.entries(albumDirectory), QSet<QUrl>({secondTrack}));
+
+        myTree.removeDirectory(albumDirectory);
+
+        QCOMPARE(myTree.directoriesCount(), 1);
+        QCOMPARE(myTree.containsDirectory(albumDirectory), false);
+        QCOMPARE(myTree.entries(albumDirectory).isEmpty(), true);
+        QCOMPARE(myTree.containsEntry(musicDirectory, albumDirectory), true);
+
+        myTree.clear();
+
+        QCOMPARE(myTree.directoriesCount(), 0);
+        QCOMPARE(myTree.namesCount(), 0);
+    }
+
+    void entriesOutsideDirectory()
+    {
+        DirectoryTree myTree;
+
+        const auto &musicDirectory = QUrl::fromLocalFile(QStringLiteral("/home/user/Music"));
+        const auto &linkedTrack = QUrl::fromLocalFile(QStringLiteral("/data/shared/track.ogg"));
+
+        myTree.addEntry(musicDirectory, linkedTrack);
+
+        QCOMPARE(myTree.containsDirectory(musicDirectory), true);
+        QCOMPARE(myTree.containsEntry(musicDirectory, linkedTrack), true);
+        QCOMPARE(myTree.entries(musicDirectory), QSet<QUrl>({linkedTrack}));
+
+        myTree.removeEntry(musicDirectory, linkedTrack);
+
+        QCOMPARE(myTree.entries(musicDirectory).isEmpty(), true);
+    }
+
+    void sharedPathComponents()
+    {
+        DirectoryTree myTree;
+
+        for (int i = 0; i < 100; ++i) {
+            const auto &albumDirectory = QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album%1").arg(i));
+
+            for (int j = 0; j < 10; ++j) {
+                myTree.addEntry(albumDirectory, QUrl::fromLocalFile(albumDirectory.toLocalFile() + QStringLiteral("/track%1.ogg").arg(j)));
+            }
+        }
+
+        QCOMPARE(myTree.directoriesCount(), 100);
+        QCOMPARE(myTree.namesCount(), 3 + 100 + 10);
+
+        for (int i = 0; i < 100; ++i) {
+            myTree.removeDirectory(QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album%1").arg(i)));
+        }
+
+        QCOMPARE(myTree.directoriesCount(), 0);
+        QCOMPARE(myTree.containsDirectory(QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album0"))), false);
+    }
+};
+
+QTEST_GUILESS_MAIN(DirectoryTreeTest)
+
+
+#include "directorytreetest.moc"
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "baloo/localbaloofilelisting.h"
+#include "musicaudiotrack.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QList>
+
+#include <QtTest>
+
+class TestBalooFileListing : public LocalBalooFileListing
+{
+
+    Q_OBJECT
+
+public:
+
+    void scanFilesList(const QStringList &resultFiles)
+    {
+        auto itResult = resultFiles.begin();
+
+        scanQueryResults([&itResult, &resultFiles](QString &fileName) {
+            if (itResult == resultFiles.end()) {
+                return false;
+            }
+
+            fileName = *itResult;
+            ++itResult;
+
+            return true;
+        });
+    }
+
+    QList<QUrl> mScannedFiles;
+
+protected:
+
+    MusicAudioTrack scanOneFile(QUrl scanFile) override
+    {
+        mScannedFiles.push_back(scanFile);
+
+        auto newTrack = MusicAudioTrack();
+
+        newTrack.setTitle(scanFile.fileName());
+        newTrack.setAlbumName(QStringLiteral("album1"));
+        newTrack.setArtist(QStringLiteral("artist1"));
+        newTrack.setResourceURI(scanFile);
+        newTrack.setValid(!scanFile.fileName().startsWith(QStringLiteral("invalid")));
+
+        return newTrack;
+    }
+
+};
+
+class LocalBalooFileListingTests: public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+        qRegisterMetaType<QList<MusicAudioTrack>>("QList<MusicAudioTrack>");
+        qRegisterMetaType<QList<QUrl>>("QList<QUrl>");
+    }
+
+    void emptyQueryResults()
+    {
+        TestBalooFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &TestBalooFileListing::tracksList);
+
+        myListing.scanFilesList({});
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(myListing.mScannedFiles.count(), 0);
+    }
+
+    void queryResultsAreEmittedInChunks()
+    {
+        TestBalooFileListing myListing;
+        myListing.setTracksListBatchSize(3);
+
+        QSignalSpy tracksListSpy(&myListing, &TestBalooFileListing::tracksList);
+
+        myListing.scanFilesList({QStringLiteral("/music/album1/track1.ogg"), QStringLiteral("/music/album1/track2.ogg"),
+                                 QStringLiteral("/music/album1/track3.ogg"), QStringLiteral("/music/album1/invalid1.ogg"),
+                                 QStringLiteral("/music/album1/track4.ogg"), QStringLiteral("/music/album1/track5.ogg"),
+                                 QStringLiteral("/music/album1/track6.ogg"), QStringLiteral("/music/album1/track7.ogg")});
+
+        QCOMPARE(myListing.mScannedFiles.count(), 8);
+        QCOMPARE(tracksListSpy.count(), 3);
+
+        const auto &firstChunk = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+        const auto &secondChunk = tracksListSpy.at(1).at(0).value<QList<MusicAudioTrack>>();
+        const auto &thirdChunk = tracksListSpy.at(2).at(0).value<QList<MusicAudioTrack>>();
+
+        QCOMPARE(firstChunk.count(), 3);
+        QCOMPARE(secondChunk.count(), 3);
+        QCOMPARE(thirdChunk.count(), 1);
+
+        QCOMPARE(firstChunk.at(0).title(), QStringLiteral("track1.ogg"));
+        QCOMPARE(secondChunk.at(0).title(), QStringLiteral("track4.ogg"));
+        QCOMPARE(thirdChunk.at(0).title(), QStringLiteral("track7.ogg"));
+
+        QCOMPARE(tracksListSpy.at(0).at(2).toString(), QStringLiteral("baloo"));
+    }
+
+    void duplicatedQueryResultsAreScannedOnce()
+    {
+        TestBalooFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &TestBalooFileListing::tracksList);
+
+        myListing.scanFilesList({QStringLiteral("/music/album1/track1.ogg"), QStringLiteral("/music/album1/track2.ogg"),
+                                 QStringLiteral("/music/album1/track1.ogg"), QStringLiteral("/music/album1/track3.ogg"),
+                                 QStringLiteral("/music/album1/track2.ogg")});
+
+        QCOMPARE(myListing.mScannedFiles.count(), 3);
+        QCOMPARE(myListing.mScannedFiles.at(0), QUrl::fromLocalFile(QStringLiteral("/music/album1/track1.ogg")));
+        QCOMPARE(myListing.mScannedFiles.at(1), QUrl::fromLocalFile(QStringLiteral("/music/album1/track2.ogg")));
+        QCOMPARE(myListing.mScannedFiles.at(2), QUrl::fromLocalFile(QStringLiteral("/music/album1/track3.ogg")));
+
+        QCOMPARE(tracksListSpy.count(), 1);
+
+        const auto &newTracks = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+
+        QCOMPARE(newTracks.count(), 3);
+        QCOMPARE(newTracks.at(0).title(), QStringLiteral("track1.ogg"));
+        QCOMPARE(newTracks.at(1).title(), QStringLiteral("track2.ogg"));
+        QCOMPARE(newTracks.at(2).title(), QStringLiteral("track3.ogg"));
+    }
+};
+
+QTEST_MAIN(LocalBalooFileListingTests)
+
+
+#include "localbaloofilelistingtest.moc"
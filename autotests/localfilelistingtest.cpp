@@ -19,6 +19,8 @@
 
 #include "file/localfilelisting.h"
 #include "musicaudiotrack.h"
+#include "scanprogress.h"
+#include "scanscheduler.h"
 
 #include "config-upnp-qt.h"
 
@@ -26,17 +28,28 @@
 #include <QUrl>
 #include <QString>
 #include <QHash>
+#include <QSet>
 #include <QVector>
 #include <QThread>
 #include <QMetaObject>
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QAtomicInt>
 
 #include <QDebug>
 
 #include <QtTest>
 
+#include <algorithm>
+
+#if defined Q_OS_UNIX
+#include <unistd.h>
+#endif
+
 class LocalFileListingTests: public QObject
 {
     Q_OBJECT
@@ -133,6 +146,373 @@ private Q_SLOTS:
         QCOMPARE(newCovers.count(), 1);
     }
 
+    void initialTestWithTracksInBatches()
+    {
+        LocalFileListing myListing;
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+        myListing.setExtractionThreadsCount(2);
+        myListing.setTracksListBatchSize(2);
+        myListing.setMaximumPendingTracksLists(2);
+
+        QCOMPARE(myListing.extractionThreadsCount(), 2);
+        QCOMPARE(myListing.tracksListBatchSize(), 2);
+        QCOMPARE(myListing.maximumPendingTracksLists(), 2);
+
+        myListing.init();
+
+        myListing.setRootPath(musicPath);
+
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 2);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+
+        auto firstTracks = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+        auto secondTracks = tracksListSpy.at(1).at(0).value<QList<MusicAudioTrack>>();
+        auto newCovers = tracksListSpy.at(1).at(1).value<QHash<QString, QUrl>>();
+
+        QCOMPARE(firstTracks.count(), 2);
+        QCOMPARE(secondTracks.count(), 1);
+        QCOMPARE(newCovers.count(), 1);
+    }
+
+    void tracksBatchesWaitForInsertion()
+    {
+        LocalFileListing myListing;
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.setExtractionThreadsCount(2);
+        myListing.setTracksListBatchSize(1);
+        myListing.setMaximumPendingTracksLists(1);
+
+        QThread acknowledgeThread;
+        acknowledgeThread.start();
+
+        QObject acknowledgeContext;
+        acknowledgeContext.moveToThread(&acknowledgeThread);
+
+        QAtomicInt pendingTracksLists;
+        auto maximumPendingTracksLists = 0;
+        auto emitTimes = QList<qint64>();
+        QElapsedTimer scanTimer;
+
+        connect(&myListing, &LocalFileListing::tracksList, this,
+                [&]() {
+            maximumPendingTracksLists = std::max(maximumPendingTracksLists, int(pendingTracksLists.fetchAndAddOrdered(1)) + 1);
+            emitTimes.push_back(scanTimer.elapsed());
+        }, Qt::DirectConnection);
+
+        connect(&myListing, &LocalFileListing::tracksList, &acknowledgeContext,
+                [&](const QList<MusicAudioTrack> &, const QHash<QString, QUrl> &, const QString &musicSource) {
+            QTimer::singleShot(200, &acknowledgeContext, [&myListing, &pendingTracksLists, musicSource]() {
+                pendingTracksLists.fetchAndSubOrdered(1);
+                myListing.tracksListInserted(musicSource);
+            });
+        }, Qt::QueuedConnection);
+
+        myListing.init();
+
+        myListing.setRootPath(musicPath);
+
+        scanTimer.start();
+        myListing.refreshContent();
+
+        acknowledgeThread.quit();
+        acknowledgeThread.wait();
+
+        QCOMPARE(tracksListSpy.count(), 3);
+        QCOMPARE(emitTimes.count(), 3);
+        QCOMPARE(maximumPendingTracksLists, 1);
+        QVERIFY(emitTimes[1] - emitTimes[0] >= 150);
+        QVERIFY(emitTimes[2] - emitTimes[1] >= 150);
+    }
+
+    void restoredTracksSkipUnchangedFiles()
+    {
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        auto scannedTracks = QList<MusicAudioTrack>();
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setRootPath(musicPath);
+            myListing.refreshContent();
+
+            QCOMPARE(tracksListSpy.count(), 1);
+
+            scannedTracks = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+        }
+
+        QCOMPARE(scannedTracks.count(), 3);
+        QCOMPARE(scannedTracks[0].fileModificationTime().isValid(), true);
+        QCOMPARE(scannedTracks[0].fileSize() > 0, true);
+
+        auto restoredFiles = scannedTracks;
+        restoredFiles[1].setFileSize(restoredFiles[1].fileSize() + 1);
+        restoredFiles.removeAt(2);
+
+        auto vanishedFile = MusicAudioTrack();
+        vanishedFile.setResourceURI(QUrl::fromLocalFile(QFileInfo(musicPath).canonicalFilePath() + QStringLiteral("/vanished.ogg")));
+        restoredFiles.push_back(vanishedFile);
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy sourceScanStartedSpy(&myListing, &LocalFileListing::sourceScanStarted);
+        QSignalSpy seenTracksListSpy(&myListing, &LocalFileListing::seenTracksList);
+        QSignalSpy sourceScanFinishedSpy(&myListing, &LocalFileListing::sourceScanFinished);
+
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.restoredTracks(QStringLiteral("otherSource"), {});
+        myListing.restoredTracks(QStringLiteral("local"), restoredFiles);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(sourceScanStartedSpy.count(), 1);
+        QCOMPARE(seenTracksListSpy.count(), 1);
+        QCOMPARE(sourceScanFinishedSpy.count(), 1);
+        QCOMPARE(sourceScanFinishedSpy.at(0).at(0).toString(), QStringLiteral("local"));
+
+        auto newTracks = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+        auto seenTracks = seenTracksListSpy.at(0).at(0).value<QList<QUrl>>();
+        auto seenDirectories = seenTracksListSpy.at(0).at(1).value<QHash<QUrl, QDateTime>>();
+
+        QCOMPARE(newTracks.count(), 2);
+        QCOMPARE(std::any_of(newTracks.begin(), newTracks.end(),
+                             [&scannedTracks](const MusicAudioTrack &oneTrack) {return oneTrack.resourceURI() == scannedTracks[0].resourceURI();}), false);
+        QCOMPARE(seenTracks.count(), 2);
+        QCOMPARE(seenTracks.contains(scannedTracks[0].resourceURI()), true);
+        QCOMPARE(seenTracks.contains(scannedTracks[1].resourceURI()), true);
+        QCOMPARE(seenTracks.contains(vanishedFile.resourceURI()), false);
+
+        const QFileInfo musicDirectory(QFileInfo(musicPath).canonicalFilePath());
+
+        QCOMPARE(seenDirectories.contains(QUrl::fromLocalFile(musicDirectory.absoluteFilePath())), true);
+        QCOMPARE(seenDirectories.value(QUrl::fromLocalFile(musicDirectory.absoluteFilePath())), musicDirectory.lastModified());
+
+        myListing.refreshContent();
+
+        QCOMPARE(sourceScanStartedSpy.count(), 1);
+        QCOMPARE(sourceScanFinishedSpy.count(), 1);
+    }
+
+    void scanProgressCounters()
+    {
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        ScanProgress myProgress;
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy progressChangedSpy(&myProgress, &ScanProgress::progressChanged);
+
+        myListing.setScanProgress(&myProgress);
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+
+        QTRY_COMPARE(myProgress.isScanning(), false);
+        QCOMPARE(progressChangedSpy.isEmpty(), false);
+        QCOMPARE(myProgress.filesDiscovered(), qulonglong(4));
+        QCOMPARE(myProgress.filesExtracted(), qulonglong(4));
+        QCOMPARE(myProgress.bytesScanned() > 0, true);
+        QCOMPARE(myProgress.tracksWritten(), qulonglong(0));
+        QCOMPARE(myProgress.remainingSeconds(), 0);
+
+        myListing.tracksListInserted(QStringLiteral("local"));
+
+        QTRY_COMPARE(myProgress.tracksWritten(), qulonglong(3));
+    }
+
+    void scanPriorityDirectoryFirst()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music6");
+        QDir musicDirectory(musicPath);
+
+        const auto &albumNames = QStringList({QStringLiteral("album1"), QStringLiteral("album2"), QStringLiteral("album3")});
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+
+        for (const auto &oneAlbum : albumNames) {
+            QCOMPARE(musicDirectory.mkpath(musicPath + QStringLiteral("/") + oneAlbum), true);
+            QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/") + oneAlbum + QStringLiteral("/test.ogg")), true);
+        }
+
+        for (const auto &oneAlbum : albumNames) {
+            ScanScheduler myScheduler;
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            const auto &priorityPath = QFileInfo(musicPath + QStringLiteral("/") + oneAlbum).canonicalFilePath();
+
+            myScheduler.prioritizeDirectory(priorityPath);
+
+            QCOMPARE(myScheduler.isPriorityPath(priorityPath), true);
+            QCOMPARE(myScheduler.isPriorityPath(QFileInfo(musicPath).canonicalFilePath()), true);
+            QCOMPARE(myScheduler.isPriorityPath(priorityPath + QStringLiteral("1")), false);
+
+            myListing.setScanScheduler(&myScheduler);
+            myListing.setTracksListBatchSize(1);
+            myListing.init();
+            myListing.setRootPath(musicPath);
+            myListing.refreshContent();
+
+            QCOMPARE(tracksListSpy.count(), 3);
+
+            auto firstTracks = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+
+            QCOMPARE(firstTracks.count(), 1);
+            QCOMPARE(firstTracks.first().resourceURI(), QUrl::fromLocalFile(priorityPath + QStringLiteral("/test.ogg")));
+        }
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+    }
+
+    void cancelAndRestartScan()
+    {
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        ScanScheduler myScheduler;
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy scanCancelledSpy(&myScheduler, &ScanScheduler::scanCancelled);
+
+        myScheduler.cancel();
+
+        QCOMPARE(scanCancelledSpy.count(), 0);
+
+        auto cancelConnection = connect(&myListing, &LocalFileListing::tracksList, &myScheduler, &ScanScheduler::cancel, Qt::DirectConnection);
+
+        myListing.setScanScheduler(&myScheduler);
+        myListing.setTracksListBatchSize(1);
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(scanCancelledSpy.count(), 1);
+        QCOMPARE(tracksListSpy.count(), 1);
+
+        disconnect(cancelConnection);
+
+        myListing.refreshContent();
+
+        QCOMPARE(scanCancelledSpy.count(), 1);
+        QCOMPARE(tracksListSpy.count(), 3);
+
+        auto allTracks = QSet<QUrl>();
+        for (const auto &oneSignal : tracksListSpy) {
+            for (const auto &oneTrack : oneSignal.at(0).value<QList<MusicAudioTrack>>()) {
+                allTracks.insert(oneTrack.resourceURI());
+            }
+        }
+
+        QCOMPARE(allTracks.count(), 3);
+    }
+
+    void pauseAndResumeScan()
+    {
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        ScanScheduler myScheduler;
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy pausedChangedSpy(&myScheduler, &ScanScheduler::pausedChanged);
+
+        QThread resumeThread;
+        resumeThread.start();
+
+        QTimer resumeTimer;
+        resumeTimer.setSingleShot(true);
+        resumeTimer.setInterval(300);
+        resumeTimer.moveToThread(&resumeThread);
+
+        connect(&resumeTimer, &QTimer::timeout, &myScheduler, &ScanScheduler::resume, Qt::DirectConnection);
+
+        auto emitTimes = QList<qint64>();
+        QElapsedTimer scanTimer;
+
+        connect(&myListing, &LocalFileListing::tracksList, this, [&]() {
+            emitTimes.push_back(scanTimer.elapsed());
+
+            if (emitTimes.size() == 1) {
+                myScheduler.pause();
+                QMetaObject::invokeMethod(&resumeTimer, "start", Qt::QueuedConnection);
+            }
+        }, Qt::DirectConnection);
+
+        myListing.setScanScheduler(&myScheduler);
+        myListing.setTracksListBatchSize(1);
+        myListing.init();
+        myListing.setRootPath(musicPath);
+
+        scanTimer.start();
+        myListing.refreshContent();
+
+        resumeThread.quit();
+        resumeThread.wait();
+
+        QCOMPARE(pausedChangedSpy.count(), 2);
+        QCOMPARE(myScheduler.isPaused(), false);
+        QCOMPARE(tracksListSpy.count(), 3);
+        QVERIFY(emitTimes[1] - emitTimes[0] >= 250);
+    }
+
+    void scanDirectoryWithSymbolicLinkLoop()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music4");
+        QString musicPath = musicParentPath + QStringLiteral("/inner");
+        QDir musicParentDirectory(musicParentPath);
+
+        QCOMPARE(musicParentDirectory.removeRecursively(), true);
+        QCOMPARE(musicParentDirectory.mkpath(musicPath), true);
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test.ogg")), true);
+        QCOMPARE(QFile::link(musicParentPath, musicPath + QStringLiteral("/loop")), true);
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+        myListing.init();
+        myListing.setRootPath(musicParentPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+
+        auto newTracks = tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+
+        QCOMPARE(newTracks.count(), 1);
+        QCOMPARE(newTracks.first().resourceURI(), QUrl::fromLocalFile(QFileInfo(musicPath + QStringLiteral("/test.ogg")).canonicalFilePath()));
+
+        QCOMPARE(musicParentDirectory.removeRecursively(), true);
+    }
+
     void addAndRemoveTracks()
     {
         LocalFileListing myListing;
@@ -325,9 +705,283 @@ private Q_SLOTS:
         auto newTracksLast = newTracksSignalLast.at(0).value<QList<MusicAudioTrack>>();
         auto newCoversLast = newTracksSignalLast.at(1).value<QHash<QString, QUrl>>();
 
-        QCOMPARE(newTracksLast.count(), 2);
+        QCOMPARE(newTracksLast.count(), 1);
         QCOMPARE(newCoversLast.count(), 1);
     }
+
+    void addLinkedTracks()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music10");
+        QDir musicDirectory(musicPath);
+
+        QString musicSourcePath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music10Source");
+        QDir musicSourceDirectory(musicSourcePath);
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+        QCOMPARE(musicSourceDirectory.removeRecursively(), true);
+        QCOMPARE(musicDirectory.mkpath(musicPath), true);
+        QCOMPARE(musicSourceDirectory.mkpath(musicSourcePath), true);
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicSourcePath + QStringLiteral("/test.ogg")), true);
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.mp3"), musicSourcePath + QStringLiteral("/test.mp3")), true);
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 0);
+
+        QCOMPARE(QFile::link(musicSourcePath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test.ogg")), true);
+
+        QCOMPARE(tracksListSpy.wait(), true);
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), 1);
+
+#if defined Q_OS_UNIX
+        QCOMPARE(link(QFile::encodeName(musicSourcePath + QStringLiteral("/test.mp3")).constData(),
+                      QFile::encodeName(musicPath + QStringLiteral("/test.mp3")).constData()), 0);
+
+        QCOMPARE(tracksListSpy.wait(), true);
+        QCOMPARE(tracksListSpy.count(), 2);
+        QCOMPARE(tracksListSpy.at(1).at(0).value<QList<MusicAudioTrack>>().count(), 1);
+#endif
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+        QCOMPARE(musicSourceDirectory.removeRecursively(), true);
+    }
+
+    void moveWatchedRootDirectory()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music7");
+        QDir musicDirectory(musicPath);
+
+        QString musicMovedPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music7Moved");
+        QDir musicMovedDirectory(musicMovedPath);
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+        QCOMPARE(musicMovedDirectory.removeRecursively(), true);
+        QCOMPARE(musicDirectory.mkpath(musicPath + QStringLiteral("/album")), true);
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/album/test.ogg")), true);
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+
+        QCOMPARE(QDir().rename(musicPath, musicMovedPath), true);
+
+        QCOMPARE(removedTracksListSpy.wait(), true);
+        QCOMPARE(removedTracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.at(0).at(0).value<QList<QUrl>>().contains(QUrl::fromLocalFile(musicPath + QStringLiteral("/album/test.ogg"))), true);
+
+        QCOMPARE(musicMovedDirectory.removeRecursively(), true);
+    }
+
+    void replaceTracksInOneQuietWindow()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music5");
+        QDir musicDirectory(musicPath);
+
+        const auto &trackFileNames = QStringList({QStringLiteral("test.ogg"), QStringLiteral("test.mp3"), QStringLiteral("test.m4a")});
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+        QCOMPARE(musicDirectory.mkpath(musicPath), true);
+
+        for (const auto &oneFileName : trackFileNames) {
+            QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/") + oneFileName, musicPath + QStringLiteral("/") + oneFileName), true);
+        }
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy modifyTracksListSpy(&myListing, &LocalFileListing::modifyTracksList);
+
+        myListing.setChangesQuietWindow(1000);
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), 3);
+
+        for (const auto &oneFileName : trackFileNames) {
+            QCOMPARE(QFile::remove(musicPath + QStringLiteral("/") + oneFileName), true);
+            QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/") + oneFileName, musicPath + QStringLiteral("/") + oneFileName), true);
+        }
+
+        QCOMPARE(modifyTracksListSpy.wait(), true);
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(modifyTracksListSpy.count(), 1);
+        QCOMPARE(modifyTracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), 3);
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+    }
+
+    void coverAddedToKnownAlbum()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music9");
+        QDir musicDirectory(musicPath);
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+        QCOMPARE(musicDirectory.mkpath(musicPath), true);
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test.ogg")), true);
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy modifyTracksListSpy(&myListing, &LocalFileListing::modifyTracksList);
+
+        myListing.setChangesQuietWindow(1000);
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(tracksListSpy.at(0).at(1).value<QHash<QString, QUrl>>().isEmpty(), true);
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/cover.jpg"), musicPath + QStringLiteral("/cover.jpg")), true);
+        QCOMPARE(QFile::remove(musicPath + QStringLiteral("/test.ogg")), true);
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test.ogg")), true);
+
+        QCOMPARE(modifyTracksListSpy.wait(), true);
+
+        const auto &modifiedTracks = modifyTracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>();
+        const auto &newCovers = modifyTracksListSpy.at(0).at(1).value<QHash<QString, QUrl>>();
+
+        QCOMPARE(modifiedTracks.count(), 1);
+        QCOMPARE(newCovers.value(modifiedTracks.first().albumName()), QUrl::fromLocalFile(musicPath + QStringLiteral("/cover.jpg")));
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+    }
+
+    void flushChangesDuringContinuousWrites()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music8");
+        QDir musicDirectory(musicPath);
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+        QCOMPARE(musicDirectory.mkpath(musicPath), true);
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.setChangesQuietWindow(200);
+        myListing.init();
+        myListing.setRootPath(musicPath);
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 0);
+
+        const auto writesCount = 40;
+
+        for (int writeIndex = 0; writeIndex < writesCount; ++writeIndex) {
+            QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test%1.ogg").arg(writeIndex)), true);
+            QTest::qWait(100);
+        }
+
+        QVERIFY(tracksListSpy.count() > 0);
+
+        auto newTracksCount = 0;
+        while (true) {
+            newTracksCount = 0;
+            for (const auto &oneSignal : tracksListSpy) {
+                newTracksCount += oneSignal.at(0).value<QList<MusicAudioTrack>>().count();
+            }
+
+            if (newTracksCount >= writesCount || !tracksListSpy.wait()) {
+                break;
+            }
+        }
+
+        QCOMPARE(newTracksCount, writesCount);
+
+        QCOMPARE(musicDirectory.removeRecursively(), true);
+    }
+
+    void benchmarkScanSyntheticTree_data()
+    {
+        QTest::addColumn<int>("threadsCount");
+
+        QTest::newRow("1") << 1;
+        QTest::newRow(QByteArray::number(QThread::idealThreadCount()).constData()) << QThread::idealThreadCount();
+    }
+
+    void benchmarkScanSyntheticTree()
+    {
+        if (!qEnvironmentVariableIsSet("ELISA_RUN_BENCHMARKS")) {
+            QSKIP("set ELISA_RUN_BENCHMARKS to run the scan benchmark");
+        }
+
+        QFETCH(int, threadsCount);
+
+        const auto directoriesCount = qEnvironmentVariableIsSet("ELISA_BENCHMARK_SCAN_DIRECTORIES") ?
+                    qgetenv("ELISA_BENCHMARK_SCAN_DIRECTORIES").toInt() : 100;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+        QString syntheticPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/syntheticTree");
+        QDir syntheticDirectory(syntheticPath);
+
+        QCOMPARE(syntheticDirectory.removeRecursively(), true);
+
+        const auto sampleFiles = QDir(musicOriginPath).entryList(QDir::Files);
+
+        for (int directoryIndex = 0; directoryIndex < directoriesCount; ++directoryIndex) {
+            const auto &albumPath = syntheticPath + QStringLiteral("/artist%1/album%2").arg(directoryIndex % 10).arg(directoryIndex);
+
+            QCOMPARE(syntheticDirectory.mkpath(albumPath), true);
+
+            for (const auto &oneFile : sampleFiles) {
+                QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/") + oneFile, albumPath + QStringLiteral("/") + oneFile), true);
+            }
+        }
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.setExtractionThreadsCount(threadsCount);
+        myListing.init();
+        myListing.setRootPath(syntheticPath);
+
+        QBENCHMARK_ONCE {
+            myListing.refreshContent();
+        }
+
+        auto newTracksCount = 0;
+        for (const auto &oneSignal : tracksListSpy) {
+            newTracksCount += oneSignal.at(0).value<QList<MusicAudioTrack>>().count();
+        }
+
+        QCOMPARE(newTracksCount, 3 * directoriesCount);
+
+        QCOMPARE(syntheticDirectory.removeRecursively(), true);
+    }
 };
 
 QTEST_MAIN(LocalFileListingTests)
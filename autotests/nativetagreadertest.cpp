@@ -0,0 +1,412 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "abstractfile/nativetagreader.h"
+#include "musicaudiotrack.h"
+#include "tagfixtures.h"
+
+#include "config-upnp-qt.h"
+
+#include <KFileMetaData/Properties>
+#include <KFileMetaData/ExtractorCollection>
+#include <KFileMetaData/Extractor>
+#include <KFileMetaData/SimpleExtractionResult>
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QFile>
+#include <QMimeDatabase>
+#include <QTemporaryDir>
+
+#include <QDebug>
+
+#include <QtTest>
+
+using namespace TagFixtures;
+
+class NativeTagReaderTest: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    QByteArray mpegFrames(int framesCount, const QByteArray &firstFrameContent = QByteArray()) const
+    {
+        const auto &frameHeader = QByteArray("\xff\xfb\x90\x00", 4);
+        const auto frameLength = 144 * 128000 / 44100;
+
+        auto firstFrame = frameHeader + firstFrameContent;
+        firstFrame.append(QByteArray(frameLength - firstFrame.size(), '\0'));
+
+        auto result = firstFrame;
+        for (int frameIndex = 1; frameIndex < framesCount; ++frameIndex) {
+            result.append(frameHeader + QByteArray(frameLength - 4, '\0'));
+        }
+
+        return result;
+    }
+
+    QByteArray mp4TextItem(const char *name, const QByteArray &text) const
+    {
+        return mp4Atom(name, mp4Atom("data", bigEndian32(1) + bigEndian32(0) + text));
+    }
+
+    QByteArray mp4NumberItem(const char *name, quint16 number, quint16 total) const
+    {
+        return mp4Atom(name, mp4Atom("data", bigEndian32(0) + bigEndian32(0) + bigEndian16(0) + bigEndian16(number) + bigEndian16(total)));
+    }
+
+    QString writeFile(const QTemporaryDir &directory, const QString &fileName, const QByteArray &content) const
+    {
+        const auto &filePath = directory.path() + QStringLiteral("/") + fileName;
+
+        QFile newFile(filePath);
+        newFile.open(QIODevice::WriteOnly);
+        newFile.write(content);
+
+        return filePath;
+    }
+
+    MusicAudioTrack readWithKFileMetaData(const QString &fileName) const
+    {
+        static KFileMetaData::ExtractorCollection extractors;
+        static QMimeDatabase mimeDatabase;
+
+        MusicAudioTrack newTrack;
+
+        const auto &mimetype = mimeDatabase.mimeTypeForFile(fileName).name();
+        const auto &allExtractors = extractors.fetchExtractors(mimetype);
+
+        if (allExtractors.isEmpty()) {
+            return newTrack;
+        }
+
+        KFileMetaData::SimpleExtractionResult result(fileName, mimetype, KFileMetaData::ExtractionResult::ExtractMetaData);
+
+        allExtractors.first()->extract(&result);
+
+        const auto &allProperties = result.properties();
+
+        newTrack.setTitle(allProperties.value(KFileMetaData::Property::Title).toString());
+        newTrack.setArtist(allProperties.value(KFileMetaData::Property::Artist).toString());
+        newTrack.setAlbumName(allProperties.value(KFileMetaData::Property::Album).toString());
+        newTrack.setTrackNumber(allProperties.value(KFileMetaData::Property::TrackNumber).toInt());
+        newTrack.setDuration(QTime::fromMSecsSinceStartOfDay(1000 * allProperties.value(KFileMetaData::Property::Duration).toDouble()));
+
+        return newTrack;
+    }
+
+private Q_SLOTS:
+
+    void sampleFiles_data()
+    {
+        QTest::addColumn<QString>("fileName");
+        QTest::addColumn<QString>("albumArtist");
+        QTest::addColumn<int>("duration");
+
+        QTest::newRow("mp3") << QStringLiteral("test.mp3") << QStringLiteral("Album Artist") << 1032;
+        QTest::newRow("ogg") << QStringLiteral("test.ogg") << QStringLiteral("Album Artist") << 1000;
+        QTest::newRow("m4a") << QStringLiteral("test.m4a") << QString() << 1028;
+    }
+
+    void sampleFiles()
+    {
+        QFETCH(QString, fileName);
+        QFETCH(QString, albumArtist);
+        QFETCH(int, duration);
+
+        const auto &filePath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/") + fileName;
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Title"));
+        QCOMPARE(track.artist(), QStringLiteral("Artist"));
+        QCOMPARE(track.albumName(), QStringLiteral("Test"));
+        QCOMPARE(track.albumArtist(), albumArtist);
+        QCOMPARE(track.trackNumber(), 1);
+        QCOMPARE(track.discNumber(), 1);
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), duration);
+
+        const auto &referenceTrack = readWithKFileMetaData(filePath);
+
+        QCOMPARE(track.title(), referenceTrack.title());
+        QCOMPARE(track.artist(), referenceTrack.artist());
+        QCOMPARE(track.albumName(), referenceTrack.albumName());
+        QCOMPARE(track.trackNumber(), referenceTrack.trackNumber());
+        QVERIFY(qAbs(track.duration().msecsSinceStartOfDay() - referenceTrack.duration().msecsSinceStartOfDay()) < 1000);
+    }
+
+    void id3v23WithUtf16Text()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &utf16Title = QByteArray(1, '\x01') + QByteArray("\xff\xfe", 2) +
+                QByteArray(reinterpret_cast<const char*>(QStringLiteral("Tïtle").utf16()), 10);
+        const auto &frames = id3v2Frame(3, "TIT2", utf16Title) +
+                id3v2Frame(3, "TPE1", QByteArray(1, '\0') + QByteArray("Artist")) +
+                id3v2Frame(3, "TALB", QByteArray(1, '\0') + QByteArray("Album")) +
+                id3v2Frame(3, "TRCK", QByteArray(1, '\0') + QByteArray("3/12")) +
+                id3v2Frame(3, "TPOS", QByteArray(1, '\0') + QByteArray("2/2")) + QByteArray(16, '\0');
+
+        const auto &filePath = writeFile(musicDirectory, QStringLiteral("track.mp3"), id3v2Tag(3, frames) + mpegFrames(10));
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Tïtle"));
+        QCOMPARE(track.artist(), QStringLiteral("Artist"));
+        QCOMPARE(track.albumName(), QStringLiteral("Album"));
+        QCOMPARE(track.albumArtist(), QString());
+        QCOMPARE(track.trackNumber(), 3);
+        QCOMPARE(track.discNumber(), 2);
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), 10 * 417 * 8 * 1000 / 128000);
+    }
+
+    void id3v24WithXingHeader()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &frames = id3v2Frame(4, "TIT2", QByteArray(1, '\x03') + QByteArray("Titre \xc3\xa9t\xc3\xa9")) +
+                id3v2Frame(4, "TPE2", QByteArray(1, '\x03') + QByteArray("Album Artist")) +
+                id3v2Frame(4, "TALB", QByteArray(1, '\x03') + QByteArray("Album"));
+
+        const auto &xingHeader = QByteArray(32, '\0') + QByteArray("Xing") + bigEndian32(1) + bigEndian32(1000);
+
+        const auto &filePath = writeFile(musicDirectory, QStringLiteral("track.mp3"), id3v2Tag(4, frames) + mpegFrames(4, xingHeader));
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QString::fromUtf8("Titre \xc3\xa9t\xc3\xa9"));
+        QCOMPARE(track.albumArtist(), QStringLiteral("Album Artist"));
+        QCOMPARE(track.albumName(), QStringLiteral("Album"));
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), 1000 * 1152 * 1000 / 44100);
+    }
+
+    void id3v1Only()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        auto id3v1Tag = QByteArray("TAG") + QByteArray("Title").leftJustified(30, '\0') + QByteArray("Artist").leftJustified(30, '\0') +
+                QByteArray("Album").leftJustified(30, '\0') + QByteArray("2017") + QByteArray(28, '\0') +
+                QByteArray(1, '\0') + QByteArray(1, '\x07') + QByteArray(1, '\xff');
+
+        QCOMPARE(id3v1Tag.size(), 128);
+
+        const auto &filePath = writeFile(musicDirectory, QStringLiteral("track.mp3"), mpegFrames(20) + id3v1Tag);
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Title"));
+        QCOMPARE(track.artist(), QStringLiteral("Artist"));
+        QCOMPARE(track.albumName(), QStringLiteral("Album"));
+        QCOMPARE(track.trackNumber(), 7);
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), 20 * 417 * 8 * 1000 / 128000);
+    }
+
+    void flacWithVorbisComments()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        auto streamInfo = QByteArray(10, '\0');
+        const quint64 sampleRate = 44100;
+        const quint64 samplesCount = 10 * sampleRate;
+        const auto packedInfo = (sampleRate << 44) | (quint64(1) << 41) | (quint64(15) << 36) | samplesCount;
+        QByteArray packedInfoData(8, '\0');
+        qToBigEndian(packedInfo, reinterpret_cast<uchar*>(packedInfoData.data()));
+        streamInfo.append(packedInfoData);
+        streamInfo.append(QByteArray(16, '\0'));
+
+        const auto &comments = vorbisComments({QByteArray("title=Title"), QByteArray("ARTIST=Artist"), QByteArray("Album=Album"),
+                                               QByteArray("ALBUMARTIST=Album Artist"), QByteArray("TRACKNUMBER=05"),
+                                               QByteArray("DISCNUMBER=2/3")});
+
+        const auto &filePath = writeFile(musicDirectory, QStringLiteral("track.flac"),
+                                         QByteArray("fLaC") + QByteArray(1, '\0') + bigEndian32(streamInfo.size()).mid(1) + streamInfo +
+                                         QByteArray(1, '\x84') + bigEndian32(comments.size()).mid(1) + comments + QByteArray(64, '\0'));
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Title"));
+        QCOMPARE(track.artist(), QStringLiteral("Artist"));
+        QCOMPARE(track.albumName(), QStringLiteral("Album"));
+        QCOMPARE(track.albumArtist(), QStringLiteral("Album Artist"));
+        QCOMPARE(track.trackNumber(), 5);
+        QCOMPARE(track.discNumber(), 2);
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), 10000);
+    }
+
+    void oggOpus()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &identificationPacket = QByteArray("OpusHead") + QByteArray(1, '\x01') + QByteArray(1, '\x02') +
+                littleEndian16(312) + littleEndian32(44100) + QByteArray(3, '\0');
+        const auto &commentPacket = QByteArray("OpusTags") + vorbisComments({QByteArray("TITLE=Title"), QByteArray("ALBUM=Album"),
+                                                                              QByteArray(300, 'x')});
+
+        const auto &filePath = writeFile(musicDirectory, QStringLiteral("track.opus"),
+                                         oggPage(0, 0, identificationPacket) + oggPage(1, 0, commentPacket) +
+                                         oggPage(2, 48000 * 5 + 312, QByteArray(100, '\0')));
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Title"));
+        QCOMPARE(track.albumName(), QStringLiteral("Album"));
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), 5000);
+    }
+
+    void mp4Atoms()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &movieHeader = mp4Atom("mvhd", bigEndian32(0) + bigEndian32(0) + bigEndian32(0) + bigEndian32(44100) +
+                                          bigEndian32(3 * 44100) + QByteArray(80, '\0'));
+        const auto &itemsList = mp4Atom("ilst", mp4TextItem("\xa9" "nam", "Title") + mp4TextItem("\xa9" "ART", "Artist") +
+                                        mp4TextItem("\xa9" "alb", "Album") + mp4TextItem("aART", "Album Artist") +
+                                        mp4NumberItem("trkn", 4, 10) + mp4NumberItem("disk", 1, 2));
+        const auto &metaAtom = mp4Atom("meta", bigEndian32(0) + mp4Atom("hdlr", QByteArray(25, '\0')) + itemsList);
+
+        const auto &filePath = writeFile(musicDirectory, QStringLiteral("track.m4a"),
+                                         mp4Atom("ftyp", QByteArray("M4A ") + bigEndian32(0)) + mp4Atom("mdat", QByteArray(256, '\0')) +
+                                         mp4Atom("moov", movieHeader + mp4Atom("udta", metaAtom)));
+
+        MusicAudioTrack track;
+
+        QCOMPARE(NativeTagReader::readTags(filePath, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Title"));
+        QCOMPARE(track.artist(), QStringLiteral("Artist"));
+        QCOMPARE(track.albumName(), QStringLiteral("Album"));
+        QCOMPARE(track.albumArtist(), QStringLiteral("Album Artist"));
+        QCOMPARE(track.trackNumber(), 4);
+        QCOMPARE(track.discNumber(), 1);
+        QCOMPARE(track.duration().msecsSinceStartOfDay(), 3000);
+    }
+
+    void tagsWithoutUsableFrames()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &unknownFrames = id3v2Frame(3, "TXXX", QByteArray(1, '\0') + QByteArray("Key") + QByteArray(1, '\0') + QByteArray("Value")) +
+                id3v2Frame(3, "TCON", QByteArray(1, '\0') + QByteArray("Genre"));
+        const auto &titleOnlyFrames = id3v2Frame(3, "TIT2", QByteArray(1, '\0') + QByteArray("Title"));
+
+        const auto &filePaths = QStringList({
+            writeFile(musicDirectory, QStringLiteral("unknownFrames.mp3"), id3v2Tag(3, unknownFrames) + mpegFrames(10)),
+            writeFile(musicDirectory, QStringLiteral("titleOnly.mp3"), id3v2Tag(3, titleOnlyFrames) + mpegFrames(10)),
+            writeFile(musicDirectory, QStringLiteral("noAlbum.ogg"), oggPage(0, 0, QByteArray("OpusHead") + QByteArray(1, '\x01') + QByteArray(1, '\x02') +
+                                                                               littleEndian16(312) + littleEndian32(44100) + QByteArray(3, '\0')) +
+                      oggPage(1, 0, QByteArray("OpusTags") + vorbisComments({QByteArray("TITLE=Title")})) +
+                      oggPage(2, 48000 + 312, QByteArray(100, '\0')))});
+
+        for (const auto &oneFilePath : filePaths) {
+            MusicAudioTrack track;
+
+            QCOMPARE(NativeTagReader::readTags(oneFilePath, track), false);
+        }
+    }
+
+    void unsupportedOrBrokenFiles()
+    {
+        QTemporaryDir musicDirectory;
+
+        QCOMPARE(musicDirectory.isValid(), true);
+
+        const auto &frames = id3v2Frame(3, "TIT2", QByteArray(1, '\0') + QByteArray("Title"));
+        const auto &fullTag = id3v2Tag(3, frames);
+
+        const auto &filePaths = QStringList({
+            writeFile(musicDirectory, QStringLiteral("empty.mp3"), QByteArray()),
+            writeFile(musicDirectory, QStringLiteral("text.mp3"), QByteArray("this is not a music file at all")),
+            writeFile(musicDirectory, QStringLiteral("noAudio.mp3"), fullTag),
+            writeFile(musicDirectory, QStringLiteral("truncatedTag.mp3"), fullTag.left(fullTag.size() / 2)),
+            writeFile(musicDirectory, QStringLiteral("truncated.ogg"), oggPage(0, 0, QByteArray("OpusHead") + QByteArray(11, '\0')).left(40)),
+            writeFile(musicDirectory, QStringLiteral("truncated.m4a"), mp4Atom("ftyp", QByteArray("M4A ") + bigEndian32(0)) + bigEndian32(1000) + QByteArray("moov")),
+            writeFile(musicDirectory, QStringLiteral("noStreamInfo.flac"), QByteArray("fLaC") + QByteArray(1, '\x84') + bigEndian32(8).mid(1) + QByteArray(8, '\0')),
+            QStringLiteral("/fileNotExist.mp3")});
+
+        for (const auto &oneFilePath : filePaths) {
+            MusicAudioTrack track;
+
+            QCOMPARE(NativeTagReader::readTags(oneFilePath, track), false);
+        }
+    }
+
+    void benchmarkTagReading_data()
+    {
+        QTest::addColumn<bool>("useNativeReader");
+
+        QTest::newRow("native") << true;
+        QTest::newRow("KFileMetaData") << false;
+    }
+
+    void benchmarkTagReading()
+    {
+        QFETCH(bool, useNativeReader);
+
+        const auto &musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/");
+        const auto &fileNames = QStringList({musicPath + QStringLiteral("test.mp3"), musicPath + QStringLiteral("test.ogg"),
+                                             musicPath + QStringLiteral("test.m4a")});
+
+        auto validTracksCount = 0;
+
+        QBENCHMARK {
+            for (const auto &oneFileName : fileNames) {
+                MusicAudioTrack track;
+
+                if (useNativeReader) {
+                    NativeTagReader::readTags(oneFileName, track);
+                } else {
+                    track = readWithKFileMetaData(oneFileName);
+                }
+
+                if (!track.albumName().isEmpty()) {
+                    ++validTracksCount;
+                }
+            }
+        }
+
+        QVERIFY(validTracksCount >= fileNames.size());
+    }
+};
+
+QTEST_GUILESS_MAIN(NativeTagReaderTest)
+
+
+#include "nativetagreadertest.moc"
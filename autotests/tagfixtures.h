@@ -0,0 +1,123 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef TAGFIXTURES_H
+#define TAGFIXTURES_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace TagFixtures
+{
+
+inline QByteArray bigEndian16(quint16 value)
+{
+    QByteArray result(2, '\0');
+    qToBigEndian(value, reinterpret_cast<uchar*>(result.data()));
+    return result;
+}
+
+inline QByteArray bigEndian32(quint32 value)
+{
+    QByteArray result(4, '\0');
+    qToBigEndian(value, reinterpret_cast<uchar*>(result.data()));
+    return result;
+}
+
+inline QByteArray littleEndian16(quint16 value)
+{
+    QByteArray result(2, '\0');
+    qToLittleEndian(value, reinterpret_cast<uchar*>(result.data()));
+    return result;
+}
+
+inline QByteArray littleEndian32(quint32 value)
+{
+    QByteArray result(4, '\0');
+    qToLittleEndian(value, reinterpret_cast<uchar*>(result.data()));
+    return result;
+}
+
+inline QByteArray littleEndian64(quint64 value)
+{
+    QByteArray result(8, '\0');
+    qToLittleEndian(value, reinterpret_cast<uchar*>(result.data()));
+    return result;
+}
+
+inline QByteArray syncSafe32(quint32 value)
+{
+    QByteArray result;
+    result.append(static_cast<char>((value >> 21) & 0x7f));
+    result.append(static_cast<char>((value >> 14) & 0x7f));
+    result.append(static_cast<char>((value >> 7) & 0x7f));
+    result.append(static_cast<char>(value & 0x7f));
+    return result;
+}
+
+inline QByteArray id3v2Tag(int majorVersion, const QByteArray &frames)
+{
+    return QByteArray("ID3") + QByteArray(1, static_cast<char>(majorVersion)) + QByteArray(2, '\0') +
+            syncSafe32(frames.size()) + frames;
+}
+
+inline QByteArray id3v2Frame(int majorVersion, const char *frameId, const QByteArray &content)
+{
+    return QByteArray(frameId) + (majorVersion == 4 ? syncSafe32(content.size()) : bigEndian32(content.size())) +
+            QByteArray(2, '\0') + content;
+}
+
+inline QByteArray vorbisComments(const QList<QByteArray> &comments)
+{
+    const auto &vendor = QByteArray("elisa");
+
+    auto result = littleEndian32(vendor.size()) + vendor + littleEndian32(comments.size());
+    for (const auto &oneComment : comments) {
+        result.append(littleEndian32(oneComment.size()) + oneComment);
+    }
+
+    return result;
+}
+
+inline QByteArray oggPage(quint32 sequenceNumber, quint64 granulePosition, const QByteArray &packet)
+{
+    auto segmentsSizes = QByteArray();
+    for (auto remainingSize = packet.size(); ; remainingSize -= 255) {
+        segmentsSizes.append(static_cast<char>(std::min(remainingSize, 255)));
+        if (remainingSize < 255) {
+            break;
+        }
+    }
+
+    return QByteArray("OggS") + QByteArray(1, '\0') + QByteArray(1, sequenceNumber == 0 ? '\x02' : '\0') +
+            littleEndian64(granulePosition) + littleEndian32(1) + littleEndian32(sequenceNumber) + littleEndian32(0) +
+            QByteArray(1, static_cast<char>(segmentsSizes.size())) + segmentsSizes + packet;
+}
+
+inline QByteArray mp4Atom(const char *name, const QByteArray &content)
+{
+    return bigEndian32(content.size() + 8) + QByteArray(name, 4) + content;
+}
+
+}
+
+#endif // TAGFIXTURES_H
@@ -65,24 +65,32 @@ Item {
         id: contentModel
 
         albumData: topListing.albumData
+
+        onAlbumTracksRequested: musicListener.requestAlbumTracks(albumId)
+    }
+
+    Connections {
+        target: musicListener
+
+        onAlbumTracksLoaded: contentModel.albumTracksLoaded(album)
     }
 
     Connections {
         target: musicListener
 
-        onTrackAdded: contentModel.trackAdded(newTrack)
+        onTracksAdded: contentModel.tracksAdded(newTracks)
     }
 
     Connections {
         target: musicListener
 
-        onTrackRemoved: contentModel.trackRemoved(removedTrack)
+        onTracksRemoved: contentModel.tracksRemoved(removedTracks)
     }
 
     Connections {
         target: musicListener
 
-        onTrackModified: contentModel.trackModified(modifiedTrack)
+        onTracksModified: contentModel.tracksModified(modifiedTracks)
     }
 
     ColumnLayout {
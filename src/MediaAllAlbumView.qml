@@ -43,6 +43,18 @@ Item {
         colorGroup: SystemPalette.Active
     }
 
+    Connections {
+        target: musicListener
+
+        onSearchResultsReady: filterProxyModel.setSearchResults(searchText, albumIds)
+    }
+
+    Connections {
+        target: contentDirectoryModel
+
+        onRowsInserted: if (filterProxyModel.filterText) musicListener.searchItems(filterProxyModel.filterText)
+    }
+
     ColumnLayout {
         anchors.fill: parent
         spacing: 0
@@ -133,11 +145,15 @@ Item {
                         id: delegateContentModel
 
                         model: AlbumFilterProxyModel {
+                            id: filterProxyModel
+
                             sourceModel: rootElement.contentDirectoryModel
 
                             filterText: filterTextInput.text
 
                             filterRating: ratingFilter.starRating
+
+                            onFilterTextChanged: rootElement.musicListener.searchItems(filterText)
                         }
 
                         delegate: MediaAlbumDelegate {
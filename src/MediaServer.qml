@@ -120,6 +120,8 @@ ApplicationWindow {
 
     MusicListenersManager {
         id: allListeners
+
+        scanScheduler.playbackActive: audioPlayer.playbackState === Audio.PlayingState
     }
 
     AudioWrapper {
@@ -226,19 +228,19 @@ ApplicationWindow {
     Connections {
         target: allListeners
 
-        onAlbumAdded: allAlbumsModel.albumAdded(newAlbum)
+        onAlbumsAdded: allAlbumsModel.albumsAdded(newAlbums)
     }
 
     Connections {
         target: allListeners
 
-        onAlbumRemoved: allAlbumsModel.albumRemoved(removedAlbum)
+        onAlbumsRemoved: allAlbumsModel.albumsRemoved(removedAlbums)
     }
 
     Connections {
         target: allListeners
 
-        onAlbumModified: allAlbumsModel.albumModified(modifiedAlbum)
+        onAlbumsModified: allAlbumsModel.albumsModified(modifiedAlbums)
     }
 
     AllArtistsModel {
@@ -248,19 +250,19 @@ ApplicationWindow {
     Connections {
         target: allListeners
 
-        onArtistAdded: allArtistsModel.artistAdded(newArtist)
+        onArtistsAdded: allArtistsModel.artistsAdded(newArtists)
     }
 
     Connections {
         target: allListeners
 
-        onArtistRemoved: allArtistsModel.artistRemoved(removedArtist)
+        onArtistsRemoved: allArtistsModel.artistsRemoved(removedArtists)
     }
 
     Connections {
         target: allListeners
 
-        onArtistModified: allArtistsModel.artistModified(modifiedArtist)
+        onArtistsModified: allArtistsModel.artistsModified(modifiedArtists)
     }
 
     Menu {
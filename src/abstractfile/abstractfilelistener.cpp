@@ -63,6 +63,15 @@ void AbstractFileListener::setDatabaseInterface(DatabaseInterface *model)
         connect(d->mFileListing, &AbstractFileListing::tracksList, model, &DatabaseInterface::insertTracksList);
         connect(d->mFileListing, &AbstractFileListing::removedTracksList, model, &DatabaseInterface::removeTracksList);
         connect(d->mFileListing, &AbstractFileListing::modifyTracksList, model, &DatabaseInterface::modifyTracksList);
+        connect(model, &DatabaseInterface::tracksListInserted, d->mFileListing, &AbstractFileListing::tracksListInserted, Qt::DirectConnection);
+        connect(d->mFileListing, &AbstractFileListing::askRestoredTracks, model, &DatabaseInterface::askRestoredTracks);
+        connect(model, &DatabaseInterface::restoredTracks, d->mFileListing, &AbstractFileListing::restoredTracks);
+        connect(d->mFileListing, &AbstractFileListing::sourceScanStarted, model, &DatabaseInterface::beginSourceScan);
+        connect(d->mFileListing, &AbstractFileListing::seenTracksList, model, &DatabaseInterface::markSeenTracksList);
+        connect(d->mFileListing, &AbstractFileListing::sourceScanFinished, model, &DatabaseInterface::finishSourceScan);
+        connect(model, &DatabaseInterface::albumCoversListed, d->mFileListing, &AbstractFileListing::albumCoversListed);
+
+        d->mFileListing->setMaximumPendingTracksLists(2);
 
         QMetaObject::invokeMethod(d->mFileListing, "init", Qt::QueuedConnection);
     }
@@ -70,8 +79,19 @@ void AbstractFileListener::setDatabaseInterface(DatabaseInterface *model)
     Q_EMIT databaseInterfaceChanged();
 }
 
+void AbstractFileListener::setScanProgress(ScanProgress *scanProgress)
+{
+    d->mFileListing->setScanProgress(scanProgress);
+}
+
+void AbstractFileListener::setScanScheduler(ScanScheduler *scanScheduler)
+{
+    d->mFileListing->setScanScheduler(scanScheduler);
+}
+
 void AbstractFileListener::applicationAboutToQuit()
 {
+    d->mFileQueryThread.requestInterruption();
     d->mFileQueryThread.exit();
     d->mFileQueryThread.wait();
 }
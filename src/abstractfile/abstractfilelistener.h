@@ -28,6 +28,8 @@ class AbstractFileListenerPrivate;
 class DatabaseInterface;
 class MusicAudioTrack;
 class AbstractFileListing;
+class ScanProgress;
+class ScanScheduler;
 
 class AbstractFileListener : public QObject
 {
@@ -45,6 +47,10 @@ public:
 
     DatabaseInterface* databaseInterface() const;
 
+    void setScanProgress(ScanProgress *scanProgress);
+
+    void setScanScheduler(ScanScheduler *scanScheduler);
+
 Q_SIGNALS:
 
     void databaseInterfaceChanged();
@@ -18,8 +18,14 @@
  */
 
 #include "abstractfilelisting.h"
+#include "inotifydirectorywatcher.h"
+#include "coverresolver.h"
+#include "nativetagreader.h"
+#include "directorytree.h"
 
 #include "musicaudiotrack.h"
+#include "scanprogress.h"
+#include "scanscheduler.h"
 
 #include <KFileMetaData/Properties>
 #include <KFileMetaData/ExtractorCollection>
@@ -28,12 +34,27 @@
 #include <KFileMetaData/UserMetaData>
 
 #include <QThread>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QQueue>
 #include <QHash>
 #include <QFileInfo>
+#include <QDateTime>
+#include <QFile>
+#include <QMetaMethod>
 #include <QDir>
+#include <QDirIterator>
 #include <QFileSystemWatcher>
 #include <QMimeDatabase>
 #include <QSet>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <qplatformdefs.h>
 
 #include <algorithm>
 
@@ -47,14 +68,343 @@ public:
 
     QFileSystemWatcher mFileSystemWatcher;
 
+    InotifyDirectoryWatcher *mDirectoryWatcher = nullptr;
+
+    QTimer *mPendingChangesTimer = nullptr;
+
+    int mChangesQuietWindow = 500;
+
+    QElapsedTimer mPendingChangesAge;
+
+    static const int mMaximumChangesDelayFactor = 10;
+
+    static const int mMaximumPendingChanges = 1000;
+
+    QSet<QUrl> mPendingChangedPaths;
+
+    QSet<QUrl> mPendingChangedDirectories;
+
     QHash<QString, QUrl> mAllAlbumCover;
 
-    QHash<QUrl, QSet<QUrl>> mDiscoveredFiles;
+    QHash<QString, QStringList> mDirectoryAlbumCovers;
+
+    CoverResolver mCoverResolver;
+
+    DirectoryTree mDiscoveredFiles;
 
     QString mSourceName;
 
     bool mHandleNewFiles = true;
 
+    QThreadPool mExtractionPool;
+
+    int mTracksListBatchSize = 500;
+
+    QMutex mPendingTracksListsMutex;
+
+    QWaitCondition mTracksListInserted;
+
+    int mPendingTracksLists = 0;
+
+    int mMaximumPendingTracksLists = 0;
+
+    QQueue<int> mPendingTracksListsSizes;
+
+    ScanProgress *mScanProgress = nullptr;
+
+    ScanScheduler *mScanScheduler = nullptr;
+
+    QStringList mPriorityDirectories;
+
+    int mPriorityGeneration = -1;
+
+    bool mScanRunning = false;
+
+    int mScanGeneration = 0;
+
+    QHash<QUrl, MusicAudioTrack> mRestoredFiles;
+
+    QList<QUrl> mSeenRestoredFiles;
+
+    QHash<QUrl, QDateTime> mSeenDirectories;
+
+    bool mSweepRestoredFiles = false;
+
+    bool mSweepingRestoredFiles = false;
+
+    bool mWaitForRestoredTracks = false;
+
+    bool mRefreshAfterRestoredTracks = false;
+
+};
+
+static qulonglong fileInode(const QString &fileName)
+{
+#if defined Q_OS_UNIX
+    QT_STATBUF statBuffer;
+
+    if (QT_STAT(QFile::encodeName(fileName).constData(), &statBuffer) == 0) {
+        return statBuffer.st_ino;
+    }
+#else
+    Q_UNUSED(fileName);
+#endif
+
+    return 0;
+}
+
+class ExtractorRegistry
+{
+public:
+
+    KFileMetaData::Extractor* extractorForMimeType(const QString &mimetype)
+    {
+        auto itExtractor = mExtractors.constFind(mimetype);
+        if (itExtractor != mExtractors.constEnd()) {
+            return *itExtractor;
+        }
+
+        const auto &exList = mExtractorCollection.fetchExtractors(mimetype);
+        auto newExtractor = exList.isEmpty() ? nullptr : exList.first();
+
+        mExtractors[mimetype] = newExtractor;
+
+        return newExtractor;
+    }
+
+    QMimeDatabase mMimeDatabase;
+
+private:
+
+    KFileMetaData::ExtractorCollection mExtractorCollection;
+
+    QHash<QString, KFileMetaData::Extractor*> mExtractors;
+
+};
+
+static QThreadStorage<ExtractorRegistry*> extractorRegistries;
+
+static ExtractorRegistry& currentExtractorRegistry()
+{
+    if (!extractorRegistries.hasLocalData()) {
+        extractorRegistries.setLocalData(new ExtractorRegistry);
+    }
+
+    return *extractorRegistries.localData();
+}
+
+static bool extractTagsWithKFileMetaData(const QString &fileName, MusicAudioTrack &newTrack)
+{
+    auto &registry = currentExtractorRegistry();
+
+    QString mimetype = registry.mMimeDatabase.mimeTypeForFile(fileName).name();
+
+    KFileMetaData::Extractor* ex = registry.extractorForMimeType(mimetype);
+
+    if (!ex) {
+        return false;
+    }
+
+    KFileMetaData::SimpleExtractionResult result(fileName, mimetype,
+                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+
+    ex->extract(&result);
+
+    const auto &allProperties = result.properties();
+
+    auto titleProperty = allProperties.find(KFileMetaData::Property::Title);
+    auto durationProperty = allProperties.find(KFileMetaData::Property::Duration);
+    auto artistProperty = allProperties.find(KFileMetaData::Property::Artist);
+    auto albumProperty = allProperties.find(KFileMetaData::Property::Album);
+    auto albumArtistProperty = allProperties.find(KFileMetaData::Property::AlbumArtist);
+    auto trackNumberProperty = allProperties.find(KFileMetaData::Property::TrackNumber);
+    auto discNumberProperty = allProperties.find(KFileMetaData::Property::DiscNumber);
+
+    if (albumProperty != allProperties.end()) {
+        newTrack.setAlbumName(albumProperty->toString());
+    }
+
+    if (artistProperty != allProperties.end()) {
+        newTrack.setArtist(artistProperty->toString());
+    }
+
+    if (durationProperty != allProperties.end()) {
+        newTrack.setDuration(QTime::fromMSecsSinceStartOfDay(1000 * durationProperty->toDouble()));
+    }
+
+    if (titleProperty != allProperties.end()) {
+        newTrack.setTitle(titleProperty->toString());
+    }
+
+    if (trackNumberProperty != allProperties.end()) {
+        newTrack.setTrackNumber(trackNumberProperty->toInt());
+    }
+
+    if (discNumberProperty != allProperties.end()) {
+        newTrack.setDiscNumber(discNumberProperty->toInt());
+    }
+
+    if (albumArtistProperty != allProperties.end()) {
+        newTrack.setAlbumArtist(albumArtistProperty->toString());
+    }
+
+    return true;
+}
+
+static MusicAudioTrack extractTrackFromFile(const QUrl &scanFile, bool &isMusicFile)
+{
+    MusicAudioTrack newTrack;
+
+    const auto &fileName = scanFile.toLocalFile();
+
+    isMusicFile = NativeTagReader::readTags(fileName, newTrack) || extractTagsWithKFileMetaData(fileName, newTrack);
+
+    if (!isMusicFile || newTrack.albumName().isEmpty()) {
+        return MusicAudioTrack();
+    }
+
+    if (newTrack.albumArtist().isEmpty()) {
+        newTrack.setAlbumArtist(newTrack.artist());
+    }
+
+    if (newTrack.artist().isEmpty()) {
+        newTrack.setArtist(newTrack.albumArtist());
+    }
+
+    newTrack.setResourceURI(scanFile);
+
+    newTrack.setRating(KFileMetaData::UserMetaData(fileName).rating());
+
+    QFileInfo scanFileInfo(fileName);
+
+    newTrack.setFileSize(scanFileInfo.size());
+    newTrack.setFileModificationTime(scanFileInfo.lastModified());
+    newTrack.setFileInode(fileInode(fileName));
+
+    newTrack.setValid(true);
+
+    return newTrack;
+}
+
+class FileExtractionResults
+{
+public:
+
+    QMutex mMutex;
+
+    QWaitCondition mTrackExtracted;
+
+    QHash<int, QPair<MusicAudioTrack, bool>> mTracks;
+
+};
+
+class FileExtractionTask : public QRunnable
+{
+public:
+
+    FileExtractionTask(FileExtractionResults &results, const QUrl &fileName, int index, ScanScheduler *scanScheduler)
+        : mResults(results), mFileName(fileName), mIndex(index), mScanScheduler(scanScheduler)
+    {
+    }
+
+    void run() override
+    {
+        if (mScanScheduler) {
+            mScanScheduler->applyIoPriority();
+        }
+
+        auto isMusicFile = false;
+        auto newTrack = extractTrackFromFile(mFileName, isMusicFile);
+
+        QMutexLocker locker(&mResults.mMutex);
+
+        mResults.mTracks[mIndex] = {newTrack, isMusicFile};
+        mResults.mTrackExtracted.wakeAll();
+    }
+
+private:
+
+    FileExtractionResults &mResults;
+
+    QUrl mFileName;
+
+    int mIndex;
+
+    ScanScheduler *mScanScheduler;
+
+};
+
+class FileExtractionQueue
+{
+public:
+
+    FileExtractionQueue(QThreadPool &extractionPool, ScanScheduler *scanScheduler,
+                        const std::function<bool(int, const MusicAudioTrack&, bool)> &handleExtractedTrack)
+        : mExtractionPool(extractionPool), mScanScheduler(scanScheduler), mHandleExtractedTrack(handleExtractedTrack),
+          mMaximumQueuedFiles(4 * extractionPool.maxThreadCount())
+    {
+    }
+
+    ~FileExtractionQueue()
+    {
+        mExtractionPool.clear();
+        mExtractionPool.waitForDone();
+    }
+
+    void addFile(const QUrl &fileName)
+    {
+        mFiles.push_back(fileName);
+    }
+
+    void handleExtractedTracks(bool waitForAllFiles)
+    {
+        while (!mIsStopped && mNextHandledFile < mFiles.size()) {
+            for (; mNextQueuedFile < mFiles.size() && mNextQueuedFile < mNextHandledFile + mMaximumQueuedFiles; ++mNextQueuedFile) {
+                mExtractionPool.start(new FileExtractionTask(mResults, mFiles[mNextQueuedFile], mNextQueuedFile, mScanScheduler));
+            }
+
+            auto extractedTrack = QPair<MusicAudioTrack, bool>();
+
+            {
+                QMutexLocker locker(&mResults.mMutex);
+
+                if (!waitForAllFiles && mNextQueuedFile == mFiles.size() && !mResults.mTracks.contains(mNextHandledFile)) {
+                    return;
+                }
+
+                while (!mResults.mTracks.contains(mNextHandledFile)) {
+                    mResults.mTrackExtracted.wait(&mResults.mMutex);
+                }
+
+                extractedTrack = mResults.mTracks.take(mNextHandledFile);
+            }
+
+            mIsStopped = !mHandleExtractedTrack(mNextHandledFile, extractedTrack.first, extractedTrack.second);
+
+            ++mNextHandledFile;
+        }
+    }
+
+private:
+
+    QThreadPool &mExtractionPool;
+
+    ScanScheduler *mScanScheduler;
+
+    std::function<bool(int, const MusicAudioTrack&, bool)> mHandleExtractedTrack;
+
+    int mMaximumQueuedFiles;
+
+    FileExtractionResults mResults;
+
+    QList<QUrl> mFiles;
+
+    int mNextQueuedFile = 0;
+
+    int mNextHandledFile = 0;
+
+    bool mIsStopped = false;
+
 };
 
 AbstractFileListing::AbstractFileListing(const QString &sourceName, QObject *parent) : QObject(parent), d(new AbstractFileListingPrivate(sourceName))
@@ -63,22 +413,133 @@ AbstractFileListing::AbstractFileListing(const QString &sourceName, QObject *par
             this, &AbstractFileListing::directoryChanged);
     connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
             this, &AbstractFileListing::fileChanged);
+
+    d->mDirectoryWatcher = new InotifyDirectoryWatcher(this);
+
+    connect(d->mDirectoryWatcher, &InotifyDirectoryWatcher::changesDetected,
+            this, &AbstractFileListing::directoryChangesDetected);
+    connect(d->mDirectoryWatcher, &InotifyDirectoryWatcher::eventsOverflow,
+            this, &AbstractFileListing::refreshContent);
+
+    d->mPendingChangesTimer = new QTimer(this);
+    d->mPendingChangesTimer->setSingleShot(true);
+
+    connect(d->mPendingChangesTimer, &QTimer::timeout,
+            this, &AbstractFileListing::processPendingChanges);
 }
 
 AbstractFileListing::~AbstractFileListing()
 {
 }
 
+int AbstractFileListing::extractionThreadsCount() const
+{
+    return d->mExtractionPool.maxThreadCount();
+}
+
+void AbstractFileListing::setExtractionThreadsCount(int threadsCount)
+{
+    d->mExtractionPool.setMaxThreadCount(std::max(1, threadsCount));
+}
+
+int AbstractFileListing::tracksListBatchSize() const
+{
+    return d->mTracksListBatchSize;
+}
+
+void AbstractFileListing::setTracksListBatchSize(int batchSize)
+{
+    d->mTracksListBatchSize = std::max(1, batchSize);
+}
+
+int AbstractFileListing::maximumPendingTracksLists() const
+{
+    QMutexLocker locker(&d->mPendingTracksListsMutex);
+
+    return d->mMaximumPendingTracksLists;
+}
+
+void AbstractFileListing::setMaximumPendingTracksLists(int pendingCount)
+{
+    QMutexLocker locker(&d->mPendingTracksListsMutex);
+
+    d->mMaximumPendingTracksLists = pendingCount;
+    d->mTracksListInserted.wakeAll();
+}
+
+ScanProgress *AbstractFileListing::scanProgress() const
+{
+    return d->mScanProgress;
+}
+
+void AbstractFileListing::setScanProgress(ScanProgress *scanProgress)
+{
+    d->mScanProgress = scanProgress;
+}
+
+ScanScheduler *AbstractFileListing::scanScheduler() const
+{
+    return d->mScanScheduler;
+}
+
+void AbstractFileListing::setScanScheduler(ScanScheduler *scanScheduler)
+{
+    d->mScanScheduler = scanScheduler;
+}
+
+int AbstractFileListing::changesQuietWindow() const
+{
+    return d->mChangesQuietWindow;
+}
+
+void AbstractFileListing::setChangesQuietWindow(int quietWindow)
+{
+    d->mChangesQuietWindow = std::max(0, quietWindow);
+}
+
 void AbstractFileListing::init()
 {
     executeInit();
+
+    if (d->mHandleNewFiles && isSignalConnected(QMetaMethod::fromSignal(&AbstractFileListing::askRestoredTracks))) {
+        d->mWaitForRestoredTracks = true;
+
+        Q_EMIT askRestoredTracks(d->mSourceName);
+    }
 }
 
 void AbstractFileListing::databaseIsReady()
 {
+    if (d->mWaitForRestoredTracks) {
+        d->mRefreshAfterRestoredTracks = true;
+        return;
+    }
+
     refreshContent();
 }
 
+void AbstractFileListing::restoredTracks(const QString &musicSource, const QList<MusicAudioTrack> &restoredFiles)
+{
+    if (musicSource != d->mSourceName) {
+        return;
+    }
+
+    d->mRestoredFiles.clear();
+    d->mRestoredFiles.reserve(restoredFiles.size());
+
+    for (const auto &oneFile : restoredFiles) {
+        d->mRestoredFiles[oneFile.resourceURI()] = oneFile;
+    }
+
+    d->mSweepRestoredFiles = true;
+    d->mWaitForRestoredTracks = false;
+
+    if (d->mRefreshAfterRestoredTracks) {
+        d->mRefreshAfterRestoredTracks = false;
+        refreshContent();
+    }
+}
+
 void AbstractFileListing::newTrackFile(MusicAudioTrack partialTrack)
 {
     const auto &newTrack = scanOneFile(partialTrack.resourceURI());
@@ -88,195 +549,398 @@ void AbstractFileListing::newTrackFile(MusicAudioTrack partialTrack)
     }
 }
 
-void AbstractFileListing::scanDirectory(QList<MusicAudioTrack> &newFiles, const QUrl &path, bool recursive)
+void AbstractFileListing::tracksListInserted(const QString &musicSource)
 {
-    QDir rootDirectory(path.toLocalFile());
-    rootDirectory.refresh();
+    if (musicSource != d->mSourceName) {
+        return;
+    }
 
-    if (rootDirectory.exists()) {
-        watchPath(path.toLocalFile());
+    QMutexLocker locker(&d->mPendingTracksListsMutex);
+
+    if (d->mPendingTracksLists > 0) {
+        --d->mPendingTracksLists;
     }
 
-    auto &currentDirectoryListingFiles = d->mDiscoveredFiles[path];
+    if (!d->mPendingTracksListsSizes.isEmpty() && d->mScanProgress) {
+        d->mScanProgress->addWrittenTracks(d->mPendingTracksListsSizes.dequeue());
+    }
 
-    auto currentFilesList = QSet<QUrl>();
+    d->mTracksListInserted.wakeAll();
+}
 
-    rootDirectory.refresh();
-    const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
-    for (auto oneEntry : entryList) {
-        auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalFilePath());
+void AbstractFileListing::scanDirectory(QList<QPair<QUrl, QUrl>> &newFiles, QList<QUrl> &removedFiles, const QUrl &path, bool recursive,
+                                        const std::function<void(const QList<QPair<QUrl, QUrl>>&)> &directoryScanned)
+{
+    auto pendingDirectories = QList<QUrl>({path});
+    auto visitedDirectories = QSet<QUrl>();
 
-        if (oneEntry.isDir() || oneEntry.isFile()) {
-            currentFilesList.insert(newFilePath);
+    while (!pendingDirectories.isEmpty()) {
+        if (!waitForScanTurn()) {
+            break;
         }
-    }
 
-    auto removedTracks = QList<QUrl>();
-    for (const auto &removedFilePath : currentDirectoryListingFiles) {
-        auto itFilePath = std::find(currentFilesList.begin(), currentFilesList.end(), removedFilePath);
+        const auto currentPath = takeNextDirectory(pendingDirectories);
+        const auto &currentLocalPath = currentPath.toLocalFile();
 
-        if (itFilePath != currentFilesList.end()) {
+        if (visitedDirectories.contains(currentPath)) {
             continue;
         }
+        visitedDirectories.insert(currentPath);
 
-        removedTracks.push_back(removedFilePath);
-    }
+        const QFileInfo currentDirectoryInfo(currentLocalPath);
 
-    auto allRemovedTracks = QList<QUrl>();
-    for (const auto &oneRemovedTrack : removedTracks) {
-        removeFile(oneRemovedTrack, allRemovedTracks);
-    }
-    for (const auto &oneRemovedTrack : removedTracks) {
-        currentDirectoryListingFiles.remove(oneRemovedTrack);
-    }
+        if (currentDirectoryInfo.isDir()) {
+            watchDirectory(currentLocalPath);
 
-    if (!allRemovedTracks.isEmpty()) {
-        Q_EMIT removedTracksList(allRemovedTracks);
-    }
+            if (d->mSweepingRestoredFiles) {
+                d->mSeenDirectories[currentPath] = currentDirectoryInfo.lastModified();
+            }
+        }
 
-    if (!d->mHandleNewFiles) {
-        return;
-    }
+        d->mDiscoveredFiles.addDirectory(currentPath);
 
-    for (auto newFilePath : currentFilesList) {
-        auto itFilePath = std::find(currentDirectoryListingFiles.begin(), currentDirectoryListingFiles.end(), newFilePath);
+        const auto &currentDirectoryListingFiles = d->mDiscoveredFiles.entries(currentPath);
 
-        if (itFilePath != currentDirectoryListingFiles.end()) {
-            continue;
+        auto currentFilesList = QHash<QUrl, QFileInfo>();
+
+        QDirIterator entriesIterator(currentLocalPath, QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+        while (entriesIterator.hasNext()) {
+            entriesIterator.next();
+
+            const auto &oneEntry = entriesIterator.fileInfo();
+
+            if (!oneEntry.isDir() && !oneEntry.isFile()) {
+                continue;
+            }
+
+            if (oneEntry.isSymLink()) {
+                currentFilesList.insert(QUrl::fromLocalFile(oneEntry.canonicalFilePath()), oneEntry);
+            } else {
+                currentFilesList.insert(QUrl::fromLocalFile(oneEntry.filePath()), oneEntry);
+            }
         }
 
-        QFileInfo oneEntry(newFilePath.toLocalFile());
-        if (recursive && oneEntry.isDir()) {
-            scanDirectory(newFiles, newFilePath);
-            continue;
+        auto removedTracks = QList<QUrl>();
+        for (const auto &oneFilePath : currentDirectoryListingFiles) {
+            if (!currentFilesList.contains(oneFilePath)) {
+                removedTracks.push_back(oneFilePath);
+            }
+        }
+
+        for (const auto &oneRemovedTrack : removedTracks) {
+            removeFile(oneRemovedTrack, removedFiles);
+        }
+        for (const auto &oneRemovedTrack : removedTracks) {
+            d->mDiscoveredFiles.removeEntry(currentPath, oneRemovedTrack);
         }
-        if (!oneEntry.isFile()) {
+
+        if (!d->mHandleNewFiles) {
             continue;
         }
 
-        auto newTrack = scanOneFile(newFilePath);
+        const auto previousNewFilesCount = newFiles.size();
+        auto unchangedFilesCount = 0;
+
+        for (auto itEntry = currentFilesList.cbegin(); itEntry != currentFilesList.cend(); ++itEntry) {
+            const auto &newFilePath = itEntry.key();
+            const auto &oneEntry = itEntry.value();
+
+            if (currentDirectoryListingFiles.contains(newFilePath)) {
+                continue;
+            }
+
+            if (recursive && oneEntry.isDir()) {
+                pendingDirectories.push_back(newFilePath);
+                continue;
+            }
+            if (!oneEntry.isFile()) {
+                continue;
+            }
 
-        if (newTrack.isValid()) {
-            addCover(newTrack);
+            auto itRestoredFile = d->mRestoredFiles.find(newFilePath);
+            if (itRestoredFile != d->mRestoredFiles.end()) {
+                const auto isUnchanged = itRestoredFile->fileModificationTime().isValid() &&
+                        itRestoredFile->fileSize() == oneEntry.size() &&
+                        itRestoredFile->fileModificationTime() == oneEntry.lastModified() &&
+                        itRestoredFile->fileInode() == fileInode(newFilePath.toLocalFile());
+
+                d->mRestoredFiles.erase(itRestoredFile);
+                d->mSeenRestoredFiles.push_back(newFilePath);
+
+                if (isUnchanged) {
+                    watchFile(newFilePath.toLocalFile());
+                    addFileInDirectory(newFilePath, currentPath);
+                    ++unchangedFilesCount;
+                    continue;
+                }
+            }
+
+            newFiles.push_back({newFilePath, currentPath});
+        }
 
-            addFileInDirectory(newTrack.resourceURI(), path);
-            newFiles.push_back(newTrack);
+        if (d->mScanProgress) {
+            d->mScanProgress->addDiscoveredFiles(newFiles.size() - previousNewFilesCount + unchangedFilesCount);
+            d->mScanProgress->addExtractedFiles(unchangedFilesCount, 0);
+        }
+
+        if (directoryScanned && newFiles.size() > previousNewFilesCount) {
+            directoryScanned(newFiles.mid(previousNewFilesCount));
         }
     }
 }
 
-const QString &AbstractFileListing::sourceName() const
+bool AbstractFileListing::handleNewTrack(const QPair<QUrl, QUrl> &newFile, const MusicAudioTrack &newTrack, bool isMusicFile,
+                                         QList<MusicAudioTrack> &newTracks)
 {
-    return d->mSourceName;
+    if (d->mScanProgress) {
+        d->mScanProgress->addExtractedFiles(1, newTrack.fileSize());
+    }
+
+    if (isMusicFile && QFileInfo::exists(newFile.first.toLocalFile())) {
+        watchFile(newFile.first.toLocalFile());
+    }
+
+    if (newTrack.isValid()) {
+        addCover(newTrack);
+
+        addFileInDirectory(newTrack.resourceURI(), newFile.second);
+        newTracks.push_back(newTrack);
+    }
+
+    if (newTracks.size() >= d->mTracksListBatchSize) {
+        emitNewFiles(newTracks);
+        newTracks.clear();
+    }
+
+    if (QThread::currentThread()->isInterruptionRequested()) {
+        newTracks.clear();
+        return false;
+    }
+
+    return waitForScanTurn();
 }
 
-void AbstractFileListing::directoryChanged(const QString &path)
+void AbstractFileListing::extractNewFiles(const QList<QPair<QUrl, QUrl>> &newFiles)
 {
-    const auto directoryEntry = d->mDiscoveredFiles.find(QUrl::fromLocalFile(path));
-    if (directoryEntry == d->mDiscoveredFiles.end()) {
-        return;
+    auto newTracks = QList<MusicAudioTrack>();
+
+    {
+        FileExtractionQueue extractionQueue(d->mExtractionPool, d->mScanScheduler, [&](int currentFile, const MusicAudioTrack &newTrack, bool isMusicFile) {
+            return handleNewTrack(newFiles[currentFile], newTrack, isMusicFile, newTracks);
+        });
+
+        for (const auto &oneNewFile : newFiles) {
+            extractionQueue.addFile(oneNewFile.first);
+        }
+
+        extractionQueue.handleExtractedTracks(true);
     }
 
-    scanDirectoryTree(path);
+    if (!newTracks.isEmpty()) {
+        emitNewFiles(newTracks);
+    }
 }
 
-void AbstractFileListing::fileChanged(const QString &modifiedFileName)
+QList<MusicAudioTrack> AbstractFileListing::extractModifiedFiles(const QList<QUrl> &modifiedFiles)
 {
-    auto modifiedFile = QUrl::fromLocalFile(modifiedFileName);
+    auto modifiedTracks = QList<MusicAudioTrack>();
+
+    for (const auto &oneModifiedFile : modifiedFiles) {
+        if (QThread::currentThread()->isInterruptionRequested() || !waitForScanTurn()) {
+            break;
+        }
 
-    auto modifiedTrack = scanOneFile(modifiedFile);
+        const auto &modifiedTrack = scanOneFile(oneModifiedFile);
 
-    if (modifiedTrack.isValid()) {
-        Q_EMIT modifyTracksList({modifiedTrack}, d->mAllAlbumCover);
+        if (modifiedTrack.isValid()) {
+            addCover(modifiedTrack);
+            modifiedTracks.push_back(modifiedTrack);
+        }
     }
+
+    return modifiedTracks;
 }
 
-void AbstractFileListing::executeInit()
+const QString &AbstractFileListing::sourceName() const
 {
+    return d->mSourceName;
 }
 
-void AbstractFileListing::triggerRefreshOfContent()
+void AbstractFileListing::directoryChanged(const QString &path)
 {
+    const auto &directoryName = QUrl::fromLocalFile(path);
+
+    if (!d->mDiscoveredFiles.containsDirectory(directoryName)) {
+        return;
+    }
+
+    d->mPendingChangedDirectories.insert(directoryName);
+    schedulePendingChanges();
 }
 
-void AbstractFileListing::refreshContent()
+void AbstractFileListing::directoryChangesDetected(const QList<QUrl> &addedPaths, const QList<QUrl> &modifiedFiles,
+                                                   const QList<QPair<QUrl, QUrl>> &movedPaths, const QList<QUrl> &removedPaths)
 {
-    triggerRefreshOfContent();
+    for (const auto &oneRemovedPath : removedPaths) {
+        d->mPendingChangedPaths.insert(oneRemovedPath);
+    }
+    for (const auto &oneMovedPath : movedPaths) {
+        d->mPendingChangedPaths.insert(oneMovedPath.first);
+        d->mPendingChangedPaths.insert(oneMovedPath.second);
+    }
+    for (const auto &oneAddedPath : addedPaths) {
+        d->mPendingChangedPaths.insert(oneAddedPath);
+    }
+    for (const auto &oneModifiedFile : modifiedFiles) {
+        d->mPendingChangedPaths.insert(oneModifiedFile);
+    }
+
+    schedulePendingChanges();
 }
 
-MusicAudioTrack AbstractFileListing::scanOneFile(QUrl scanFile)
+void AbstractFileListing::schedulePendingChanges()
 {
-    MusicAudioTrack newTrack;
-
-    QMimeDatabase mimeDb;
-    QString mimetype = mimeDb.mimeTypeForFile(scanFile.toLocalFile()).name();
+    if (!d->mPendingChangesAge.isValid()) {
+        d->mPendingChangesAge.start();
+    }
 
-    KFileMetaData::ExtractorCollection extractors;
-    QList<KFileMetaData::Extractor*> exList = extractors.fetchExtractors(mimetype);
+    const auto maximumDelay = qint64(AbstractFileListingPrivate::mMaximumChangesDelayFactor) * d->mChangesQuietWindow;
+    const auto remainingDelay = maximumDelay - d->mPendingChangesAge.elapsed();
+    const auto pendingChangesCount = d->mPendingChangedPaths.size() + d->mPendingChangedDirectories.size();
 
-    if (exList.isEmpty()) {
-        return newTrack;
+    if (remainingDelay <= 0 || pendingChangesCount >= AbstractFileListingPrivate::mMaximumPendingChanges) {
+        d->mPendingChangesTimer->start(0);
+        return;
     }
 
-    QFileInfo scanFileInfo(scanFile.toLocalFile());
-    if (scanFileInfo.exists()) {
-        watchPath(scanFile.toLocalFile());
-    }
+    d->mPendingChangesTimer->start(int(std::min<qint64>(d->mChangesQuietWindow, remainingDelay)));
+}
 
-    KFileMetaData::Extractor* ex = exList.first();
-    KFileMetaData::SimpleExtractionResult result(scanFile.toLocalFile(), mimetype,
-                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+void AbstractFileListing::processPendingChanges()
+{
+    d->mPendingChangesAge.invalidate();
 
-    ex->extract(&result);
+    const auto changedPaths = d->mPendingChangedPaths;
+    const auto changedDirectories = d->mPendingChangedDirectories;
 
-    const auto &allProperties = result.properties();
+    d->mPendingChangedPaths.clear();
+    d->mPendingChangedDirectories.clear();
 
-    auto titleProperty = allProperties.find(KFileMetaData::Property::Title);
-    auto durationProperty = allProperties.find(KFileMetaData::Property::Duration);
-    auto artistProperty = allProperties.find(KFileMetaData::Property::Artist);
-    auto albumProperty = allProperties.find(KFileMetaData::Property::Album);
-    auto albumArtistProperty = allProperties.find(KFileMetaData::Property::AlbumArtist);
-    auto trackNumberProperty = allProperties.find(KFileMetaData::Property::TrackNumber);
-    auto fileData = KFileMetaData::UserMetaData(scanFile.toLocalFile());
+    auto allRemovedFiles = QList<QUrl>();
+    auto newFiles = QList<QPair<QUrl, QUrl>>();
+    auto changedFiles = QList<QUrl>();
 
-    if (albumProperty != allProperties.end()) {
-        auto albumValue = albumProperty->toString();
+    for (const auto &oneChangedPath : changedPaths) {
+        QFileInfo changedPathInfo(oneChangedPath.toLocalFile());
+        const auto &parentDirectory = QUrl::fromLocalFile(changedPathInfo.absolutePath());
+        const auto isKnownFile = fileExists(oneChangedPath, parentDirectory);
 
-        newTrack.setAlbumName(albumValue);
+        invalidateCovers(changedPathInfo.absolutePath());
+        invalidateCovers(changedPathInfo.absoluteFilePath());
 
-        if (artistProperty != allProperties.end()) {
-            newTrack.setArtist(artistProperty->toString());
+        if (!changedPathInfo.exists()) {
+            if (isKnownFile || d->mDiscoveredFiles.containsDirectory(oneChangedPath)) {
+                removeKnownPath(oneChangedPath, allRemovedFiles);
+            }
+            continue;
         }
 
-        if (durationProperty != allProperties.end()) {
-            newTrack.setDuration(QTime::fromMSecsSinceStartOfDay(1000 * durationProperty->toDouble()));
+        if (changedPathInfo.isDir()) {
+            scanDirectory(newFiles, allRemovedFiles, oneChangedPath);
+        } else if (isKnownFile) {
+            changedFiles.push_back(oneChangedPath);
+        } else if (changedPathInfo.isFile() && d->mDiscoveredFiles.containsDirectory(parentDirectory)) {
+            newFiles.push_back({oneChangedPath, parentDirectory});
         }
+    }
 
-        if (titleProperty != allProperties.end()) {
-            newTrack.setTitle(titleProperty->toString());
-        }
+    for (const auto &oneChangedDirectory : changedDirectories) {
+        invalidateCovers(oneChangedDirectory.toLocalFile());
 
-        if (trackNumberProperty != allProperties.end()) {
-            newTrack.setTrackNumber(trackNumberProperty->toInt());
+        if (d->mDiscoveredFiles.containsDirectory(oneChangedDirectory)) {
+            scanDirectory(newFiles, allRemovedFiles, oneChangedDirectory);
         }
+    }
 
-        if (albumArtistProperty != allProperties.end()) {
-            newTrack.setAlbumArtist(albumArtistProperty->toString());
-        }
+    if (!allRemovedFiles.isEmpty()) {
+        Q_EMIT removedTracksList(allRemovedFiles);
+    }
 
-        if (newTrack.albumArtist().isEmpty()) {
-            newTrack.setAlbumArtist(newTrack.artist());
+    auto uniqueNewFiles = QList<QPair<QUrl, QUrl>>();
+    auto knownNewFiles = QSet<QUrl>();
+    for (const auto &oneNewFile : newFiles) {
+        if (!knownNewFiles.contains(oneNewFile.first)) {
+            knownNewFiles.insert(oneNewFile.first);
+            uniqueNewFiles.push_back(oneNewFile);
         }
+    }
 
-        if (newTrack.artist().isEmpty()) {
-            newTrack.setArtist(newTrack.albumArtist());
-        }
+    extractNewFiles(uniqueNewFiles);
 
-        newTrack.setResourceURI(scanFile);
+    const auto &modifiedTracks = extractModifiedFiles(changedFiles);
 
-        newTrack.setRating(fileData.rating());
+    if (!modifiedTracks.isEmpty()) {
+        Q_EMIT modifyTracksList(modifiedTracks, d->mAllAlbumCover);
+    }
+}
+
+void AbstractFileListing::removeKnownPath(const QUrl &removedPath, QList<QUrl> &allRemovedFiles)
+{
+    const auto &parentDirectory = QUrl::fromLocalFile(QFileInfo(removedPath.toLocalFile()).absolutePath());
 
-        newTrack.setValid(true);
+    d->mDiscoveredFiles.removeEntry(parentDirectory, removedPath);
+
+    if (d->mDiscoveredFiles.containsDirectory(removedPath)) {
+        d->mDirectoryWatcher->removeDirectoryTree(removedPath.toLocalFile());
+    }
+
+    removeFile(removedPath, allRemovedFiles);
+}
+
+void AbstractFileListing::fileChanged(const QString &modifiedFileName)
+{
+    d->mPendingChangedPaths.insert(QUrl::fromLocalFile(modifiedFileName));
+    schedulePendingChanges();
+}
+
+void AbstractFileListing::executeInit()
+{
+}
+
+void AbstractFileListing::triggerRefreshOfContent()
+{
+}
+
+void AbstractFileListing::refreshContent()
+{
+    if (d->mScanScheduler) {
+        d->mScanGeneration = d->mScanScheduler->scanStarted();
+    }
+    if (d->mScanProgress) {
+        d->mScanProgress->scanStarted();
+    }
+
+    d->mScanRunning = true;
+
+    triggerRefreshOfContent();
+
+    d->mScanRunning = false;
+
+    if (d->mScanProgress) {
+        d->mScanProgress->scanFinished();
+    }
+    if (d->mScanScheduler) {
+        d->mScanScheduler->scanFinished();
+    }
+}
+
+MusicAudioTrack AbstractFileListing::scanOneFile(QUrl scanFile)
+{
+    auto isMusicFile = false;
+    auto newTrack = extractTrackFromFile(scanFile, isMusicFile);
+
+    if (isMusicFile && QFileInfo::exists(scanFile.toLocalFile())) {
+        watchFile(scanFile.toLocalFile());
     }
 
     return newTrack;
@@ -287,55 +951,117 @@ void AbstractFileListing::watchPath(const QString &pathName)
     d->mFileSystemWatcher.addPath(pathName);
 }
 
+bool AbstractFileListing::useDirectoryWatcher() const
+{
+    return d->mHandleNewFiles && d->mDirectoryWatcher->isValid();
+}
+
+void AbstractFileListing::watchDirectory(const QString &pathName)
+{
+    if (useDirectoryWatcher() && d->mDirectoryWatcher->addDirectory(pathName)) {
+        return;
+    }
+
+    watchPath(pathName);
+}
+
+void AbstractFileListing::watchFile(const QString &pathName)
+{
+    if (useDirectoryWatcher()) {
+        return;
+    }
+
+    watchPath(pathName);
+}
+
 void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName)
 {
-    const auto directoryEntry = d->mDiscoveredFiles.find(directoryName);
-    if (directoryEntry == d->mDiscoveredFiles.end()) {
-        watchPath(directoryName.toLocalFile());
+    if (!d->mDiscoveredFiles.containsDirectory(directoryName)) {
+        watchDirectory(directoryName.toLocalFile());
 
         QDir currentDirectory(directoryName.toLocalFile());
         if (currentDirectory.cdUp()) {
             const auto parentDirectoryName = currentDirectory.absolutePath();
             const auto parentDirectory = QUrl::fromLocalFile(parentDirectoryName);
-            const auto parentDirectoryEntry = d->mDiscoveredFiles.find(parentDirectory);
-            if (parentDirectoryEntry == d->mDiscoveredFiles.end()) {
-                watchPath(parentDirectoryName);
+            if (!d->mDiscoveredFiles.containsDirectory(parentDirectory)) {
+                watchDirectory(parentDirectoryName);
             }
 
-            auto &parentCurrentDirectoryListingFiles = d->mDiscoveredFiles[parentDirectory];
-
-            parentCurrentDirectoryListingFiles.insert(directoryName);
+            d->mDiscoveredFiles.addEntry(parentDirectory, directoryName);
         }
     }
-    auto &currentDirectoryListingFiles = d->mDiscoveredFiles[directoryName];
 
-    currentDirectoryListingFiles.insert(newFile);
+    d->mDiscoveredFiles.addEntry(directoryName, newFile);
 }
 
 void AbstractFileListing::scanDirectoryTree(const QString &path)
 {
-    auto newFiles = QList<MusicAudioTrack>();
+    auto newFiles = QList<QPair<QUrl, QUrl>>();
+    auto removedFiles = QList<QUrl>();
+
+    d->mCoverResolver.clear();
+    d->mAllAlbumCover.clear();
+    d->mDirectoryAlbumCovers.clear();
+
+    QFileInfo rootDirectory(path);
+
+    const auto sweepRestoredFiles = d->mSweepRestoredFiles && d->mHandleNewFiles && rootDirectory.isDir();
 
-    scanDirectory(newFiles, QUrl::fromLocalFile(path));
+    if (sweepRestoredFiles) {
+        d->mSweepRestoredFiles = false;
+        d->mSweepingRestoredFiles = true;
 
-    if (!newFiles.isEmpty()) {
-        emitNewFiles(newFiles);
+        Q_EMIT sourceScanStarted(d->mSourceName);
     }
-}
 
-bool AbstractFileListing::fileExists(const QUrl &fileName, const QUrl &directoryName) const
-{
-    const auto directoryEntry = d->mDiscoveredFiles.find(directoryName);
-    if (directoryEntry == d->mDiscoveredFiles.end()) {
-        return false;
+    auto newTracks = QList<MusicAudioTrack>();
+
+    {
+        FileExtractionQueue extractionQueue(d->mExtractionPool, d->mScanScheduler, [&](int currentFile, const MusicAudioTrack &newTrack, bool isMusicFile) {
+            return handleNewTrack(newFiles[currentFile], newTrack, isMusicFile, newTracks);
+        });
+
+        scanDirectory(newFiles, removedFiles, QUrl::fromLocalFile(rootDirectory.exists() ? rootDirectory.canonicalFilePath() : path), true,
+                      [&extractionQueue](const QList<QPair<QUrl, QUrl>> &directoryNewFiles) {
+            for (const auto &oneNewFile : directoryNewFiles) {
+                extractionQueue.addFile(oneNewFile.first);
+            }
+
+            extractionQueue.handleExtractedTracks(false);
+        });
+
+        d->mSweepingRestoredFiles = false;
+
+        if (!removedFiles.isEmpty()) {
+            Q_EMIT removedTracksList(removedFiles);
+        }
+
+        if (sweepRestoredFiles) {
+            Q_EMIT seenTracksList(d->mSeenRestoredFiles, d->mSeenDirectories, d->mSourceName);
+        }
+        d->mSeenRestoredFiles.clear();
+        d->mSeenDirectories.clear();
+
+        extractionQueue.handleExtractedTracks(true);
     }
 
-    const auto fileEntry = directoryEntry->find(fileName);
-    if (fileEntry == directoryEntry->end()) {
-        return false;
+    if (!newTracks.isEmpty()) {
+        emitNewFiles(newTracks);
     }
 
-    return true;
+    if (!sweepRestoredFiles || QThread::currentThread()->isInterruptionRequested() ||
+            (d->mScanScheduler && d->mScanScheduler->isCancelled(d->mScanGeneration))) {
+        return;
+    }
+
+    d->mRestoredFiles.clear();
+
+    Q_EMIT sourceScanFinished(d->mSourceName);
+}
+
+bool AbstractFileListing::fileExists(const QUrl &fileName, const QUrl &directoryName) const
+{
+    return d->mDiscoveredFiles.containsEntry(directoryName, fileName);
 }
 
 void AbstractFileListing::setHandleNewFiles(bool handleThem)
@@ -345,9 +1071,74 @@ void AbstractFileListing::setHandleNewFiles(bool handleThem)
 
 void AbstractFileListing::emitNewFiles(const QList<MusicAudioTrack> &tracks)
 {
+    if (!waitForPendingTracksLists()) {
+        return;
+    }
+
+    if (d->mScanProgress) {
+        QMutexLocker locker(&d->mPendingTracksListsMutex);
+
+        d->mPendingTracksListsSizes.enqueue(tracks.size());
+    }
+
     Q_EMIT tracksList(tracks, d->mAllAlbumCover, d->mSourceName);
 }
 
+bool AbstractFileListing::waitForScanTurn()
+{
+    if (!d->mScanScheduler || !d->mScanRunning) {
+        return true;
+    }
+
+    return d->mScanScheduler->waitForScanTurn(d->mScanGeneration);
+}
+
+QUrl AbstractFileListing::takeNextDirectory(QList<QUrl> &pendingDirectories) const
+{
+    if (!d->mScanScheduler) {
+        return pendingDirectories.takeLast();
+    }
+
+    const auto priorityGeneration = d->mScanScheduler->priorityGeneration();
+    if (priorityGeneration != d->mPriorityGeneration) {
+        d->mPriorityGeneration = priorityGeneration;
+        d->mPriorityDirectories = d->mScanScheduler->priorityDirectories();
+    }
+
+    if (d->mPriorityDirectories.isEmpty()) {
+        return pendingDirectories.takeLast();
+    }
+
+    for (int i = pendingDirectories.size() - 1; i >= 0; --i) {
+        if (ScanScheduler::isPriorityPath(pendingDirectories[i].toLocalFile(), d->mPriorityDirectories)) {
+            return pendingDirectories.takeAt(i);
+        }
+    }
+
+    return pendingDirectories.takeLast();
+}
+
+bool AbstractFileListing::waitForPendingTracksLists()
+{
+    QMutexLocker locker(&d->mPendingTracksListsMutex);
+
+    if (d->mMaximumPendingTracksLists <= 0) {
+        return true;
+    }
+
+    while (d->mMaximumPendingTracksLists > 0 && d->mPendingTracksLists >= d->mMaximumPendingTracksLists) {
+        if (QThread::currentThread()->isInterruptionRequested()) {
+            return false;
+        }
+
+        d->mTracksListInserted.wait(&d->mPendingTracksListsMutex, 100);
+    }
+
+    ++d->mPendingTracksLists;
+
+    return true;
+}
+
 void AbstractFileListing::addCover(const MusicAudioTrack &newTrack)
 {
     auto itCover = d->mAllAlbumCover.find(newTrack.albumName());
@@ -355,35 +1146,53 @@ void AbstractFileListing::addCover(const MusicAudioTrack &newTrack)
         return;
     }
 
-    QFileInfo trackFilePath(newTrack.resourceURI().toLocalFile());
-    QFileInfo coverFilePath(trackFilePath.dir().filePath(QStringLiteral("cover.jpg")));
+    const auto &coverUrl = d->mCoverResolver.coverForTrack(newTrack.resourceURI(), newTrack.albumName());
 
-    if (coverFilePath.exists()) {
-        d->mAllAlbumCover[newTrack.albumName()] = QUrl::fromLocalFile(coverFilePath.absoluteFilePath());
+    if (!coverUrl.isEmpty()) {
+        d->mAllAlbumCover[newTrack.albumName()] = coverUrl;
+        d->mDirectoryAlbumCovers[QFileInfo(newTrack.resourceURI().toLocalFile()).absolutePath()].push_back(newTrack.albumName());
     }
 }
 
-void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
+void AbstractFileListing::invalidateCovers(const QString &directoryPath)
 {
-    auto itRemovedDirectory = d->mDiscoveredFiles.find(removedDirectory);
+    d->mCoverResolver.invalidateDirectory(directoryPath);
 
-    if (itRemovedDirectory == d->mDiscoveredFiles.end()) {
+    const auto &albumNames = d->mDirectoryAlbumCovers.take(directoryPath);
+    for (const auto &oneAlbumName : albumNames) {
+        d->mAllAlbumCover.remove(oneAlbumName);
+    }
+}
+
+void AbstractFileListing::albumCoversListed(const QString &musicSource, const QList<QUrl> &albumCovers)
+{
+    if (musicSource != d->mSourceName) {
         return;
     }
 
-    for (auto itFile : *itRemovedDirectory) {
-        if (itFile.isValid() && !itFile.isEmpty()) {
-            removeFile(itFile, allRemovedFiles);
-        }
+    d->mCoverResolver.pruneCache(albumCovers);
+}
+
+void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
+{
+    if (!d->mDiscoveredFiles.containsDirectory(removedDirectory)) {
+        return;
     }
 
-    d->mDiscoveredFiles.erase(itRemovedDirectory);
+    const auto &removedEntries = d->mDiscoveredFiles.entries(removedDirectory);
+
+    d->mDiscoveredFiles.removeDirectory(removedDirectory);
+
+    for (const auto &oneFile : removedEntries) {
+        if (oneFile.isValid() && !oneFile.isEmpty()) {
+            removeFile(oneFile, allRemovedFiles);
+        }
+    }
 }
 
 void AbstractFileListing::removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles)
 {
-    auto itRemovedDirectory = d->mDiscoveredFiles.find(oneRemovedTrack);
-    if (itRemovedDirectory != d->mDiscoveredFiles.end()) {
+    if (d->mDiscoveredFiles.containsDirectory(oneRemovedTrack)) {
         removeDirectory(oneRemovedTrack, allRemovedFiles);
     }
 
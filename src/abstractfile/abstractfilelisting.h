@@ -23,13 +23,19 @@
 #include <QObject>
 #include <QString>
 #include <QUrl>
+#include <QDateTime>
 #include <QHash>
+#include <QList>
+#include <QPair>
 #include <QVector>
 
 #include <memory>
+#include <functional>
 
 class AbstractFileListingPrivate;
 class MusicAudioTrack;
+class ScanProgress;
+class ScanScheduler;
 
 class AbstractFileListing : public QObject
 {
@@ -42,6 +48,30 @@ public:
 
     virtual ~AbstractFileListing();
 
+    int extractionThreadsCount() const;
+
+    void setExtractionThreadsCount(int threadsCount);
+
+    int tracksListBatchSize() const;
+
+    void setTracksListBatchSize(int batchSize);
+
+    int maximumPendingTracksLists() const;
+
+    void setMaximumPendingTracksLists(int pendingCount);
+
+    ScanProgress* scanProgress() const;
+
+    void setScanProgress(ScanProgress *scanProgress);
+
+    ScanScheduler* scanScheduler() const;
+
+    void setScanScheduler(ScanScheduler *scanScheduler);
+
+    int changesQuietWindow() const;
+
+    void setChangesQuietWindow(int quietWindow);
+
 Q_SIGNALS:
 
     void tracksList(QList<MusicAudioTrack> tracks, const QHash<QString, QUrl> &covers, QString musicSource);
@@ -50,6 +80,14 @@ Q_SIGNALS:
 
     void modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers);
 
+    void askRestoredTracks(const QString &musicSource);
+
+    void sourceScanStarted(const QString &musicSource);
+
+    void seenTracksList(const QList<QUrl> &seenTracks, const QHash<QUrl, QDateTime> &seenDirectories, const QString &musicSource);
+
+    void sourceScanFinished(const QString &musicSource);
+
 public Q_SLOTS:
 
     void refreshContent();
@@ -60,19 +98,35 @@ public Q_SLOTS:
 
     void newTrackFile(MusicAudioTrack partialTrack);
 
+    void tracksListInserted(const QString &musicSource);
+
+    void restoredTracks(const QString &musicSource, const QList<MusicAudioTrack> &restoredFiles);
+
+    void albumCoversListed(const QString &musicSource, const QList<QUrl> &albumCovers);
+
 protected Q_SLOTS:
 
     void directoryChanged(const QString &path);
 
     void fileChanged(const QString &modifiedFileName);
 
+    void directoryChangesDetected(const QList<QUrl> &addedPaths, const QList<QUrl> &modifiedFiles,
+                                  const QList<QPair<QUrl, QUrl>> &movedPaths, const QList<QUrl> &removedPaths);
+
+    void processPendingChanges();
+
 protected:
 
     virtual void executeInit();
 
     virtual void triggerRefreshOfContent();
 
-    void scanDirectory(QList<MusicAudioTrack> &newFiles, const QUrl &path, bool recursive = true);
+    void scanDirectory(QList<QPair<QUrl, QUrl>> &newFiles, QList<QUrl> &removedFiles, const QUrl &path, bool recursive = true,
+                       const std::function<void(const QList<QPair<QUrl, QUrl>>&)> &directoryScanned = {});
+
+    void extractNewFiles(const QList<QPair<QUrl, QUrl>> &newFiles);
+
+    QList<MusicAudioTrack> extractModifiedFiles(const QList<QUrl> &modifiedFiles);
 
     const QString &sourceName() const;
 
@@ -90,14 +144,35 @@ protected:
 
     void emitNewFiles(const QList<MusicAudioTrack> &tracks);
 
+    bool waitForScanTurn();
+
     void addCover(const MusicAudioTrack &newTrack);
 
+    void invalidateCovers(const QString &directoryPath);
+
     void removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles);
 
     void removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles);
 
 private:
 
+    bool waitForPendingTracksLists();
+
+    QUrl takeNextDirectory(QList<QUrl> &pendingDirectories) const;
+
+    bool useDirectoryWatcher() const;
+
+    void watchDirectory(const QString &pathName);
+
+    void watchFile(const QString &pathName);
+
+    void removeKnownPath(const QUrl &removedPath, QList<QUrl> &allRemovedFiles);
+
+    bool handleNewTrack(const QPair<QUrl, QUrl> &newFile, const MusicAudioTrack &newTrack, bool isMusicFile,
+                        QList<MusicAudioTrack> &newTracks);
+
+    void schedulePendingChanges();
+
     std::unique_ptr<AbstractFileListingPrivate> d;
 
 };
@@ -0,0 +1,466 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "coverresolver.h"
+#include "tagcontainerreader.h"
+
+#include <QHash>
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QStringList>
+#include <QSet>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QImage>
+
+#include <QDebug>
+
+static const qint64 MaximumPictureSize = 32 * 1024 * 1024;
+
+static const int MaximumCoverSize = 512;
+
+static const int FrontCoverPictureType = 3;
+
+class CoverResolverPrivate
+{
+public:
+
+    QUrl storeEmbeddedPicture(const QByteArray &picture) const;
+
+    QString mCacheDirectory;
+
+    QHash<QString, QUrl> mDirectoryCovers;
+
+    QHash<QString, QHash<QString, QUrl>> mEmbeddedCovers;
+
+    QDateTime mCreationTime = QDateTime::currentDateTime();
+
+};
+
+static QByteArray pictureFromFlacPictureBlock(const QByteArray &block, int &pictureType)
+{
+    qint64 offset = 0;
+
+    auto readField = [&block, &offset](quint32 &value) {
+        if (offset + 4 > block.size()) {
+            return false;
+        }
+
+        value = TagContainerReader::readBigEndian32(block.constData() + offset);
+        offset += 4;
+
+        return true;
+    };
+
+    quint32 fieldValue = 0;
+
+    if (!readField(fieldValue)) {
+        return {};
+    }
+    pictureType = static_cast<int>(fieldValue);
+
+    if (!readField(fieldValue)) {
+        return {};
+    }
+    offset += fieldValue;
+
+    if (!readField(fieldValue)) {
+        return {};
+    }
+    offset += fieldValue + 16;
+
+    if (!readField(fieldValue) || offset + fieldValue > block.size()) {
+        return {};
+    }
+
+    return block.mid(static_cast<int>(offset), static_cast<int>(fieldValue));
+}
+
+static QByteArray pictureFromApicFrame(const QByteArray &frame, bool isVersion2, int &pictureType)
+{
+    if (frame.size() < 4) {
+        return {};
+    }
+
+    const auto textEncoding = uchar(frame[0]);
+    auto offset = 1;
+
+    if (isVersion2) {
+        offset += 3;
+    } else {
+        const auto mimeTypeEnd = frame.indexOf('\0', offset);
+        if (mimeTypeEnd == -1) {
+            return {};
+        }
+        offset = mimeTypeEnd + 1;
+    }
+
+    if (offset >= frame.size()) {
+        return {};
+    }
+
+    pictureType = uchar(frame[offset]);
+    ++offset;
+
+    if (textEncoding == 1 || textEncoding == 2) {
+        while (offset + 1 < frame.size() && (frame[offset] != '\0' || frame[offset + 1] != '\0')) {
+            offset += 2;
+        }
+        offset += 2;
+    } else {
+        const auto descriptionEnd = frame.indexOf('\0', offset);
+        if (descriptionEnd == -1) {
+            return {};
+        }
+        offset = descriptionEnd + 1;
+    }
+
+    if (offset >= frame.size()) {
+        return {};
+    }
+
+    return frame.mid(offset);
+}
+
+static QByteArray pictureFromId3v2(QFile &musicFile)
+{
+    auto frontCover = QByteArray();
+    auto firstPicture = QByteArray();
+
+    TagContainerReader::readId3v2Frames(musicFile, MaximumPictureSize,
+                                        [](const QByteArray &frameId) {
+        return frameId == "APIC" || frameId == "PIC";
+    },
+                                        [&frontCover, &firstPicture](const QByteArray &frameId, const QByteArray &frameData, int majorVersion) {
+        Q_UNUSED(frameId);
+
+        auto pictureType = -1;
+        const auto &picture = pictureFromApicFrame(frameData, majorVersion == 2, pictureType);
+
+        if (!picture.isEmpty() && pictureType == FrontCoverPictureType) {
+            frontCover = picture;
+            return false;
+        }
+
+        if (firstPicture.isEmpty()) {
+            firstPicture = picture;
+        }
+
+        return true;
+    });
+
+    return frontCover.isEmpty() ? firstPicture : frontCover;
+}
+
+static QByteArray pictureFromFlac(QFile &musicFile)
+{
+    auto frontCover = QByteArray();
+    auto firstPicture = QByteArray();
+
+    TagContainerReader::readFlacBlocks(musicFile, 0, MaximumPictureSize,
+                                       [](int blockType) {
+        return blockType == 6;
+    },
+                                       [&frontCover, &firstPicture](int blockType, const QByteArray &blockData) {
+        Q_UNUSED(blockType);
+
+        auto pictureType = -1;
+        const auto &picture = pictureFromFlacPictureBlock(blockData, pictureType);
+
+        if (!picture.isEmpty() && pictureType == FrontCoverPictureType) {
+            frontCover = picture;
+            return false;
+        }
+
+        if (firstPicture.isEmpty()) {
+            firstPicture = picture;
+        }
+
+        return true;
+    });
+
+    return frontCover.isEmpty() ? firstPicture : frontCover;
+}
+
+static QByteArray pictureFromOgg(QFile &musicFile)
+{
+    auto identificationPacket = QByteArray();
+    auto commentPacket = QByteArray();
+    auto streamSerial = quint32(0);
+
+    if (!TagContainerReader::readOggHeaderPackets(musicFile, MaximumPictureSize, identificationPacket, commentPacket, streamSerial)) {
+        return {};
+    }
+
+    qint64 offset = 0;
+    if (commentPacket.startsWith("\x03vorbis")) {
+        offset = 7;
+    } else if (commentPacket.startsWith("OpusTags")) {
+        offset = 8;
+    } else {
+        return {};
+    }
+
+    const auto &pictureKey = QByteArray("METADATA_BLOCK_PICTURE=");
+    auto frontCover = QByteArray();
+    auto firstPicture = QByteArray();
+
+    TagContainerReader::readVorbisComments(commentPacket.constData() + offset, commentPacket.size() - offset,
+                                           [&pictureKey, &frontCover, &firstPicture](const QByteArray &comment) {
+        if (comment.left(pictureKey.size()).toUpper() != pictureKey) {
+            return true;
+        }
+
+        auto pictureType = -1;
+        const auto &picture = pictureFromFlacPictureBlock(QByteArray::fromBase64(comment.mid(pictureKey.size())), pictureType);
+
+        if (!picture.isEmpty() && pictureType == FrontCoverPictureType) {
+            frontCover = picture;
+            return false;
+        }
+
+        if (firstPicture.isEmpty()) {
+            firstPicture = picture;
+        }
+
+        return true;
+    });
+
+    return frontCover.isEmpty() ? firstPicture : frontCover;
+}
+
+static QByteArray pictureFromMp4(QFile &musicFile)
+{
+    qint64 atomStart = 0;
+    qint64 atomEnd = 0;
+
+    if (!TagContainerReader::findMp4AtomPath(musicFile, 0, musicFile.size(), {"moov", "udta", "meta", "ilst", "covr", "data"}, atomStart, atomEnd)) {
+        return {};
+    }
+
+    if (atomEnd - atomStart <= 8 || atomEnd - atomStart > MaximumPictureSize || !musicFile.seek(atomStart + 8)) {
+        return {};
+    }
+
+    return musicFile.read(atomEnd - atomStart - 8);
+}
+
+static QUrl coverFileInDirectory(const QString &directoryPath)
+{
+    static const auto coverFileNames = QStringList({QStringLiteral("cover.jpg"), QStringLiteral("cover.jpeg"), QStringLiteral("cover.png"),
+                                                    QStringLiteral("folder.jpg"), QStringLiteral("folder.jpeg"), QStringLiteral("folder.png"),
+                                                    QStringLiteral("front.jpg"), QStringLiteral("front.jpeg"), QStringLiteral("front.png"),
+                                                    QStringLiteral("album.jpg"), QStringLiteral("album.jpeg"), QStringLiteral("album.png"),
+                                                    QStringLiteral("albumart.jpg"), QStringLiteral("albumart.png")});
+
+    QDir directory(directoryPath);
+
+    const auto &imageFiles = directory.entryList({QStringLiteral("*.jpg"), QStringLiteral("*.jpeg"), QStringLiteral("*.png")},
+                                                 QDir::Files | QDir::Readable);
+
+    auto bestPriority = coverFileNames.size();
+    auto bestFileName = QString();
+
+    for (const auto &oneFileName : imageFiles) {
+        const auto priority = coverFileNames.indexOf(oneFileName.toLower());
+
+        if (priority != -1 && priority < bestPriority) {
+            bestPriority = priority;
+            bestFileName = oneFileName;
+        }
+    }
+
+    if (bestFileName.isEmpty()) {
+        return {};
+    }
+
+    return QUrl::fromLocalFile(directory.absoluteFilePath(bestFileName));
+}
+
+QUrl CoverResolverPrivate::storeEmbeddedPicture(const QByteArray &picture) const
+{
+    if (picture.isEmpty() || mCacheDirectory.isEmpty()) {
+        return {};
+    }
+
+    QDir cacheDirectory(mCacheDirectory);
+
+    const auto &pictureHash = QString::fromLatin1(QCryptographicHash::hash(picture, QCryptographicHash::Sha1).toHex());
+    const auto &jpegCoverPath = cacheDirectory.filePath(pictureHash + QStringLiteral(".jpg"));
+    const auto &pngCoverPath = cacheDirectory.filePath(pictureHash + QStringLiteral(".png"));
+
+    if (QFileInfo::exists(jpegCoverPath)) {
+        return QUrl::fromLocalFile(jpegCoverPath);
+    }
+    if (QFileInfo::exists(pngCoverPath)) {
+        return QUrl::fromLocalFile(pngCoverPath);
+    }
+
+    auto coverImage = QImage();
+    if (!coverImage.loadFromData(picture)) {
+        return {};
+    }
+
+    if (!QDir().mkpath(mCacheDirectory)) {
+        qDebug() << "CoverResolver::storeEmbeddedPicture" << mCacheDirectory << "cannot be created";
+        return {};
+    }
+
+    const auto isTooLarge = coverImage.width() > MaximumCoverSize || coverImage.height() > MaximumCoverSize;
+    const auto isJpeg = picture.startsWith("\xff\xd8");
+
+    QSaveFile coverFile(isJpeg ? jpegCoverPath : pngCoverPath);
+    if (!coverFile.open(QIODevice::WriteOnly)) {
+        return {};
+    }
+
+    if (isTooLarge) {
+        coverImage.scaled(MaximumCoverSize, MaximumCoverSize, Qt::KeepAspectRatio, Qt::SmoothTransformation).save(&coverFile, isJpeg ? "JPG" : "PNG", isJpeg ? 90 : -1);
+    } else if (isJpeg) {
+        coverFile.write(picture);
+    } else {
+        coverImage.save(&coverFile, "PNG");
+    }
+
+    if (!coverFile.commit()) {
+        qDebug() << "CoverResolver::storeEmbeddedPicture" << coverFile.fileName() << coverFile.errorString();
+        return {};
+    }
+
+    return QUrl::fromLocalFile(coverFile.fileName());
+}
+
+CoverResolver::CoverResolver(const QString &cacheDirectory) : d(new CoverResolverPrivate)
+{
+    d->mCacheDirectory = cacheDirectory;
+
+    if (d->mCacheDirectory.isEmpty()) {
+        d->mCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/covers");
+    }
+}
+
+CoverResolver::~CoverResolver()
+{
+}
+
+const QString &CoverResolver::cacheDirectory() const
+{
+    return d->mCacheDirectory;
+}
+
+QUrl CoverResolver::coverForTrack(const QUrl &trackFile, const QString &albumName)
+{
+    QFileInfo trackFileInfo(trackFile.toLocalFile());
+    const auto &directoryPath = trackFileInfo.absolutePath();
+
+    auto itDirectoryCover = d->mDirectoryCovers.find(directoryPath);
+    if (itDirectoryCover == d->mDirectoryCovers.end()) {
+        itDirectoryCover = d->mDirectoryCovers.insert(directoryPath, coverFileInDirectory(directoryPath));
+    }
+
+    if (!itDirectoryCover->isEmpty()) {
+        return *itDirectoryCover;
+    }
+
+    auto &directoryEmbeddedCovers = d->mEmbeddedCovers[directoryPath];
+
+    auto itEmbeddedCover = directoryEmbeddedCovers.find(albumName);
+    if (itEmbeddedCover == directoryEmbeddedCovers.end()) {
+        itEmbeddedCover = directoryEmbeddedCovers.insert(albumName, d->storeEmbeddedPicture(embeddedPicture(trackFileInfo.absoluteFilePath())));
+    }
+
+    return *itEmbeddedCover;
+}
+
+void CoverResolver::invalidateDirectory(const QString &directoryPath)
+{
+    d->mDirectoryCovers.remove(directoryPath);
+    d->mEmbeddedCovers.remove(directoryPath);
+}
+
+void CoverResolver::clear()
+{
+    d->mDirectoryCovers.clear();
+    d->mEmbeddedCovers.clear();
+}
+
+void CoverResolver::pruneCache(const QList<QUrl> &usedCovers)
+{
+    QDir cacheDirectory(d->mCacheDirectory);
+
+    if (d->mCacheDirectory.isEmpty() || !cacheDirectory.exists()) {
+        return;
+    }
+
+    auto keptFiles = QSet<QString>();
+
+    for (const auto &oneCover : usedCovers) {
+        if (oneCover.isLocalFile()) {
+            keptFiles.insert(QFileInfo(oneCover.toLocalFile()).absoluteFilePath());
+        }
+    }
+
+    for (const auto &oneDirectoryCovers : d->mEmbeddedCovers) {
+        for (const auto &oneCover : oneDirectoryCovers) {
+            if (oneCover.isLocalFile()) {
+                keptFiles.insert(QFileInfo(oneCover.toLocalFile()).absoluteFilePath());
+            }
+        }
+    }
+
+    const auto &cachedFiles = cacheDirectory.entryInfoList(QDir::Files);
+    for (const auto &oneCachedFile : cachedFiles) {
+        if (keptFiles.contains(oneCachedFile.absoluteFilePath()) || oneCachedFile.lastModified() >= d->mCreationTime) {
+            continue;
+        }
+
+        if (!QFile::remove(oneCachedFile.absoluteFilePath())) {
+            qDebug() << "CoverResolver::pruneCache" << oneCachedFile.absoluteFilePath() << "cannot be removed";
+        }
+    }
+}
+
+QByteArray CoverResolver::embeddedPicture(const QString &fileName)
+{
+    QFile musicFile(fileName);
+
+    if (!musicFile.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    const auto &fileMagic = musicFile.peek(8);
+
+    if (fileMagic.startsWith("ID3")) {
+        return pictureFromId3v2(musicFile);
+    }
+    if (fileMagic.startsWith("fLaC")) {
+        return pictureFromFlac(musicFile);
+    }
+    if (fileMagic.startsWith("OggS")) {
+        return pictureFromOgg(musicFile);
+    }
+    if (fileMagic.mid(4) == "ftyp") {
+        return pictureFromMp4(musicFile);
+    }
+
+    return {};
+}
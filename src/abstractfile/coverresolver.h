@@ -0,0 +1,59 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef COVERRESOLVER_H
+#define COVERRESOLVER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QUrl>
+#include <QList>
+
+#include <memory>
+
+class CoverResolverPrivate;
+
+class CoverResolver
+{
+
+public:
+
+    explicit CoverResolver(const QString &cacheDirectory = QString());
+
+    ~CoverResolver();
+
+    const QString &cacheDirectory() const;
+
+    QUrl coverForTrack(const QUrl &trackFile, const QString &albumName);
+
+    void invalidateDirectory(const QString &directoryPath);
+
+    void clear();
+
+    void pruneCache(const QList<QUrl> &usedCovers);
+
+    static QByteArray embeddedPicture(const QString &fileName);
+
+private:
+
+    std::unique_ptr<CoverResolverPrivate> d;
+
+};
+
+#endif // COVERRESOLVER_H
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "directorytree.h"
+
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+class DirectoryTreeNode
+{
+public:
+
+    QString mName;
+
+    int mParentId = -1;
+
+    QHash<QString, int> mChildren;
+
+    QSet<QString> mEntries;
+
+    QSet<QUrl> mForeignEntries;
+
+    bool mListed = false;
+
+};
+
+class DirectoryTreePrivate
+{
+public:
+
+    DirectoryTreePrivate()
+    {
+        mNodes.push_back(DirectoryTreeNode());
+    }
+
+    static QStringList pathComponents(const QUrl &url);
+
+    int findNode(const QUrl &directory) const;
+
+    int findOrCreateNode(const QUrl &directory);
+
+    void pruneNode(int nodeId);
+
+    QString nodePath(int nodeId) const;
+
+    QString internName(const QString &name);
+
+    void releaseNames(int releasedCount);
+
+    bool splitEntry(int nodeId, const QUrl &entry, QString &entryName) const;
+
+    QVector<DirectoryTreeNode> mNodes;
+
+    QVector<int> mFreeNodes;
+
+    QSet<QString> mNames;
+
+    int mListedDirectoriesCount = 0;
+
+    int mReleasedNames = 0;
+
+};
+
+QStringList DirectoryTreePrivate::pathComponents(const QUrl &url)
+{
+    const auto &localPath = url.toLocalFile();
+
+    if (!localPath.startsWith(QStringLiteral("/"))) {
+        return {};
+    }
+
+    return localPath.split(QStringLiteral("/"), QString::SkipEmptyParts);
+}
+
+int DirectoryTreePrivate::findNode(const QUrl &directory) const
+{
+    if (!directory.isLocalFile() || !directory.toLocalFile().startsWith(QStringLiteral("/"))) {
+        return -1;
+    }
+
+    auto nodeId = 0;
+
+    for (const auto &oneComponent : pathComponents(directory)) {
+        const auto &children = mNodes[nodeId].mChildren;
+
+        auto itChild = children.constFind(oneComponent);
+        if (itChild == children.constEnd()) {
+            return -1;
+        }
+
+        nodeId = itChild.value();
+    }
+
+    return nodeId;
+}
+
+int DirectoryTreePrivate::findOrCreateNode(const QUrl &directory)
+{
+    if (!directory.isLocalFile() || !directory.toLocalFile().startsWith(QStringLiteral("/"))) {
+        return -1;
+    }
+
+    auto nodeId = 0;
+
+    for (const auto &oneComponent : pathComponents(directory)) {
+        auto itChild = mNodes[nodeId].mChildren.constFind(oneComponent);
+        if (itChild != mNodes[nodeId].mChildren.constEnd()) {
+            nodeId = itChild.value();
+            continue;
+        }
+
+        auto childId = int(0);
+        if (!mFreeNodes.isEmpty()) {
+            childId = mFreeNodes.takeLast();
+        } else {
+            childId = mNodes.size();
+            mNodes.push_back(DirectoryTreeNode());
+        }
+
+        const auto &childName = internName(oneComponent);
+
+        mNodes[childId].mName = childName;
+        mNodes[childId].mParentId = nodeId;
+        mNodes[nodeId].mChildren.insert(childName, childId);
+
+        nodeId = childId;
+    }
+
+    return nodeId;
+}
+
+void DirectoryTreePrivate::pruneNode(int nodeId)
+{
+    while (nodeId > 0) {
+        auto &currentNode = mNodes[nodeId];
+
+        if (currentNode.mListed || !currentNode.mChildren.isEmpty() ||
+                !currentNode.mEntries.isEmpty() || !currentNode.mForeignEntries.isEmpty()) {
+            return;
+        }
+
+        const auto parentId = currentNode.mParentId;
+
+        mNodes[parentId].mChildren.remove(currentNode.mName);
+        mNodes[nodeId] = DirectoryTreeNode();
+        mFreeNodes.push_back(nodeId);
+
+        releaseNames(1);
+
+        nodeId = parentId;
+    }
+}
+
+QString DirectoryTreePrivate::nodePath(int nodeId) const
+{
+    if (nodeId == 0) {
+        return QStringLiteral("/");
+    }
+
+    auto components = QStringList();
+
+    for (; nodeId > 0; nodeId = mNodes[nodeId].mParentId) {
+        components.push_front(mNodes[nodeId].mName);
+    }
+
+    return QStringLiteral("/") + components.join(QStringLiteral("/"));
+}
+
+QString DirectoryTreePrivate::internName(const QString &name)
+{
+    auto itName = mNames.constFind(name);
+    if (itName != mNames.constEnd()) {
+        return *itName;
+    }
+
+    return *mNames.insert(name);
+}
+
+void DirectoryTreePrivate::releaseNames(int releasedCount)
+{
+    mReleasedNames += releasedCount;
+
+    if (mReleasedNames < mNames.size() / 2 + 64) {
+        return;
+    }
+
+    mReleasedNames = 0;
+
+    for (auto itName = mNames.begin(); itName != mNames.end();) {
+        if (itName->isDetached()) {
+            itName = mNames.erase(itName);
+        } else {
+            ++itName;
+        }
+    }
+}
+
+bool DirectoryTreePrivate::splitEntry(int nodeId, const QUrl &entry, QString &entryName) const
+{
+    if (!entry.isLocalFile()) {
+        return false;
+    }
+
+    const auto &entryPath = entry.toLocalFile();
+    const auto &directoryPath = nodePath(nodeId);
+    const auto &directoryPrefix = (nodeId == 0 ? directoryPath : directoryPath + QStringLiteral("/"));
+
+    if (!entryPath.startsWith(directoryPrefix) || entryPath.size() == directoryPrefix.size() ||
+            entryPath.indexOf(QStringLiteral("/"), directoryPrefix.size()) != -1) {
+        return false;
+    }
+
+    entryName = entryPath.mid(directoryPrefix.size());
+
+    return true;
+}
+
+DirectoryTree::DirectoryTree() : d(new DirectoryTreePrivate)
+{
+}
+
+DirectoryTree::~DirectoryTree()
+{
+}
+
+int DirectoryTree::directoryId(const QUrl &directory) const
+{
+    const auto nodeId = d->findNode(directory);
+
+    if (nodeId == -1 || !d->mNodes[nodeId].mListed) {
+        return -1;
+    }
+
+    return nodeId;
+}
+
+QUrl DirectoryTree::directoryUrl(int directoryId) const
+{
+    if (directoryId < 0 || directoryId >= d->mNodes.size() || !d->mNodes[directoryId].mListed) {
+        return {};
+    }
+
+    return QUrl::fromLocalFile(d->nodePath(directoryId));
+}
+
+bool DirectoryTree::containsDirectory(const QUrl &directory) const
+{
+    return directoryId(directory) != -1;
+}
+
+void DirectoryTree::addDirectory(const QUrl &directory)
+{
+    const auto nodeId = d->findOrCreateNode(directory);
+
+    if (nodeId == -1 || d->mNodes[nodeId].mListed) {
+        return;
+    }
+
+    d->mNodes[nodeId].mListed = true;
+    ++d->mListedDirectoriesCount;
+}
+
+void DirectoryTree::removeDirectory(const QUrl &directory)
+{
+    const auto nodeId = directoryId(directory);
+
+    if (nodeId == -1) {
+        return;
+    }
+
+    auto &currentNode = d->mNodes[nodeId];
+    const auto removedEntriesCount = currentNode.mEntries.size();
+
+    currentNode.mListed = false;
+    currentNode.mEntries.clear();
+    currentNode.mForeignEntries.clear();
+    --d->mListedDirectoriesCount;
+
+    d->releaseNames(removedEntriesCount);
+    d->pruneNode(nodeId);
+}
+
+bool DirectoryTree::containsEntry(const QUrl &directory, const QUrl &entry) const
+{
+    const auto nodeId = directoryId(directory);
+
+    if (nodeId == -1) {
+        return false;
+    }
+
+    auto entryName = QString();
+    if (d->splitEntry(nodeId, entry, entryName)) {
+        return d->mNodes[nodeId].mEntries.contains(entryName);
+    }
+
+    return d->mNodes[nodeId].mForeignEntries.contains(entry);
+}
+
+void DirectoryTree::addEntry(const QUrl &directory, const QUrl &entry)
+{
+    addDirectory(directory);
+
+    const auto nodeId = directoryId(directory);
+
+    if (nodeId == -1) {
+        return;
+    }
+
+    auto entryName = QString();
+    if (d->splitEntry(nodeId, entry, entryName)) {
+        if (!d->mNodes[nodeId].mEntries.contains(entryName)) {
+            d->mNodes[nodeId].mEntries.insert(d->internName(entryName));
+        }
+    } else {
+        d->mNodes[nodeId].mForeignEntries.insert(entry);
+    }
+}
+
+void DirectoryTree::removeEntry(const QUrl &directory, const QUrl &entry)
+{
+    const auto nodeId = directoryId(directory);
+
+    if (nodeId == -1) {
+        return;
+    }
+
+    auto entryName = QString();
+    if (d->splitEntry(nodeId, entry, entryName)) {
+        if (d->mNodes[nodeId].mEntries.remove(entryName)) {
+            d->releaseNames(1);
+        }
+    } else {
+        d->mNodes[nodeId].mForeignEntries.remove(entry);
+    }
+}
+
+QSet<QUrl> DirectoryTree::entries(const QUrl &directory) const
+{
+    auto result = QSet<QUrl>();
+
+    const auto nodeId = directoryId(directory);
+
+    if (nodeId == -1) {
+        return result;
+    }
+
+    const auto &currentNode = d->mNodes[nodeId];
+    const auto &directoryPath = d->nodePath(nodeId);
+    const auto &directoryPrefix = (nodeId == 0 ? directoryPath : directoryPath + QStringLiteral("/"));
+
+    result.reserve(currentNode.mEntries.size() + currentNode.mForeignEntries.size());
+
+    for (const auto &oneEntry : currentNode.mEntries) {
+        result.insert(QUrl::fromLocalFile(directoryPrefix + oneEntry));
+    }
+
+    result.unite(currentNode.mForeignEntries);
+
+    return result;
+}
+
+int DirectoryTree::directoriesCount() const
+{
+    return d->mListedDirectoriesCount;
+}
+
+int DirectoryTree::namesCount() const
+{
+    return d->mNames.size();
+}
+
+void DirectoryTree::clear()
+{
+    d.reset(new DirectoryTreePrivate);
+}
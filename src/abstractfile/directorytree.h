@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DIRECTORYTREE_H
+#define DIRECTORYTREE_H
+
+#include <QUrl>
+#include <QSet>
+
+#include <memory>
+
+class DirectoryTreePrivate;
+
+class DirectoryTree
+{
+
+public:
+
+    DirectoryTree();
+
+    ~DirectoryTree();
+
+    int directoryId(const QUrl &directory) const;
+
+    QUrl directoryUrl(int directoryId) const;
+
+    bool containsDirectory(const QUrl &directory) const;
+
+    void addDirectory(const QUrl &directory);
+
+    void removeDirectory(const QUrl &directory);
+
+    bool containsEntry(const QUrl &directory, const QUrl &entry) const;
+
+    void addEntry(const QUrl &directory, const QUrl &entry);
+
+    void removeEntry(const QUrl &directory, const QUrl &entry);
+
+    QSet<QUrl> entries(const QUrl &directory) const;
+
+    int directoriesCount() const;
+
+    int namesCount() const;
+
+    void clear();
+
+private:
+
+    std::unique_ptr<DirectoryTreePrivate> d;
+
+};
+
+#endif // DIRECTORYTREE_H
@@ -0,0 +1,322 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "inotifydirectorywatcher.h"
+
+#include <QHash>
+#include <QSet>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include <QDebug>
+
+#if defined Q_OS_LINUX
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class InotifyDirectoryWatcherPrivate
+{
+public:
+
+    int mInotifyDescriptor = -1;
+
+    QSocketNotifier *mNotifier = nullptr;
+
+    QHash<int, QString> mDirectories;
+
+    QHash<QString, int> mWatchDescriptors;
+
+    QHash<QString, qint64> mCreatedFiles;
+
+    QElapsedTimer mClock;
+
+    QTimer *mCreatedFilesTimer = nullptr;
+
+    static const int mCreatedFilesQuietDelay = 5000;
+
+};
+
+InotifyDirectoryWatcher::InotifyDirectoryWatcher(QObject *parent) : QObject(parent), d(new InotifyDirectoryWatcherPrivate)
+{
+#if defined Q_OS_LINUX
+    d->mInotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (d->mInotifyDescriptor == -1) {
+        qDebug() << "InotifyDirectoryWatcher::InotifyDirectoryWatcher" << "inotify is not available";
+        return;
+    }
+
+    d->mNotifier = new QSocketNotifier(d->mInotifyDescriptor, QSocketNotifier::Read, this);
+
+    connect(d->mNotifier, &QSocketNotifier::activated, this, &InotifyDirectoryWatcher::readEvents);
+
+    d->mClock.start();
+
+    d->mCreatedFilesTimer = new QTimer(this);
+    d->mCreatedFilesTimer->setSingleShot(true);
+    d->mCreatedFilesTimer->setInterval(InotifyDirectoryWatcherPrivate::mCreatedFilesQuietDelay);
+
+    connect(d->mCreatedFilesTimer, &QTimer::timeout, this, &InotifyDirectoryWatcher::createdFilesTimeout);
+#endif
+}
+
+InotifyDirectoryWatcher::~InotifyDirectoryWatcher()
+{
+#if defined Q_OS_LINUX
+    if (d->mInotifyDescriptor != -1) {
+        close(d->mInotifyDescriptor);
+    }
+#endif
+}
+
+bool InotifyDirectoryWatcher::isValid() const
+{
+    return d->mInotifyDescriptor != -1;
+}
+
+bool InotifyDirectoryWatcher::addDirectory(const QString &path)
+{
+#if defined Q_OS_LINUX
+    if (d->mInotifyDescriptor == -1) {
+        return false;
+    }
+
+    if (d->mWatchDescriptors.contains(path)) {
+        return true;
+    }
+
+    auto watchDescriptor = inotify_add_watch(d->mInotifyDescriptor, QFile::encodeName(path).constData(),
+                                             IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM |
+                                             IN_MOVED_TO | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+
+    if (watchDescriptor == -1) {
+        qDebug() << "InotifyDirectoryWatcher::addDirectory" << path << "cannot be watched";
+        return false;
+    }
+
+    const auto itOldPath = d->mDirectories.constFind(watchDescriptor);
+    if (itOldPath != d->mDirectories.constEnd()) {
+        d->mWatchDescriptors.remove(*itOldPath);
+    }
+
+    d->mDirectories[watchDescriptor] = path;
+    d->mWatchDescriptors[path] = watchDescriptor;
+
+    return true;
+#else
+    Q_UNUSED(path);
+
+    return false;
+#endif
+}
+
+void InotifyDirectoryWatcher::removeDirectoryTree(const QString &path)
+{
+#if defined Q_OS_LINUX
+    const auto &pathPrefix = path + QStringLiteral("/");
+
+    for (auto itDirectory = d->mWatchDescriptors.begin(); itDirectory != d->mWatchDescriptors.end();) {
+        if (itDirectory.key() != path && !itDirectory.key().startsWith(pathPrefix)) {
+            ++itDirectory;
+            continue;
+        }
+
+        inotify_rm_watch(d->mInotifyDescriptor, itDirectory.value());
+        d->mDirectories.remove(itDirectory.value());
+
+        itDirectory = d->mWatchDescriptors.erase(itDirectory);
+    }
+#else
+    Q_UNUSED(path);
+#endif
+}
+
+void InotifyDirectoryWatcher::readEvents()
+{
+#if defined Q_OS_LINUX
+    auto addedPaths = QList<QUrl>();
+    auto modifiedFiles = QList<QUrl>();
+    auto movedPaths = QList<QPair<QUrl, QUrl>>();
+    auto removedPaths = QList<QUrl>();
+
+    auto knownModifiedFiles = QSet<QString>();
+    auto movedFromPaths = QHash<quint32, QString>();
+    auto movedFromCookies = QList<quint32>();
+    auto hasOverflow = false;
+
+    alignas(struct inotify_event) char eventsBuffer[64 * 1024];
+
+    while (true) {
+        const auto bufferLength = read(d->mInotifyDescriptor, eventsBuffer, sizeof(eventsBuffer));
+
+        if (bufferLength <= 0) {
+            break;
+        }
+
+        for (auto currentEvent = eventsBuffer; currentEvent < eventsBuffer + bufferLength;) {
+            const auto oneEvent = reinterpret_cast<const struct inotify_event*>(currentEvent);
+            currentEvent += sizeof(struct inotify_event) + oneEvent->len;
+
+            if (oneEvent->mask & IN_Q_OVERFLOW) {
+                hasOverflow = true;
+                continue;
+            }
+
+            if (oneEvent->mask & IN_IGNORED) {
+                const auto itDirectory = d->mDirectories.find(oneEvent->wd);
+                if (itDirectory != d->mDirectories.end()) {
+                    d->mWatchDescriptors.remove(*itDirectory);
+                    d->mDirectories.erase(itDirectory);
+                }
+                continue;
+            }
+
+            const auto itDirectory = d->mDirectories.constFind(oneEvent->wd);
+            if (itDirectory == d->mDirectories.constEnd()) {
+                continue;
+            }
+
+            if (oneEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                const auto &parentPath = QFileInfo(*itDirectory).absolutePath();
+                if (!d->mWatchDescriptors.contains(parentPath)) {
+                    removedPaths.push_back(QUrl::fromLocalFile(*itDirectory));
+                }
+                continue;
+            }
+
+            if (oneEvent->len == 0) {
+                continue;
+            }
+
+            const auto &eventPath = *itDirectory + QStringLiteral("/") + QFile::decodeName(oneEvent->name);
+            const auto isDirectory = (oneEvent->mask & IN_ISDIR) != 0;
+
+            if (oneEvent->mask & IN_CREATE) {
+                struct stat fileStatus;
+                if (isDirectory) {
+                    addedPaths.push_back(QUrl::fromLocalFile(eventPath));
+                } else if (lstat(QFile::encodeName(eventPath).constData(), &fileStatus) == 0 &&
+                           (!S_ISREG(fileStatus.st_mode) || fileStatus.st_nlink > 1)) {
+                    addedPaths.push_back(QUrl::fromLocalFile(eventPath));
+                } else {
+                    d->mCreatedFiles[eventPath] = d->mClock.elapsed();
+                }
+            } else if (oneEvent->mask & IN_MODIFY) {
+                const auto itCreatedFile = d->mCreatedFiles.find(eventPath);
+                if (itCreatedFile != d->mCreatedFiles.end()) {
+                    *itCreatedFile = d->mClock.elapsed();
+                }
+            } else if (oneEvent->mask & IN_CLOSE_WRITE) {
+                if (d->mCreatedFiles.remove(eventPath)) {
+                    addedPaths.push_back(QUrl::fromLocalFile(eventPath));
+                } else if (!knownModifiedFiles.contains(eventPath)) {
+                    knownModifiedFiles.insert(eventPath);
+                    modifiedFiles.push_back(QUrl::fromLocalFile(eventPath));
+                }
+            } else if (oneEvent->mask & IN_ATTRIB) {
+                if (!isDirectory && !d->mCreatedFiles.contains(eventPath) && !knownModifiedFiles.contains(eventPath)) {
+                    knownModifiedFiles.insert(eventPath);
+                    modifiedFiles.push_back(QUrl::fromLocalFile(eventPath));
+                }
+            } else if (oneEvent->mask & IN_MOVED_FROM) {
+                movedFromPaths[oneEvent->cookie] = eventPath;
+                movedFromCookies.push_back(oneEvent->cookie);
+            } else if (oneEvent->mask & IN_MOVED_TO) {
+                const auto itMovedFrom = movedFromPaths.find(oneEvent->cookie);
+                if (itMovedFrom != movedFromPaths.end()) {
+                    movedPaths.push_back({QUrl::fromLocalFile(*itMovedFrom), QUrl::fromLocalFile(eventPath)});
+                    movedFromPaths.erase(itMovedFrom);
+                } else {
+                    addedPaths.push_back(QUrl::fromLocalFile(eventPath));
+                }
+            } else if (oneEvent->mask & IN_DELETE) {
+                d->mCreatedFiles.remove(eventPath);
+                removedPaths.push_back(QUrl::fromLocalFile(eventPath));
+            }
+        }
+    }
+
+    for (auto oneCookie : movedFromCookies) {
+        const auto itMovedFrom = movedFromPaths.constFind(oneCookie);
+        if (itMovedFrom != movedFromPaths.constEnd()) {
+            removedPaths.push_back(QUrl::fromLocalFile(*itMovedFrom));
+        }
+    }
+
+    sweepCreatedFiles(addedPaths);
+
+    if (!addedPaths.isEmpty() || !modifiedFiles.isEmpty() || !movedPaths.isEmpty() || !removedPaths.isEmpty()) {
+        Q_EMIT changesDetected(addedPaths, modifiedFiles, movedPaths, removedPaths);
+    }
+
+    if (hasOverflow) {
+        Q_EMIT eventsOverflow();
+    }
+#endif
+}
+
+void InotifyDirectoryWatcher::createdFilesTimeout()
+{
+    auto addedPaths = QList<QUrl>();
+
+    sweepCreatedFiles(addedPaths);
+
+    if (!addedPaths.isEmpty()) {
+        Q_EMIT changesDetected(addedPaths, {}, {}, {});
+    }
+}
+
+void InotifyDirectoryWatcher::sweepCreatedFiles(QList<QUrl> &addedPaths)
+{
+    const auto currentTime = d->mClock.elapsed();
+    auto nextTimeout = qint64(-1);
+
+    for (auto itCreatedFile = d->mCreatedFiles.begin(); itCreatedFile != d->mCreatedFiles.end();) {
+        const auto quietTime = currentTime - itCreatedFile.value();
+
+        if (quietTime < InotifyDirectoryWatcherPrivate::mCreatedFilesQuietDelay) {
+            const auto remainingTime = InotifyDirectoryWatcherPrivate::mCreatedFilesQuietDelay - quietTime;
+            if (nextTimeout == -1 || remainingTime < nextTimeout) {
+                nextTimeout = remainingTime;
+            }
+            ++itCreatedFile;
+            continue;
+        }
+
+        if (QFileInfo::exists(itCreatedFile.key())) {
+            addedPaths.push_back(QUrl::fromLocalFile(itCreatedFile.key()));
+        }
+
+        itCreatedFile = d->mCreatedFiles.erase(itCreatedFile);
+    }
+
+    if (nextTimeout == -1) {
+        d->mCreatedFilesTimer->stop();
+    } else {
+        d->mCreatedFilesTimer->start(int(nextTimeout));
+    }
+}
+
+
+#include "moc_inotifydirectorywatcher.cpp"
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INOTIFYDIRECTORYWATCHER_H
+#define INOTIFYDIRECTORYWATCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QList>
+#include <QPair>
+
+#include <memory>
+
+class InotifyDirectoryWatcherPrivate;
+
+class InotifyDirectoryWatcher : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit InotifyDirectoryWatcher(QObject *parent = 0);
+
+    virtual ~InotifyDirectoryWatcher();
+
+    bool isValid() const;
+
+    bool addDirectory(const QString &path);
+
+    void removeDirectoryTree(const QString &path);
+
+Q_SIGNALS:
+
+    void changesDetected(const QList<QUrl> &addedPaths, const QList<QUrl> &modifiedFiles,
+                         const QList<QPair<QUrl, QUrl>> &movedPaths, const QList<QUrl> &removedPaths);
+
+    void eventsOverflow();
+
+private Q_SLOTS:
+
+    void readEvents();
+
+    void createdFilesTimeout();
+
+private:
+
+    void sweepCreatedFiles(QList<QUrl> &addedPaths);
+
+    std::unique_ptr<InotifyDirectoryWatcherPrivate> d;
+
+};
+
+#endif // INOTIFYDIRECTORYWATCHER_H
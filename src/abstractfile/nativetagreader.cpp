@@ -0,0 +1,596 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "nativetagreader.h"
+#include "tagcontainerreader.h"
+
+#include "musicaudiotrack.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QTime>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+static const qint64 MaximumTagSize = 16 * 1024 * 1024;
+
+static const qint64 MaximumFrameSyncSearch = 64 * 1024;
+
+static const qint64 MaximumLastPageSearch = 64 * 1024;
+
+static const qint64 MaximumMpegFrameSize = 4096;
+
+static const qint64 MaximumMp4ItemSize = 64 * 1024;
+
+class NativeTags
+{
+public:
+
+    QString mTitle;
+
+    QString mArtist;
+
+    QString mAlbum;
+
+    QString mAlbumArtist;
+
+    int mTrackNumber = 0;
+
+    int mDiscNumber = 0;
+
+    qint64 mDuration = -1;
+
+    bool mHasTags = false;
+
+};
+
+static quint16 readBigEndian16(const uchar *data)
+{
+    return qFromBigEndian<quint16>(data);
+}
+
+static quint64 readBigEndian64(const uchar *data)
+{
+    return qFromBigEndian<quint64>(data);
+}
+
+static quint16 readLittleEndian16(const uchar *data)
+{
+    return qFromLittleEndian<quint16>(data);
+}
+
+static quint64 readLittleEndian64(const uchar *data)
+{
+    return qFromLittleEndian<quint64>(data);
+}
+
+static int leadingNumber(const QString &value)
+{
+    return value.section(QLatin1Char('/'), 0, 0).trimmed().toInt();
+}
+
+static void setFirstValue(QString &field, const QString &value)
+{
+    if (field.isEmpty()) {
+        field = value;
+    }
+}
+
+static void setFirstValue(int &field, int value)
+{
+    if (field == 0) {
+        field = value;
+    }
+}
+
+static void addVorbisComment(const QByteArray &comment, NativeTags &tags)
+{
+    const auto separator = comment.indexOf('=');
+    if (separator <= 0) {
+        return;
+    }
+
+    const auto &key = comment.left(separator).toUpper();
+    const auto &value = QString::fromUtf8(comment.constData() + separator + 1, comment.size() - separator - 1);
+
+    if (key == "TITLE") {
+        setFirstValue(tags.mTitle, value);
+    } else if (key == "ARTIST") {
+        setFirstValue(tags.mArtist, value);
+    } else if (key == "ALBUM") {
+        setFirstValue(tags.mAlbum, value);
+    } else if (key == "ALBUMARTIST" || key == "ALBUM ARTIST") {
+        setFirstValue(tags.mAlbumArtist, value);
+    } else if (key == "TRACKNUMBER") {
+        setFirstValue(tags.mTrackNumber, leadingNumber(value));
+    } else if (key == "DISCNUMBER") {
+        setFirstValue(tags.mDiscNumber, leadingNumber(value));
+    }
+}
+
+static bool parseVorbisComments(const char *data, qint64 size, NativeTags &tags)
+{
+    const auto isParsed = TagContainerReader::readVorbisComments(data, size, [&tags](const QByteArray &comment) {
+        addVorbisComment(comment, tags);
+        return true;
+    });
+
+    if (isParsed) {
+        tags.mHasTags = true;
+    }
+
+    return isParsed;
+}
+
+static QString decodeUtf16(const uchar *data, qint64 size, bool isBigEndian)
+{
+    auto result = QString();
+    result.reserve(static_cast<int>(size / 2));
+
+    for (qint64 offset = 0; offset + 1 < size; offset += 2) {
+        const auto codeUnit = isBigEndian ? readBigEndian16(data + offset) : readLittleEndian16(data + offset);
+
+        if (codeUnit == 0) {
+            break;
+        }
+
+        result.append(QChar(codeUnit));
+    }
+
+    return result;
+}
+
+static QString id3Text(const uchar *data, qint64 size)
+{
+    if (size < 1) {
+        return {};
+    }
+
+    const auto textEncoding = data[0];
+    ++data;
+    --size;
+
+    switch (textEncoding)
+    {
+    case 0:
+    case 3:
+    {
+        const auto textEnd = static_cast<const uchar*>(memchr(data, 0, static_cast<size_t>(size)));
+        const auto textSize = static_cast<int>(textEnd ? textEnd - data : size);
+
+        if (textEncoding == 0) {
+            return QString::fromLatin1(reinterpret_cast<const char*>(data), textSize);
+        }
+        return QString::fromUtf8(reinterpret_cast<const char*>(data), textSize);
+    }
+    case 1:
+        if (size >= 2 && data[0] == 0xfe && data[1] == 0xff) {
+            return decodeUtf16(data + 2, size - 2, true);
+        }
+        if (size >= 2 && data[0] == 0xff && data[1] == 0xfe) {
+            return decodeUtf16(data + 2, size - 2, false);
+        }
+        return decodeUtf16(data, size, false);
+    case 2:
+        return decodeUtf16(data, size, true);
+    }
+
+    return {};
+}
+
+static void addId3v2Frame(const QByteArray &frameId, const QByteArray &frameData, NativeTags &tags)
+{
+    const auto frameContent = reinterpret_cast<const uchar*>(frameData.constData());
+
+    if (frameId == "TIT2" || frameId == "TT2") {
+        setFirstValue(tags.mTitle, id3Text(frameContent, frameData.size()));
+    } else if (frameId == "TPE1" || frameId == "TP1") {
+        setFirstValue(tags.mArtist, id3Text(frameContent, frameData.size()));
+    } else if (frameId == "TALB" || frameId == "TAL") {
+        setFirstValue(tags.mAlbum, id3Text(frameContent, frameData.size()));
+    } else if (frameId == "TPE2" || frameId == "TP2") {
+        setFirstValue(tags.mAlbumArtist, id3Text(frameContent, frameData.size()));
+    } else if (frameId == "TRCK" || frameId == "TRK") {
+        setFirstValue(tags.mTrackNumber, leadingNumber(id3Text(frameContent, frameData.size())));
+    } else if (frameId == "TPOS" || frameId == "TPA") {
+        setFirstValue(tags.mDiscNumber, leadingNumber(id3Text(frameContent, frameData.size())));
+    }
+}
+
+static void parseId3v2(QFile &musicFile, NativeTags &tags)
+{
+    const auto isParsed = TagContainerReader::readId3v2Frames(musicFile, MaximumTagSize, [](const QByteArray &frameId) {
+        return frameId.startsWith('T');
+    }, [&tags](const QByteArray &frameId, const QByteArray &frameData, int) {
+        addId3v2Frame(frameId, frameData, tags);
+        return true;
+    });
+
+    if (isParsed) {
+        tags.mHasTags = true;
+    }
+}
+
+static QString id3v1Text(const uchar *data, int size)
+{
+    const auto textEnd = static_cast<const uchar*>(memchr(data, 0, static_cast<size_t>(size)));
+
+    return QString::fromLatin1(reinterpret_cast<const char*>(data), static_cast<int>(textEnd ? textEnd - data : size)).trimmed();
+}
+
+static void parseId3v1(const uchar *data, NativeTags &tags)
+{
+    setFirstValue(tags.mTitle, id3v1Text(data + 3, 30));
+    setFirstValue(tags.mArtist, id3v1Text(data + 33, 30));
+    setFirstValue(tags.mAlbum, id3v1Text(data + 63, 30));
+
+    if (data[125] == 0 && data[126] != 0) {
+        setFirstValue(tags.mTrackNumber, data[126]);
+    }
+
+    tags.mHasTags = true;
+}
+
+static bool isMpegFrameSync(const uchar *data)
+{
+    return data[0] == 0xff && (data[1] & 0xe0) == 0xe0;
+}
+
+static qint64 mpegAudioDuration(QFile &musicFile, qint64 start, qint64 end)
+{
+    static const int bitrates[2][3][15] = {
+        {{0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448},
+         {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},
+         {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320}},
+        {{0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},
+         {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+         {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160}}};
+    static const int sampleRates[3] = {44100, 48000, 32000};
+
+    if (end <= start || !musicFile.seek(start)) {
+        return -1;
+    }
+
+    const auto &audioStart = musicFile.read(std::min(end - start, MaximumFrameSyncSearch + MaximumMpegFrameSize));
+    const auto data = reinterpret_cast<const uchar*>(audioStart.constData());
+    const qint64 dataSize = audioStart.size();
+
+    const auto searchEnd = std::min(dataSize - 4, MaximumFrameSyncSearch);
+
+    for (qint64 offset = 0; offset <= searchEnd; ++offset) {
+        const auto frameHeader = data + offset;
+
+        if (!isMpegFrameSync(frameHeader)) {
+            continue;
+        }
+
+        const auto versionBits = (frameHeader[1] >> 3) & 0x03;
+        const auto layerBits = (frameHeader[1] >> 1) & 0x03;
+        const auto bitrateIndex = frameHeader[2] >> 4;
+        const auto sampleRateIndex = (frameHeader[2] >> 2) & 0x03;
+
+        if (versionBits == 1 || layerBits == 0 || bitrateIndex == 0 || bitrateIndex == 15 || sampleRateIndex == 3) {
+            continue;
+        }
+
+        const auto isMpeg1 = (versionBits == 3);
+        const auto layer = 4 - layerBits;
+        const qint64 bitrate = bitrates[isMpeg1 ? 0 : 1][layer - 1][bitrateIndex] * 1000;
+        const qint64 sampleRate = sampleRates[sampleRateIndex] >> (isMpeg1 ? 0 : (versionBits == 2 ? 1 : 2));
+        const qint64 samplesPerFrame = (layer == 1) ? 384 : ((layer == 3 && !isMpeg1) ? 576 : 1152);
+        const auto padding = (frameHeader[2] >> 1) & 0x01;
+        const auto frameLength = (layer == 1) ? (12 * bitrate / sampleRate + padding) * 4 :
+                                                samplesPerFrame / 8 * bitrate / sampleRate + padding;
+
+        if (offset + frameLength + 2 <= dataSize && !isMpegFrameSync(frameHeader + frameLength)) {
+            continue;
+        }
+
+        const auto isMono = ((frameHeader[3] >> 6) == 3);
+        const auto xingOffset = offset + 4 + (isMpeg1 ? (isMono ? 17 : 32) : (isMono ? 9 : 17));
+
+        if (layer == 3 && xingOffset + 12 <= dataSize &&
+                (memcmp(data + xingOffset, "Xing", 4) == 0 || memcmp(data + xingOffset, "Info", 4) == 0) &&
+                (TagContainerReader::readBigEndian32(data + xingOffset + 4) & 0x01)) {
+            return static_cast<qint64>(TagContainerReader::readBigEndian32(data + xingOffset + 8)) * samplesPerFrame * 1000 / sampleRate;
+        }
+
+        const auto vbriOffset = offset + 4 + 32;
+
+        if (vbriOffset + 18 <= dataSize && memcmp(data + vbriOffset, "VBRI", 4) == 0) {
+            return static_cast<qint64>(TagContainerReader::readBigEndian32(data + vbriOffset + 14)) * samplesPerFrame * 1000 / sampleRate;
+        }
+
+        return (end - start - offset) * 8 * 1000 / bitrate;
+    }
+
+    return -1;
+}
+
+static bool readMp3(QFile &musicFile, const QByteArray &fileHeader, NativeTags &tags)
+{
+    const auto fileSize = musicFile.size();
+    const auto tagSize = TagContainerReader::id3v2TagSize(musicFile);
+
+    auto id3v1Tag = QByteArray();
+    if (fileSize - tagSize >= 128 && musicFile.seek(fileSize - 128)) {
+        id3v1Tag = musicFile.read(128);
+    }
+
+    const auto hasId3v1 = (id3v1Tag.size() == 128 && id3v1Tag.startsWith("TAG"));
+
+    if (tagSize == 0 && !(hasId3v1 && isMpegFrameSync(reinterpret_cast<const uchar*>(fileHeader.constData())))) {
+        return false;
+    }
+
+    if (tagSize != 0) {
+        parseId3v2(musicFile, tags);
+    }
+
+    auto audioEnd = fileSize;
+    if (hasId3v1) {
+        parseId3v1(reinterpret_cast<const uchar*>(id3v1Tag.constData()), tags);
+        audioEnd -= 128;
+    }
+
+    tags.mDuration = mpegAudioDuration(musicFile, tagSize, audioEnd);
+
+    return tags.mHasTags && tags.mDuration >= 0;
+}
+
+static bool readFlac(QFile &musicFile, qint64 start, NativeTags &tags)
+{
+    auto hasStreamInfo = false;
+
+    const auto isParsed = TagContainerReader::readFlacBlocks(musicFile, start, MaximumTagSize, [](int blockType) {
+        return blockType == 0 || blockType == 4;
+    }, [&tags, &hasStreamInfo](int blockType, const QByteArray &blockData) {
+        if (blockType == 0 && blockData.size() >= 18) {
+            const auto streamInfo = reinterpret_cast<const uchar*>(blockData.constData());
+            const qint64 sampleRate = (streamInfo[10] << 12) | (streamInfo[11] << 4) | (streamInfo[12] >> 4);
+            const auto samplesCount = (static_cast<qint64>(streamInfo[13] & 0x0f) << 32) | TagContainerReader::readBigEndian32(streamInfo + 14);
+
+            if (sampleRate > 0) {
+                tags.mDuration = samplesCount * 1000 / sampleRate;
+                hasStreamInfo = true;
+            }
+        } else if (blockType == 4) {
+            parseVorbisComments(blockData.constData(), blockData.size(), tags);
+        }
+
+        return true;
+    });
+
+    return isParsed && hasStreamInfo && tags.mHasTags;
+}
+
+static bool readOgg(QFile &musicFile, NativeTags &tags)
+{
+    auto identificationPacket = QByteArray();
+    auto commentPacket = QByteArray();
+    auto streamSerial = quint32(0);
+
+    if (!TagContainerReader::readOggHeaderPackets(musicFile, MaximumTagSize, identificationPacket, commentPacket, streamSerial)) {
+        return false;
+    }
+
+    const auto identificationData = reinterpret_cast<const uchar*>(identificationPacket.constData());
+    qint64 sampleRate = 0;
+    qint64 preSkip = 0;
+    qint64 commentsOffset = 0;
+
+    if (identificationPacket.size() >= 16 && identificationPacket.startsWith("\x01vorbis") && commentPacket.startsWith("\x03vorbis")) {
+        sampleRate = TagContainerReader::readLittleEndian32(identificationData + 12);
+        commentsOffset = 7;
+    } else if (identificationPacket.size() >= 19 && identificationPacket.startsWith("OpusHead") && commentPacket.startsWith("OpusTags")) {
+        sampleRate = 48000;
+        preSkip = readLittleEndian16(identificationData + 10);
+        commentsOffset = 8;
+    } else {
+        return false;
+    }
+
+    if (sampleRate <= 0 || !parseVorbisComments(commentPacket.constData() + commentsOffset, commentPacket.size() - commentsOffset, tags)) {
+        return false;
+    }
+
+    const auto fileSize = musicFile.size();
+    const auto searchStart = std::max<qint64>(0, fileSize - MaximumLastPageSearch);
+
+    if (!musicFile.seek(searchStart)) {
+        return false;
+    }
+
+    const auto &fileEnd = musicFile.read(fileSize - searchStart);
+    const auto data = reinterpret_cast<const uchar*>(fileEnd.constData());
+
+    for (qint64 pageOffset = fileEnd.size() - 27; pageOffset >= 0; --pageOffset) {
+        const auto pageHeader = data + pageOffset;
+
+        if (pageHeader[0] != 'O' || memcmp(pageHeader, "OggS", 4) != 0 || TagContainerReader::readLittleEndian32(pageHeader + 14) != streamSerial) {
+            continue;
+        }
+
+        const auto granulePosition = static_cast<qint64>(readLittleEndian64(pageHeader + 6));
+
+        if (granulePosition >= 0) {
+            tags.mDuration = std::max<qint64>(0, granulePosition - preSkip) * 1000 / sampleRate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void addMp4Item(const QByteArray &itemName, const QByteArray &itemData, NativeTags &tags)
+{
+    if (itemData.size() < 8) {
+        return;
+    }
+
+    const auto value = reinterpret_cast<const uchar*>(itemData.constData()) + 8;
+    const auto valueSize = itemData.size() - 8;
+    auto textValue = [value, valueSize]() {
+        return QString::fromUtf8(reinterpret_cast<const char*>(value), valueSize);
+    };
+
+    if (itemName == "\xa9" "nam") {
+        setFirstValue(tags.mTitle, textValue());
+    } else if (itemName == "\xa9" "ART") {
+        setFirstValue(tags.mArtist, textValue());
+    } else if (itemName == "\xa9" "alb") {
+        setFirstValue(tags.mAlbum, textValue());
+    } else if (itemName == "aART") {
+        setFirstValue(tags.mAlbumArtist, textValue());
+    } else if (itemName == "trkn" && valueSize >= 4) {
+        setFirstValue(tags.mTrackNumber, readBigEndian16(value + 2));
+    } else if (itemName == "disk" && valueSize >= 4) {
+        setFirstValue(tags.mDiscNumber, readBigEndian16(value + 2));
+    }
+}
+
+static bool isWantedMp4Item(const QByteArray &itemName)
+{
+    return itemName == "\xa9" "nam" || itemName == "\xa9" "ART" || itemName == "\xa9" "alb" ||
+            itemName == "aART" || itemName == "trkn" || itemName == "disk";
+}
+
+static bool readMp4(QFile &musicFile, NativeTags &tags)
+{
+    qint64 moovStart = 0;
+    qint64 moovEnd = 0;
+    qint64 atomStart = 0;
+    qint64 atomEnd = 0;
+
+    if (!TagContainerReader::findMp4Atom(musicFile, 0, musicFile.size(), "moov", moovStart, moovEnd) ||
+            !TagContainerReader::findMp4Atom(musicFile, moovStart, moovEnd, "mvhd", atomStart, atomEnd) ||
+            atomEnd - atomStart < 20 || !musicFile.seek(atomStart)) {
+        return false;
+    }
+
+    const auto &movieHeaderData = musicFile.read(std::min<qint64>(atomEnd - atomStart, 32));
+    const auto movieHeader = reinterpret_cast<const uchar*>(movieHeaderData.constData());
+    qint64 timeScale = 0;
+    qint64 duration = 0;
+
+    if (movieHeaderData.size() < 20) {
+        return false;
+    }
+
+    if (movieHeader[0] == 1) {
+        if (movieHeaderData.size() < 32) {
+            return false;
+        }
+
+        timeScale = TagContainerReader::readBigEndian32(movieHeader + 20);
+        duration = static_cast<qint64>(readBigEndian64(movieHeader + 24));
+    } else {
+        timeScale = TagContainerReader::readBigEndian32(movieHeader + 12);
+        duration = TagContainerReader::readBigEndian32(movieHeader + 16);
+    }
+
+    if (timeScale <= 0 || duration < 0) {
+        return false;
+    }
+
+    tags.mDuration = duration * 1000 / timeScale;
+
+    if (!TagContainerReader::findMp4AtomPath(musicFile, moovStart, moovEnd, {"udta", "meta", "ilst"}, atomStart, atomEnd)) {
+        return false;
+    }
+
+    auto itemPosition = atomStart;
+
+    while (itemPosition + 8 <= atomEnd && musicFile.seek(itemPosition)) {
+        const auto &itemHeader = musicFile.read(8);
+        if (itemHeader.size() != 8) {
+            break;
+        }
+
+        const qint64 itemSize = TagContainerReader::readBigEndian32(itemHeader.constData());
+
+        if (itemSize < 8 || itemSize > atomEnd - itemPosition) {
+            break;
+        }
+
+        const auto &itemName = itemHeader.mid(4);
+        qint64 dataStart = 0;
+        qint64 dataEnd = 0;
+
+        if (isWantedMp4Item(itemName) &&
+                TagContainerReader::findMp4Atom(musicFile, itemPosition + 8, itemPosition + itemSize, "data", dataStart, dataEnd) &&
+                dataEnd - dataStart <= MaximumMp4ItemSize && musicFile.seek(dataStart)) {
+            addMp4Item(itemName, musicFile.read(dataEnd - dataStart), tags);
+        }
+
+        itemPosition += itemSize;
+    }
+
+    tags.mHasTags = true;
+
+    return true;
+}
+
+bool NativeTagReader::readTags(const QString &fileName, MusicAudioTrack &track)
+{
+    QFile musicFile(fileName);
+
+    if (!musicFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const auto &fileHeader = musicFile.read(12);
+    if (fileHeader.size() < 12) {
+        return false;
+    }
+
+    auto tags = NativeTags();
+    auto isParsed = false;
+
+    if (fileHeader.mid(4, 4) == "ftyp") {
+        isParsed = readMp4(musicFile, tags);
+    } else if (fileHeader.startsWith("OggS")) {
+        isParsed = readOgg(musicFile, tags);
+    } else {
+        const auto id3TagSize = TagContainerReader::id3v2TagSize(musicFile);
+
+        if (musicFile.seek(id3TagSize) && musicFile.read(4) == "fLaC") {
+            isParsed = readFlac(musicFile, id3TagSize, tags);
+        } else {
+            isParsed = readMp3(musicFile, fileHeader, tags);
+        }
+    }
+
+    if (!isParsed || tags.mTitle.isEmpty() || tags.mAlbum.isEmpty()) {
+        return false;
+    }
+
+    track.setTitle(tags.mTitle);
+    track.setArtist(tags.mArtist);
+    track.setAlbumName(tags.mAlbum);
+    track.setAlbumArtist(tags.mAlbumArtist);
+    track.setTrackNumber(tags.mTrackNumber);
+    track.setDiscNumber(tags.mDiscNumber);
+    track.setDuration(QTime::fromMSecsSinceStartOfDay(static_cast<int>(std::max<qint64>(0, tags.mDuration))));
+
+    return true;
+}
@@ -0,0 +1,417 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "tagcontainerreader.h"
+
+#include <QIODevice>
+#include <QBuffer>
+#include <QtEndian>
+
+#include <algorithm>
+
+quint32 TagContainerReader::readBigEndian32(const char *data)
+{
+    return readBigEndian32(reinterpret_cast<const uchar*>(data));
+}
+
+quint32 TagContainerReader::readBigEndian32(const uchar *data)
+{
+    return qFromBigEndian<quint32>(data);
+}
+
+quint32 TagContainerReader::readLittleEndian32(const char *data)
+{
+    return readLittleEndian32(reinterpret_cast<const uchar*>(data));
+}
+
+quint32 TagContainerReader::readLittleEndian32(const uchar *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+quint32 TagContainerReader::readSyncSafe32(const char *data)
+{
+    return ((uchar(data[0]) & 0x7f) << 21) | ((uchar(data[1]) & 0x7f) << 14) |
+            ((uchar(data[2]) & 0x7f) << 7) | (uchar(data[3]) & 0x7f);
+}
+
+QByteArray TagContainerReader::removeUnsynchronisation(QByteArray data)
+{
+    return data.replace(QByteArray("\xff\x00", 2), QByteArray("\xff", 1));
+}
+
+qint64 TagContainerReader::id3v2TagSize(QIODevice &device)
+{
+    if (!device.seek(0)) {
+        return 0;
+    }
+
+    const auto &tagHeader = device.read(10);
+    if (tagHeader.size() != 10 || !tagHeader.startsWith("ID3") || uchar(tagHeader[3]) < 2 || uchar(tagHeader[3]) > 4) {
+        return 0;
+    }
+
+    qint64 tagSize = 10 + static_cast<qint64>(readSyncSafe32(tagHeader.constData() + 6));
+
+    if (uchar(tagHeader[3]) == 4 && (uchar(tagHeader[5]) & 0x10)) {
+        tagSize += 10;
+    }
+
+    return std::min(tagSize, device.size());
+}
+
+bool TagContainerReader::readId3v2Frames(QIODevice &device, qint64 maximumTagSize,
+                                         const std::function<bool(const QByteArray&)> &wantsFrame,
+                                         const std::function<bool(const QByteArray&, const QByteArray&, int)> &frameVisitor)
+{
+    if (!device.seek(0)) {
+        return false;
+    }
+
+    const auto &tagHeader = device.read(10);
+    if (tagHeader.size() != 10 || !tagHeader.startsWith("ID3")) {
+        return false;
+    }
+
+    const auto majorVersion = uchar(tagHeader[3]);
+    const auto tagFlags = uchar(tagHeader[5]);
+    const qint64 tagSize = readSyncSafe32(tagHeader.constData() + 6);
+
+    if (majorVersion < 2 || majorVersion > 4 || tagSize > maximumTagSize) {
+        return false;
+    }
+
+    QBuffer synchronisedTag;
+    auto tagDevice = &device;
+    qint64 offset = 10;
+    auto tagEnd = std::min(10 + tagSize, device.size());
+
+    if ((tagFlags & 0x80) && majorVersion < 4) {
+        synchronisedTag.setData(removeUnsynchronisation(device.read(tagSize)));
+        synchronisedTag.open(QIODevice::ReadOnly);
+
+        tagDevice = &synchronisedTag;
+        offset = 0;
+        tagEnd = synchronisedTag.size();
+    }
+
+    if (majorVersion >= 3 && (tagFlags & 0x40)) {
+        if (!tagDevice->seek(offset)) {
+            return false;
+        }
+
+        const auto &extendedHeader = tagDevice->read(4);
+        if (extendedHeader.size() != 4) {
+            return false;
+        }
+
+        offset += (majorVersion == 3) ? readBigEndian32(extendedHeader.constData()) + 4 : readSyncSafe32(extendedHeader.constData());
+    }
+
+    const auto isVersion2 = (majorVersion == 2);
+    const auto frameHeaderSize = isVersion2 ? 6 : 10;
+
+    while (offset + frameHeaderSize <= tagEnd) {
+        if (!tagDevice->seek(offset)) {
+            break;
+        }
+
+        const auto &frameHeader = tagDevice->read(frameHeaderSize);
+        if (frameHeader.size() != frameHeaderSize || frameHeader[0] == '\0') {
+            break;
+        }
+
+        const auto &frameId = frameHeader.left(isVersion2 ? 3 : 4);
+        qint64 frameSize = 0;
+        auto frameFormatFlags = uchar(0);
+
+        if (isVersion2) {
+            frameSize = (uchar(frameHeader[3]) << 16) | (uchar(frameHeader[4]) << 8) | uchar(frameHeader[5]);
+        } else if (majorVersion == 3) {
+            frameSize = readBigEndian32(frameHeader.constData() + 4);
+            frameFormatFlags = uchar(frameHeader[9]);
+        } else {
+            frameSize = readSyncSafe32(frameHeader.constData() + 4);
+            frameFormatFlags = uchar(frameHeader[9]);
+        }
+
+        offset += frameHeaderSize;
+
+        if (offset + frameSize > tagEnd) {
+            break;
+        }
+
+        const auto frameStart = offset;
+        offset += frameSize;
+
+        if (!wantsFrame(frameId)) {
+            continue;
+        }
+
+        if ((majorVersion == 3 && (frameFormatFlags & 0xc0)) || (majorVersion == 4 && (frameFormatFlags & 0x0c))) {
+            continue;
+        }
+
+        if (!tagDevice->seek(frameStart)) {
+            break;
+        }
+
+        auto frameData = tagDevice->read(frameSize);
+        if (frameData.size() != frameSize) {
+            break;
+        }
+
+        if ((majorVersion == 3 && (frameFormatFlags & 0x20)) || (majorVersion == 4 && (frameFormatFlags & 0x40))) {
+            frameData = frameData.mid(1);
+        }
+        if (majorVersion == 4 && (frameFormatFlags & 0x01)) {
+            frameData = frameData.mid(4);
+        }
+        if (majorVersion == 4 && (frameFormatFlags & 0x02)) {
+            frameData = removeUnsynchronisation(frameData);
+        }
+
+        if (!frameVisitor(frameId, frameData, majorVersion)) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool TagContainerReader::readFlacBlocks(QIODevice &device, qint64 start, qint64 maximumBlockSize,
+                                        const std::function<bool(int)> &wantsBlock,
+                                        const std::function<bool(int, const QByteArray&)> &blockVisitor)
+{
+    if (!device.seek(start) || device.read(4) != "fLaC") {
+        return false;
+    }
+
+    auto offset = start + 4;
+    auto isLastBlock = false;
+
+    while (!isLastBlock) {
+        if (!device.seek(offset)) {
+            break;
+        }
+
+        const auto &blockHeader = device.read(4);
+        if (blockHeader.size() != 4) {
+            break;
+        }
+
+        isLastBlock = (uchar(blockHeader[0]) & 0x80) != 0;
+
+        const auto blockType = uchar(blockHeader[0]) & 0x7f;
+        const qint64 blockSize = (uchar(blockHeader[1]) << 16) | (uchar(blockHeader[2]) << 8) | uchar(blockHeader[3]);
+
+        offset += 4;
+
+        if (offset + blockSize > device.size()) {
+            return false;
+        }
+
+        if (blockSize <= maximumBlockSize && wantsBlock(blockType)) {
+            const auto &blockData = device.read(blockSize);
+            if (blockData.size() != blockSize) {
+                return false;
+            }
+
+            if (!blockVisitor(blockType, blockData)) {
+                break;
+            }
+        }
+
+        offset += blockSize;
+    }
+
+    return true;
+}
+
+bool TagContainerReader::readOggHeaderPackets(QIODevice &device, qint64 maximumPacketSize,
+                                              QByteArray &identificationPacket, QByteArray &commentPacket, quint32 &streamSerial)
+{
+    if (!device.seek(0)) {
+        return false;
+    }
+
+    auto completedPackets = 0;
+    auto isFirstPage = true;
+
+    identificationPacket.clear();
+    commentPacket.clear();
+
+    while (completedPackets < 2) {
+        const auto &pageHeader = device.read(27);
+        if (pageHeader.size() != 27 || !pageHeader.startsWith("OggS")) {
+            return false;
+        }
+
+        const auto pageSerial = readLittleEndian32(pageHeader.constData() + 14);
+        const auto segmentsCount = uchar(pageHeader[26]);
+
+        const auto &segmentsSizes = device.read(segmentsCount);
+        if (segmentsSizes.size() != segmentsCount) {
+            return false;
+        }
+
+        auto pageDataSize = 0;
+        for (auto oneSegmentSize : segmentsSizes) {
+            pageDataSize += uchar(oneSegmentSize);
+        }
+
+        if (isFirstPage) {
+            streamSerial = pageSerial;
+            isFirstPage = false;
+        }
+
+        if (pageSerial != streamSerial) {
+            if (!device.seek(device.pos() + pageDataSize)) {
+                return false;
+            }
+            continue;
+        }
+
+        const auto &pageData = device.read(pageDataSize);
+        if (pageData.size() != pageDataSize) {
+            return false;
+        }
+
+        auto offset = 0;
+        for (auto oneSegmentSize : segmentsSizes) {
+            const auto segmentSize = uchar(oneSegmentSize);
+            auto &currentPacket = (completedPackets == 0) ? identificationPacket : commentPacket;
+
+            currentPacket.append(pageData.constData() + offset, segmentSize);
+            offset += segmentSize;
+
+            if (segmentSize < 255) {
+                ++completedPackets;
+
+                if (completedPackets == 2) {
+                    break;
+                }
+            }
+        }
+
+        if (identificationPacket.size() > maximumPacketSize || commentPacket.size() > maximumPacketSize) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TagContainerReader::readVorbisComments(const char *data, qint64 size,
+                                            const std::function<bool(const QByteArray&)> &commentVisitor)
+{
+    if (size < 8) {
+        return false;
+    }
+
+    qint64 offset = 4 + static_cast<qint64>(readLittleEndian32(data));
+    if (offset + 4 > size) {
+        return false;
+    }
+
+    const auto commentsCount = readLittleEndian32(data + offset);
+    offset += 4;
+
+    for (quint32 commentIndex = 0; commentIndex < commentsCount && offset + 4 <= size; ++commentIndex) {
+        const qint64 commentSize = readLittleEndian32(data + offset);
+        offset += 4;
+
+        if (offset + commentSize > size) {
+            return false;
+        }
+
+        const auto &comment = QByteArray::fromRawData(data + offset, static_cast<int>(commentSize));
+        offset += commentSize;
+
+        if (!commentVisitor(comment)) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool TagContainerReader::findMp4Atom(QIODevice &device, qint64 start, qint64 end, const char *atomName, qint64 &atomStart, qint64 &atomEnd)
+{
+    auto position = start;
+
+    while (position + 8 <= end) {
+        if (!device.seek(position)) {
+            return false;
+        }
+
+        const auto &atomHeader = device.read(8);
+        if (atomHeader.size() != 8) {
+            return false;
+        }
+
+        qint64 atomSize = readBigEndian32(atomHeader.constData());
+        qint64 atomHeaderSize = 8;
+
+        if (atomSize == 1) {
+            const auto &largeSize = device.read(8);
+            if (largeSize.size() != 8) {
+                return false;
+            }
+
+            atomSize = static_cast<qint64>(qFromBigEndian<quint64>(reinterpret_cast<const uchar*>(largeSize.constData())));
+            atomHeaderSize = 16;
+        } else if (atomSize == 0) {
+            atomSize = end - position;
+        }
+
+        if (atomSize < atomHeaderSize || atomSize > end - position) {
+            return false;
+        }
+
+        if (atomHeader.mid(4) == atomName) {
+            atomStart = position + atomHeaderSize;
+            atomEnd = position + atomSize;
+            return true;
+        }
+
+        position += atomSize;
+    }
+
+    return false;
+}
+
+bool TagContainerReader::findMp4AtomPath(QIODevice &device, qint64 start, qint64 end, std::initializer_list<const char*> atomPath,
+                                         qint64 &atomStart, qint64 &atomEnd)
+{
+    atomStart = start;
+    atomEnd = end;
+
+    for (const auto atomName : atomPath) {
+        if (!findMp4Atom(device, atomStart, atomEnd, atomName, atomStart, atomEnd)) {
+            return false;
+        }
+
+        if (qstrcmp(atomName, "meta") == 0) {
+            atomStart += 4;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef TAGCONTAINERREADER_H
+#define TAGCONTAINERREADER_H
+
+#include <QByteArray>
+
+#include <functional>
+#include <initializer_list>
+
+class QIODevice;
+
+class TagContainerReader
+{
+
+public:
+
+    static quint32 readBigEndian32(const char *data);
+
+    static quint32 readBigEndian32(const uchar *data);
+
+    static quint32 readLittleEndian32(const char *data);
+
+    static quint32 readLittleEndian32(const uchar *data);
+
+    static quint32 readSyncSafe32(const char *data);
+
+    static QByteArray removeUnsynchronisation(QByteArray data);
+
+    static qint64 id3v2TagSize(QIODevice &device);
+
+    static bool readId3v2Frames(QIODevice &device, qint64 maximumTagSize,
+                                const std::function<bool(const QByteArray&)> &wantsFrame,
+                                const std::function<bool(const QByteArray&, const QByteArray&, int)> &frameVisitor);
+
+    static bool readFlacBlocks(QIODevice &device, qint64 start, qint64 maximumBlockSize,
+                               const std::function<bool(int)> &wantsBlock,
+                               const std::function<bool(int, const QByteArray&)> &blockVisitor);
+
+    static bool readOggHeaderPackets(QIODevice &device, qint64 maximumPacketSize,
+                                     QByteArray &identificationPacket, QByteArray &commentPacket, quint32 &streamSerial);
+
+    static bool readVorbisComments(const char *data, qint64 size,
+                                   const std::function<bool(const QByteArray&)> &commentVisitor);
+
+    static bool findMp4Atom(QIODevice &device, qint64 start, qint64 end, const char *atomName, qint64 &atomStart, qint64 &atomEnd);
+
+    static bool findMp4AtomPath(QIODevice &device, qint64 start, qint64 end, std::initializer_list<const char*> atomPath,
+                                qint64 &atomStart, qint64 &atomEnd);
+
+};
+
+#endif // TAGCONTAINERREADER_H
@@ -21,6 +21,8 @@
 
 #include "allalbumsmodel.h"
 
+#include <utility>
+
 AlbumFilterProxyModel::AlbumFilterProxyModel(QObject *parent) : QSortFilterProxyModel(parent), mFilterText()
 {
     setFilterCaseSensitivity(Qt::CaseInsensitive);
@@ -47,11 +49,12 @@ void AlbumFilterProxyModel::setFilterText(QString filterText)
 
     mFilterText = filterText;
 
-    mFilterExpression.setPattern(mFilterText);
-    mFilterExpression.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    mFilterExpression.optimize();
+    if (mFilterText.isEmpty()) {
+        mUseSearchResults = false;
+        mMatchingAlbumIds.clear();
 
-    invalidate();
+        invalidate();
+    }
 
     Q_EMIT filterTextChanged(mFilterText);
 }
@@ -69,51 +72,39 @@ void AlbumFilterProxyModel::setFilterRating(int filterRating)
     Q_EMIT filterRatingChanged(filterRating);
 }
 
+void AlbumFilterProxyModel::setSearchResults(const QString &searchText, const QList<qulonglong> &albumIds)
+{
+    if (searchText != mFilterText) {
+        return;
+    }
+
+    auto matchingAlbumIds = albumIds.toSet();
+
+    if (mUseSearchResults && matchingAlbumIds == mMatchingAlbumIds) {
+        return;
+    }
+
+    mUseSearchResults = true;
+    mMatchingAlbumIds = std::move(matchingAlbumIds);
+
+    invalidate();
+}
+
 bool AlbumFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
 {
-    bool result = false;
-
-    for (int column = 0, columnCount = sourceModel()->columnCount(source_parent); column < columnCount; ++column) {
-        auto currentIndex = sourceModel()->index(source_row, column, source_parent);
-
-        const auto &titleValue = sourceModel()->data(currentIndex, AllAlbumsModel::TitleRole).toString();
-        const auto &artistValue = sourceModel()->data(currentIndex, AllAlbumsModel::ArtistRole).toString();
-        const auto &allArtistsValue = sourceModel()->data(currentIndex, AllAlbumsModel::AllArtistsRole).toStringList();
-        const auto &allTracksTitleValue = sourceModel()->data(currentIndex, AllAlbumsModel::AllTracksTitleRole).toStringList();
-        const auto maximumRatingValue = sourceModel()->data(currentIndex, AllAlbumsModel::HighestTrackRating).toInt();
-
-        if (maximumRatingValue < mFilterRating) {
-            result = false;
-            continue;
-        }
-
-        if (mFilterExpression.match(titleValue).hasMatch()) {
-            result = true;
-            continue;
-        }
-
-        if (mFilterExpression.match(artistValue).hasMatch()) {
-            result = true;
-            continue;
-        }
-
-        for (const auto &oneArtist : allArtistsValue) {
-            if (mFilterExpression.match(oneArtist).hasMatch()) {
-                result = true;
-                break;
-            }
-        }
-
-        if (result) {
-            continue;
-        }
-
-        if (!result) {
-            break;
-        }
+    const auto &currentIndex = sourceModel()->index(source_row, 0, source_parent);
+
+    const auto maximumRatingValue = sourceModel()->data(currentIndex, AllAlbumsModel::HighestTrackRating).toInt();
+
+    if (maximumRatingValue < mFilterRating) {
+        return false;
+    }
+
+    if (!mUseSearchResults) {
+        return true;
     }
 
-    return result;
+    return mMatchingAlbumIds.contains(sourceModel()->data(currentIndex, AllAlbumsModel::DatabaseIdRole).toULongLong());
 }
 
 
@@ -21,7 +21,8 @@
 #define ALBUMFILTERPROXYMODEL_H
 
 #include <QSortFilterProxyModel>
-#include <QRegularExpression>
+#include <QSet>
+#include <QList>
 
 class AlbumFilterProxyModel : public QSortFilterProxyModel
 {
@@ -54,6 +55,8 @@ public Q_SLOTS:
 
     void setFilterRating(int filterRating);
 
+    void setSearchResults(const QString &searchText, const QList<qulonglong> &albumIds);
+
 Q_SIGNALS:
 
     void filterTextChanged(QString filterText);
@@ -70,7 +73,9 @@ private:
 
     int mFilterRating = 0;
 
-    QRegularExpression mFilterExpression;
+    QSet<qulonglong> mMatchingAlbumIds;
+
+    bool mUseSearchResults = false;
 
 };
 
@@ -57,6 +57,10 @@ int AlbumModel::rowCount(const QModelIndex &parent) const
         return 0;
     }
 
+    if (!d->mCurrentAlbum.tracksLoaded()) {
+        return 0;
+    }
+
     return d->mCurrentAlbum.tracksCount();
 }
 
@@ -252,12 +256,23 @@ void AlbumModel::setAlbumData(MusicAlbum album)
         return;
     }
 
-    if (d->mCurrentAlbum.tracksCount() > 0) {
-        beginRemoveRows({}, 0, d->mCurrentAlbum.tracksCount() - 1);
+    if (rowCount() > 0) {
+        beginRemoveRows({}, 0, rowCount() - 1);
         d->mCurrentAlbum = {};
         endRemoveRows();
     }
 
+    if (!album.tracksLoaded()) {
+        d->mCurrentAlbum = album;
+
+        Q_EMIT albumDataChanged();
+
+        auto albumId = album.databaseId();
+        QTimer::singleShot(0, this, [this, albumId]() {Q_EMIT albumTracksRequested(albumId);});
+
+        return;
+    }
+
     beginInsertRows({}, 0, album.tracksCount() - 1);
     d->mCurrentAlbum = album;
     endInsertRows();
@@ -265,6 +280,22 @@ void AlbumModel::setAlbumData(MusicAlbum album)
     Q_EMIT albumDataChanged();
 }
 
+void AlbumModel::albumTracksLoaded(MusicAlbum album)
+{
+    if (d->mCurrentAlbum.tracksLoaded() || d->mCurrentAlbum.databaseId() != album.databaseId()) {
+        return;
+    }
+
+    if (album.tracksCount() == 0) {
+        d->mCurrentAlbum = album;
+        return;
+    }
+
+    beginInsertRows({}, 0, album.tracksCount() - 1);
+    d->mCurrentAlbum = album;
+    endInsertRows();
+}
+
 void AlbumModel::setTitle(QString title)
 {
     if (d->mTitle == title)
@@ -285,6 +316,10 @@ void AlbumModel::setAuthor(QString author)
 
 void AlbumModel::trackAdded(MusicAudioTrack newTrack)
 {
+    if (!d->mCurrentAlbum.tracksLoaded()) {
+        return;
+    }
+
     if (newTrack.albumName() != d->mCurrentAlbum.title()) {
         return;
     }
@@ -317,6 +352,10 @@ void AlbumModel::trackAdded(MusicAudioTrack newTrack)
 
 void AlbumModel::trackModified(MusicAudioTrack modifiedTrack)
 {
+    if (!d->mCurrentAlbum.tracksLoaded()) {
+        return;
+    }
+
     if (modifiedTrack.albumName() != d->mCurrentAlbum.title()) {
         return;
     }
@@ -333,6 +372,10 @@ void AlbumModel::trackModified(MusicAudioTrack modifiedTrack)
 
 void AlbumModel::trackRemoved(MusicAudioTrack removedTrack)
 {
+    if (!d->mCurrentAlbum.tracksLoaded()) {
+        return;
+    }
+
     if (removedTrack.albumName() != d->mCurrentAlbum.title()) {
         return;
     }
@@ -348,5 +391,26 @@ void AlbumModel::trackRemoved(MusicAudioTrack removedTrack)
     endRemoveRows();
 }
 
+void AlbumModel::tracksAdded(const QList<MusicAudioTrack> &newTracks)
+{
+    for (const auto &oneTrack : newTracks) {
+        trackAdded(oneTrack);
+    }
+}
+
+void AlbumModel::tracksModified(const QList<MusicAudioTrack> &modifiedTracks)
+{
+    for (const auto &oneTrack : modifiedTracks) {
+        trackModified(oneTrack);
+    }
+}
+
+void AlbumModel::tracksRemoved(const QList<MusicAudioTrack> &removedTracks)
+{
+    for (const auto &oneTrack : removedTracks) {
+        trackRemoved(oneTrack);
+    }
+}
+
 
 #include "moc_albummodel.cpp"
@@ -22,6 +22,7 @@
 
 #include <QAbstractItemModel>
 #include <QVector>
+#include <QList>
 #include <QHash>
 #include <QString>
 
@@ -113,10 +114,14 @@ Q_SIGNALS:
 
     void authorChanged();
 
+    void albumTracksRequested(qulonglong albumId);
+
 public Q_SLOTS:
 
     void setAlbumData(MusicAlbum album);
 
+    void albumTracksLoaded(MusicAlbum album);
+
     void setTitle(QString title);
 
     void setAuthor(QString author);
@@ -127,6 +132,12 @@ public Q_SLOTS:
 
     void trackRemoved(MusicAudioTrack removedTrack);
 
+    void tracksAdded(const QList<MusicAudioTrack> &newTracks);
+
+    void tracksModified(const QList<MusicAudioTrack> &modifiedTracks);
+
+    void tracksRemoved(const QList<MusicAudioTrack> &removedTracks);
+
 private:
 
     QVariant internalDataTrack(const MusicAudioTrack &track, int role, int rowIndex) const;
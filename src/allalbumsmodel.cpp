@@ -20,11 +20,13 @@
 #include "allalbumsmodel.h"
 #include "musicstatistics.h"
 #include "databaseinterface.h"
+#include "sortedmodelrows.h"
 
 #include <QUrl>
 #include <QTimer>
 #include <QPointer>
 #include <QVector>
+#include <QCollator>
 
 #include <algorithm>
 
@@ -34,11 +36,23 @@ public:
 
     AllAlbumsModelPrivate()
     {
+        mCollator.setCaseSensitivity(Qt::CaseInsensitive);
     }
 
-    QVector<MusicAlbum> mAllAlbums;
+    ModelSortKey sortKey(const MusicAlbum &album) const
+    {
+        if (mSortRole == AllAlbumsModel::TitleRole) {
+            return {{mCollator.sortKey(album.title()), mCollator.sortKey(album.artist())}, album.databaseId()};
+        }
+
+        return {{mCollator.sortKey(album.artist()), mCollator.sortKey(album.title())}, album.databaseId()};
+    }
 
-    int mAlbumCount = 0;
+    SortedModelRows<MusicAlbum> mAlbums;
+
+    QCollator mCollator;
+
+    AllAlbumsModel::ColumnsRoles mSortRole = AllAlbumsModel::ArtistRole;
 
 };
 
@@ -59,7 +73,7 @@ int AllAlbumsModel::rowCount(const QModelIndex &parent) const
         return albumCount;
     }
 
-    albumCount = d->mAlbumCount;
+    albumCount = d->mAlbums.size();
 
     return albumCount;
 }
@@ -77,6 +91,7 @@ QHash<int, QByteArray> AllAlbumsModel::roleNames() const
     roles[static_cast<int>(ColumnsRoles::IsSingleDiscAlbumRole)] = "isSingleDiscAlbum";
     roles[static_cast<int>(ColumnsRoles::AlbumDataRole)] = "albumData";
     roles[static_cast<int>(ColumnsRoles::HighestTrackRating)] = "highestTrackRating";
+    roles[static_cast<int>(ColumnsRoles::DatabaseIdRole)] = "databaseId";
 
     return roles;
 }
@@ -94,7 +109,7 @@ QVariant AllAlbumsModel::data(const QModelIndex &index, int role) const
 {
     auto result = QVariant();
 
-    const auto albumCount = d->mAlbumCount;
+    const auto albumCount = d->mAlbums.size();
 
     if (!index.isValid()) {
         return result;
@@ -133,39 +148,42 @@ QVariant AllAlbumsModel::internalDataAlbum(int albumIndex, int role) const
     switch(convertedRole)
     {
     case ColumnsRoles::TitleRole:
-        result = d->mAllAlbums[albumIndex].title();
+        result = d->mAlbums.at(albumIndex).title();
         break;
     case ColumnsRoles::AllTracksTitleRole:
-        result = d->mAllAlbums[albumIndex].allTracksTitle();
+        result = d->mAlbums.at(albumIndex).allTracksTitle();
         break;
     case ColumnsRoles::ArtistRole:
-        result = d->mAllAlbums[albumIndex].artist();
+        result = d->mAlbums.at(albumIndex).artist();
         break;
     case ColumnsRoles::AllArtistsRole:
-        result = d->mAllAlbums[albumIndex].allArtists().join(QStringLiteral(", "));
+        result = d->mAlbums.at(albumIndex).allArtists().join(QStringLiteral(", "));
         break;
     case ColumnsRoles::ImageRole:
     {
-        auto albumArt = d->mAllAlbums[albumIndex].albumArtURI();
+        auto albumArt = d->mAlbums.at(albumIndex).albumArtURI();
         if (albumArt.isValid()) {
             result = albumArt;
         }
         break;
     }
     case ColumnsRoles::CountRole:
-        result = d->mAllAlbums[albumIndex].tracksCount();
+        result = d->mAlbums.at(albumIndex).tracksCount();
         break;
     case ColumnsRoles::IdRole:
-        result = d->mAllAlbums[albumIndex].id();
+        result = d->mAlbums.at(albumIndex).id();
         break;
     case ColumnsRoles::IsSingleDiscAlbumRole:
-        result = d->mAllAlbums[albumIndex].isSingleDiscAlbum();
+        result = d->mAlbums.at(albumIndex).isSingleDiscAlbum();
         break;
     case ColumnsRoles::AlbumDataRole:
-        result = QVariant::fromValue(d->mAllAlbums[albumIndex]);
+        result = QVariant::fromValue(d->mAlbums.at(albumIndex));
         break;
     case ColumnsRoles::HighestTrackRating:
-        result = d->mAllAlbums[albumIndex].highestTrackRating();
+        result = d->mAlbums.at(albumIndex).highestTrackRating();
+        break;
+    case ColumnsRoles::DatabaseIdRole:
+        result = d->mAlbums.at(albumIndex).databaseId();
         break;
     }
 
@@ -205,44 +223,76 @@ int AllAlbumsModel::columnCount(const QModelIndex &parent) const
     return 1;
 }
 
+AllAlbumsModel::ColumnsRoles AllAlbumsModel::sortRole() const
+{
+    return d->mSortRole;
+}
+
 void AllAlbumsModel::albumAdded(MusicAlbum newAlbum)
 {
-    if (newAlbum.isValid()) {
-        beginInsertRows({}, d->mAllAlbums.size(), d->mAllAlbums.size());
-        d->mAllAlbums.push_back(newAlbum);
-        ++d->mAlbumCount;
-        endInsertRows();
-    }
+    albumsAdded({newAlbum});
 }
 
 void AllAlbumsModel::albumRemoved(MusicAlbum removedAlbum)
 {
-    auto removedAlbumIterator = std::find(d->mAllAlbums.begin(), d->mAllAlbums.end(), removedAlbum);
+    albumsRemoved({removedAlbum});
+}
 
-    if (removedAlbumIterator == d->mAllAlbums.end()) {
-        return;
-    }
+void AllAlbumsModel::albumModified(MusicAlbum modifiedAlbum)
+{
+    albumsModified({modifiedAlbum});
+}
 
-    int albumIndex = removedAlbumIterator - d->mAllAlbums.begin();
+void AllAlbumsModel::albumsAdded(const QList<MusicAlbum> &newAlbums)
+{
+    d->mAlbums.insert(newAlbums, [this](const MusicAlbum &oneAlbum) {
+        return d->sortKey(oneAlbum);
+    }, [this](int firstRow, int lastRow) {
+        beginInsertRows({}, firstRow, lastRow);
+    }, [this]() {
+        endInsertRows();
+    });
+}
 
-    beginRemoveRows({}, albumIndex, albumIndex);
-    d->mAllAlbums.erase(removedAlbumIterator);
-    --d->mAlbumCount;
-    endRemoveRows();
+void AllAlbumsModel::albumsRemoved(const QList<MusicAlbum> &removedAlbums)
+{
+    d->mAlbums.remove(removedAlbums, [this](int firstRow, int lastRow) {
+        beginRemoveRows({}, firstRow, lastRow);
+    }, [this]() {
+        endRemoveRows();
+    });
 }
 
-void AllAlbumsModel::albumModified(MusicAlbum modifiedAlbum)
+void AllAlbumsModel::albumsModified(const QList<MusicAlbum> &modifiedAlbums)
 {
-    auto modifiedAlbumIterator = std::find(d->mAllAlbums.begin(), d->mAllAlbums.end(), modifiedAlbum);
+    d->mAlbums.modify(modifiedAlbums, [this](const MusicAlbum &oneAlbum) {
+        return d->sortKey(oneAlbum);
+    }, [this](int sourceRow, int destinationRow) {
+        beginMoveRows({}, sourceRow, sourceRow, {}, destinationRow);
+    }, [this]() {
+        endMoveRows();
+    }, [this](int firstRow, int lastRow) {
+        Q_EMIT dataChanged(index(firstRow, 0), index(lastRow, 0));
+    });
+}
 
-    if (modifiedAlbumIterator == d->mAllAlbums.end()) {
+void AllAlbumsModel::setSortRole(ColumnsRoles sortRole)
+{
+    if (d->mSortRole == sortRole) {
         return;
     }
 
-    int albumIndex = modifiedAlbumIterator - d->mAllAlbums.begin();
-    d->mAllAlbums[albumIndex] = modifiedAlbum;
+    beginResetModel();
+
+    d->mSortRole = sortRole;
+
+    d->mAlbums.sort([this](const MusicAlbum &oneAlbum) {
+        return d->sortKey(oneAlbum);
+    });
+
+    endResetModel();
 
-    Q_EMIT dataChanged(index(albumIndex, 0), index(albumIndex, 0));
+    Q_EMIT sortRoleChanged(d->mSortRole);
 }
 
 #include "moc_allalbumsmodel.cpp"
@@ -22,6 +22,7 @@
 
 #include <QAbstractItemModel>
 #include <QVector>
+#include <QList>
 #include <QHash>
 #include <QString>
 
@@ -36,6 +37,11 @@ class AllAlbumsModel : public QAbstractItemModel
 {
     Q_OBJECT
 
+    Q_PROPERTY(ColumnsRoles sortRole
+               READ sortRole
+               WRITE setSortRole
+               NOTIFY sortRoleChanged)
+
 public:
 
     enum ColumnsRoles {
@@ -49,6 +55,7 @@ public:
         IsSingleDiscAlbumRole = IdRole + 1,
         AlbumDataRole = IsSingleDiscAlbumRole + 1,
         HighestTrackRating = AlbumDataRole + 1,
+        DatabaseIdRole = HighestTrackRating + 1,
     };
 
     Q_ENUM(ColumnsRoles)
@@ -71,6 +78,12 @@ public:
 
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
 
+    ColumnsRoles sortRole() const;
+
+Q_SIGNALS:
+
+    void sortRoleChanged(ColumnsRoles sortRole);
+
 public Q_SLOTS:
 
     void albumAdded(MusicAlbum newAlbum);
@@ -79,6 +92,14 @@ public Q_SLOTS:
 
     void albumModified(MusicAlbum modifiedAlbum);
 
+    void albumsAdded(const QList<MusicAlbum> &newAlbums);
+
+    void albumsRemoved(const QList<MusicAlbum> &removedAlbums);
+
+    void albumsModified(const QList<MusicAlbum> &modifiedAlbums);
+
+    void setSortRole(ColumnsRoles sortRole);
+
 private:
 
     QVariant internalDataAlbum(int albumIndex, int role) const;
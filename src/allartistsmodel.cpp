@@ -20,11 +20,13 @@
 #include "allartistsmodel.h"
 #include "databaseinterface.h"
 #include "musicartist.h"
+#include "sortedmodelrows.h"
 
 #include <QUrl>
 #include <QTimer>
 #include <QPointer>
 #include <QVector>
+#include <QCollator>
 
 class AllArtistsModelPrivate
 {
@@ -32,11 +34,17 @@ public:
 
     AllArtistsModelPrivate()
     {
+        mCollator.setCaseSensitivity(Qt::CaseInsensitive);
     }
 
-    QVector<MusicArtist> mAllArtists;
+    ModelSortKey sortKey(const MusicArtist &artist) const
+    {
+        return {{mCollator.sortKey(artist.name())}, artist.databaseId()};
+    }
 
-    int mArtistsCount = 0;
+    SortedModelRows<MusicArtist> mArtists;
+
+    QCollator mCollator;
 
     bool mUseLocalIcons = false;
 
@@ -59,7 +67,7 @@ int AllArtistsModel::rowCount(const QModelIndex &parent) const
         return artistCount;
     }
 
-    artistCount = d->mArtistsCount;
+    artistCount = d->mArtists.size();
 
     return artistCount;
 }
@@ -89,7 +97,7 @@ QVariant AllArtistsModel::data(const QModelIndex &index, int role) const
 {
     auto result = QVariant();
 
-    const auto artistsCount = d->mArtistsCount;
+    const auto artistsCount = d->mArtists.size();
 
     if (!index.isValid()) {
         return result;
@@ -120,10 +128,10 @@ QVariant AllArtistsModel::data(const QModelIndex &index, int role) const
     switch(convertedRole)
     {
     case ColumnsRoles::NameRole:
-        result = d->mAllArtists[index.row()].name();
+        result = d->mArtists.at(index.row()).name();
         break;
     case ColumnsRoles::ArtistsCountRole:
-        result = d->mAllArtists[index.row()].albumsCount();
+        result = d->mArtists.at(index.row()).albumsCount();
         break;
     case ColumnsRoles::ImageRole:
         break;
@@ -169,33 +177,50 @@ int AllArtistsModel::columnCount(const QModelIndex &parent) const
 
 void AllArtistsModel::artistAdded(MusicArtist newArtist)
 {
-    if (newArtist.isValid()) {
-        beginInsertRows({}, d->mAllArtists.size(), d->mAllArtists.size());
-        d->mAllArtists.push_back(newArtist);
-        ++d->mArtistsCount;
-        endInsertRows();
-    }
+    artistsAdded({newArtist});
 }
 
 void AllArtistsModel::artistRemoved(MusicArtist removedArtist)
 {
-    auto removedArtistIterator = std::find(d->mAllArtists.begin(), d->mAllArtists.end(), removedArtist);
+    artistsRemoved({removedArtist});
+}
 
-    if (removedArtistIterator == d->mAllArtists.end()) {
-        return;
-    }
+void AllArtistsModel::artistModified(MusicArtist modifiedArtist)
+{
+    artistsModified({modifiedArtist});
+}
 
-    int artistIndex = removedArtistIterator - d->mAllArtists.begin();
+void AllArtistsModel::artistsAdded(const QList<MusicArtist> &newArtists)
+{
+    d->mArtists.insert(newArtists, [this](const MusicArtist &oneArtist) {
+        return d->sortKey(oneArtist);
+    }, [this](int firstRow, int lastRow) {
+        beginInsertRows({}, firstRow, lastRow);
+    }, [this]() {
+        endInsertRows();
+    });
+}
 
-    beginRemoveRows({}, artistIndex, artistIndex);
-    d->mAllArtists.erase(removedArtistIterator);
-    --d->mArtistsCount;
-    endRemoveRows();
+void AllArtistsModel::artistsRemoved(const QList<MusicArtist> &removedArtists)
+{
+    d->mArtists.remove(removedArtists, [this](int firstRow, int lastRow) {
+        beginRemoveRows({}, firstRow, lastRow);
+    }, [this]() {
+        endRemoveRows();
+    });
 }
 
-void AllArtistsModel::artistModified(MusicArtist modifiedArtist)
+void AllArtistsModel::artistsModified(const QList<MusicArtist> &modifiedArtists)
 {
-    Q_UNUSED(modifiedArtist);
+    d->mArtists.modify(modifiedArtists, [this](const MusicArtist &oneArtist) {
+        return d->sortKey(oneArtist);
+    }, [this](int sourceRow, int destinationRow) {
+        beginMoveRows({}, sourceRow, sourceRow, {}, destinationRow);
+    }, [this]() {
+        endMoveRows();
+    }, [this](int firstRow, int lastRow) {
+        Q_EMIT dataChanged(index(firstRow, 0), index(lastRow, 0));
+    });
 }
 
 #include "moc_allartistsmodel.cpp"
@@ -22,6 +22,7 @@
 
 #include <QAbstractItemModel>
 #include <QVector>
+#include <QList>
 #include <QHash>
 #include <QString>
 
@@ -71,6 +72,12 @@ public Q_SLOTS:
 
     void artistModified(MusicArtist modifiedArtist);
 
+    void artistsAdded(const QList<MusicArtist> &newArtists);
+
+    void artistsRemoved(const QList<MusicArtist> &removedArtists);
+
+    void artistsModified(const QList<MusicArtist> &modifiedArtists);
+
 private:
 
     AllArtistsModelPrivate *d;
@@ -20,6 +20,7 @@
 #include "localbaloofilelisting.h"
 
 #include "musicaudiotrack.h"
+#include "scanprogress.h"
 
 #include <Baloo/Query>
 #include <Baloo/File>
@@ -32,26 +33,17 @@
 
 #include <QThread>
 #include <QHash>
+#include <QSet>
 #include <QFileInfo>
 #include <QDir>
 #include <QDebug>
 
-#include <algorithm>
-
 class LocalBalooFileListingPrivate
 {
 public:
 
     Baloo::Query mQuery;
 
-    QHash<QString, QVector<MusicAudioTrack>> mAllAlbums;
-
-    QHash<QString, QVector<MusicAudioTrack>> mNewAlbums;
-
-    QList<MusicAudioTrack> mNewTracks;
-
-    QHash<QString, QUrl> mAllAlbumCover;
-
 };
 
 LocalBalooFileListing::LocalBalooFileListing(QObject *parent) : AbstractFileListing(QStringLiteral("baloo"), parent), d(new LocalBalooFileListingPrivate)
@@ -99,20 +91,51 @@ void LocalBalooFileListing::executeInit()
 void LocalBalooFileListing::triggerRefreshOfContent()
 {
     auto resultIterator = d->mQuery.exec();
+
+    scanQueryResults([&resultIterator](QString &fileName) {
+        if (!resultIterator.next()) {
+            return false;
+        }
+
+        fileName = resultIterator.filePath();
+
+        return true;
+    });
+}
+
+void LocalBalooFileListing::scanQueryResults(const std::function<bool(QString&)> &nextResult)
+{
     auto newFiles = QList<MusicAudioTrack>();
+    auto knownFiles = QSet<QString>();
+    auto newFileName = QString();
 
-    while(resultIterator.next()) {
-        const auto &newFileUrl = QUrl::fromLocalFile(resultIterator.filePath());
-        auto scanFileInfo = QFileInfo(resultIterator.filePath());
+    while(!QThread::currentThread()->isInterruptionRequested() && waitForScanTurn() && nextResult(newFileName)) {
+        if (knownFiles.contains(newFileName)) {
+            continue;
+        }
+        knownFiles.insert(newFileName);
+
+        const auto &newFileUrl = QUrl::fromLocalFile(newFileName);
+        auto scanFileInfo = QFileInfo(newFileName);
         const auto currentDirectory = QUrl::fromLocalFile(scanFileInfo.absoluteDir().absolutePath());
 
         addFileInDirectory(newFileUrl, currentDirectory);
 
         const auto &newTrack = scanOneFile(newFileUrl);
 
+        if (scanProgress()) {
+            scanProgress()->addDiscoveredFiles(1);
+            scanProgress()->addExtractedFiles(1, 0);
+        }
+
         if (newTrack.isValid()) {
             newFiles.push_back(newTrack);
         }
+
+        if (newFiles.size() >= tracksListBatchSize()) {
+            emitNewFiles(newFiles);
+            newFiles.clear();
+        }
     }
 
     if (!newFiles.isEmpty()) {
@@ -145,10 +168,7 @@ MusicAudioTrack LocalBalooFileListing::scanOneFile(QUrl scanFile)
     auto fileData = KFileMetaData::UserMetaData(fileName);
 
     if (albumProperty != allProperties.end()) {
-        auto albumValue = albumProperty->toString();
-        auto &allTracks = d->mAllAlbums[albumValue];
-
-        newTrack.setAlbumName(albumValue);
+        newTrack.setAlbumName(albumProperty->toString());
 
         if (artistProperty != allProperties.end()) {
             newTrack.setArtist(artistProperty->toString());
@@ -182,23 +202,6 @@ MusicAudioTrack LocalBalooFileListing::scanOneFile(QUrl scanFile)
 
         newTrack.setResourceURI(scanFile);
 
-        QFileInfo coverFilePath(scanFileInfo.dir().filePath(QStringLiteral("cover.jpg")));
-        if (coverFilePath.exists()) {
-            d->mAllAlbumCover[albumValue] = QUrl::fromLocalFile(coverFilePath.absoluteFilePath());
-        }
-
-        auto itTrack = std::find(allTracks.begin(), allTracks.end(), newTrack);
-        if (itTrack == allTracks.end()) {
-            allTracks.push_back(newTrack);
-            d->mNewTracks.push_back(newTrack);
-            d->mNewAlbums[newTrack.albumName()].push_back(newTrack);
-
-            auto &newTracks = d->mAllAlbums[newTrack.albumName()];
-
-            std::sort(allTracks.begin(), allTracks.end());
-            std::sort(newTracks.begin(), newTracks.end());
-        }
-
         newTrack.setValid(true);
     }
 
@@ -29,6 +29,7 @@
 #include <QVector>
 
 #include <memory>
+#include <functional>
 
 class LocalBalooFileListingPrivate;
 class MusicAudioTrack;
@@ -52,14 +53,18 @@ private Q_SLOTS:
 
     void newBalooFile(QString fileName);
 
+protected:
+
+    void scanQueryResults(const std::function<bool(QString&)> &nextResult);
+
+    MusicAudioTrack scanOneFile(QUrl scanFile) override;
+
 private:
 
     void executeInit() override;
 
     void triggerRefreshOfContent() override;
 
-    MusicAudioTrack scanOneFile(QUrl scanFile) override;
-
     std::unique_ptr<LocalBalooFileListingPrivate> d;
 
 };
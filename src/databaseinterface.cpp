@@ -29,10 +29,32 @@
 
 #include <QMutex>
 #include <QVariant>
+#include <QStringList>
+#include <QRegularExpression>
 #include <QDebug>
 
 #include <algorithm>
 
+static const int sqliteMaximumBoundValues = 999;
+
+static void splitFileName(const QString &fullName, QString &directoryPath, QString &baseName)
+{
+    const auto separatorIndex = fullName.lastIndexOf(QLatin1Char('/'));
+
+    directoryPath = fullName.left(separatorIndex + 1);
+    baseName = fullName.mid(separatorIndex + 1);
+}
+
+static void bindFileName(QSqlQuery &query, const QUrl &fileName)
+{
+    auto directoryPath = QString();
+    auto baseName = QString();
+    splitFileName(fileName.toString(), directoryPath, baseName);
+
+    query.bindValue(QStringLiteral(":directoryPath"), directoryPath);
+    query.bindValue(QStringLiteral(":fileName"), baseName);
+}
+
 class DatabaseInterfacePrivate
 {
 public:
@@ -43,18 +65,28 @@ public:
           mInsertAlbumQuery(mTracksDatabase), mSelectTrackIdFromTitleAlbumIdArtistQuery(mTracksDatabase),
           mInsertTrackQuery(mTracksDatabase), mSelectAlbumTrackCountQuery(mTracksDatabase),
           mUpdateAlbumQuery(mTracksDatabase), mSelectTracksFromArtist(mTracksDatabase),
-          mSelectTrackFromIdQuery(mTracksDatabase), mSelectCountAlbumsForArtistQuery(mTracksDatabase),
+          mSelectTrackFromIdQuery(mTracksDatabase), mUpdateArtistAlbumsCountQuery(mTracksDatabase),
           mSelectTrackIdFromTitleAlbumArtistQuery(mTracksDatabase), mSelectAllAlbumsQuery(mTracksDatabase),
           mSelectAllAlbumsFromArtistQuery(mTracksDatabase), mSelectAllArtistsQuery(mTracksDatabase),
-          mInsertArtistsQuery(mTracksDatabase), mSelectArtistByNameQuery(mTracksDatabase),
+          mInsertArtistsQuery(mTracksDatabase),
           mSelectArtistQuery(mTracksDatabase), mSelectTrackFromFilePathQuery(mTracksDatabase),
           mRemoveTrackQuery(mTracksDatabase), mRemoveAlbumQuery(mTracksDatabase),
           mRemoveArtistQuery(mTracksDatabase), mSelectAllTracksQuery(mTracksDatabase),
           mInsertTrackMapping(mTracksDatabase), mSelectAllTracksFromSourceQuery(mTracksDatabase),
-          mInsertMusicSource(mTracksDatabase), mSelectMusicSource(mTracksDatabase),
-          mUpdateIsSingleDiscAlbumFromIdQuery(mTracksDatabase), mSelectAllInvalidTracksFromSourceQuery(mTracksDatabase),
-          mInitialUpdateTracksValidity(mTracksDatabase), mUpdateTrackMapping(mTracksDatabase),
-          mSelectTracksMapping(mTracksDatabase), mSelectTracksMappingPriority(mTracksDatabase)
+          mInsertMusicSource(mTracksDatabase),
+          mUpdateIsSingleDiscAlbumFromIdQuery(mTracksDatabase),
+          mUpdateTrackFileStat(mTracksDatabase), mUpdateTrackMapping(mTracksDatabase),
+          mSelectTracksMapping(mTracksDatabase), mSelectTracksMappingPriority(mTracksDatabase),
+          mSelectAlbumTracksKeysQuery(mTracksDatabase), mUpdateAlbumSearchQuery(mTracksDatabase),
+          mSearchAlbumsQuery(mTracksDatabase), mSearchArtistsQuery(mTracksDatabase),
+          mSearchTracksQuery(mTracksDatabase), mSelectTrackFilesFromSourceQuery(mTracksDatabase),
+          mSelectSourceScanGenerationQuery(mTracksDatabase), mSelectScannedDirectoriesQuery(mTracksDatabase),
+          mUpdateDirectoryScanGenerationQuery(mTracksDatabase), mUpdateTrackScanGenerationQuery(mTracksDatabase),
+          mSelectUnseenTrackFilesQuery(mTracksDatabase), mRemoveUnseenTrackFilesQuery(mTracksDatabase),
+          mRemoveScannedDirectoryQuery(mTracksDatabase),
+          mSelectDirectoryTreeTrackFilesQuery(mTracksDatabase), mRemoveDirectoryTreeTracksMappingQuery(mTracksDatabase),
+          mRemoveDirectoryTreeScansQuery(mTracksDatabase), mRemoveDirectoryTreeQuery(mTracksDatabase),
+          mInsertDirectoryQuery(mTracksDatabase), mSelectAlbumCoversQuery(mTracksDatabase)
     {
     }
 
@@ -80,7 +112,7 @@ public:
 
     QSqlQuery mSelectTrackFromIdQuery;
 
-    QSqlQuery mSelectCountAlbumsForArtistQuery;
+    QSqlQuery mUpdateArtistAlbumsCountQuery;
 
     QSqlQuery mSelectTrackIdFromTitleAlbumArtistQuery;
 
@@ -92,8 +124,6 @@ public:
 
     QSqlQuery mInsertArtistsQuery;
 
-    QSqlQuery mSelectArtistByNameQuery;
-
     QSqlQuery mSelectArtistQuery;
 
     QSqlQuery mSelectTrackFromFilePathQuery;
@@ -112,13 +142,9 @@ public:
 
     QSqlQuery mInsertMusicSource;
 
-    QSqlQuery mSelectMusicSource;
-
     QSqlQuery mUpdateIsSingleDiscAlbumFromIdQuery;
 
-    QSqlQuery mSelectAllInvalidTracksFromSourceQuery;
-
-    QSqlQuery mInitialUpdateTracksValidity;
+    QSqlQuery mUpdateTrackFileStat;
 
     QSqlQuery mUpdateTrackMapping;
 
@@ -126,6 +152,88 @@ public:
 
     QSqlQuery mSelectTracksMappingPriority;
 
+    QSqlQuery mSelectAlbumTracksKeysQuery;
+
+    QSqlQuery mUpdateAlbumSearchQuery;
+
+    QSqlQuery mSearchAlbumsQuery;
+
+    QSqlQuery mSearchArtistsQuery;
+
+    QSqlQuery mSearchTracksQuery;
+
+    QSqlQuery mSelectTrackFilesFromSourceQuery;
+
+    QSqlQuery mSelectSourceScanGenerationQuery;
+
+    QSqlQuery mSelectScannedDirectoriesQuery;
+
+    QSqlQuery mUpdateDirectoryScanGenerationQuery;
+
+    QSqlQuery mUpdateTrackScanGenerationQuery;
+
+    QSqlQuery mSelectUnseenTrackFilesQuery;
+
+    QSqlQuery mRemoveUnseenTrackFilesQuery;
+
+    QSqlQuery mRemoveScannedDirectoryQuery;
+
+    QSqlQuery mSelectDirectoryTreeTrackFilesQuery;
+
+    QSqlQuery mRemoveDirectoryTreeTracksMappingQuery;
+
+    QSqlQuery mRemoveDirectoryTreeScansQuery;
+
+    QSqlQuery mRemoveDirectoryTreeQuery;
+
+    QSqlQuery mInsertDirectoryQuery;
+
+    QSqlQuery mSelectAlbumCoversQuery;
+
+    QHash<QString, qulonglong> mArtistIds;
+
+    QHash<qulonglong, QString> mArtistNames;
+
+    QHash<QPair<QString, qulonglong>, qulonglong> mAlbumIds;
+
+    QHash<qulonglong, QPair<QString, qulonglong>> mAlbumKeys;
+
+    QHash<QString, qulonglong> mDiscoverIds;
+
+    QHash<qulonglong, qulonglong> mScanGenerations;
+
+    QHash<qulonglong, QHash<qulonglong, qint64>> mScannedDirectories;
+
+    QHash<qulonglong, QHash<QString, qint64>> mChangedDirectories;
+
+    QHash<QString, qulonglong> mDirectoryIds;
+
+    QList<MusicArtist> mAddedArtists;
+
+    QList<MusicAlbum> mAddedAlbums;
+
+    QList<MusicAudioTrack> mAddedTracks;
+
+    QList<MusicArtist> mModifiedArtists;
+
+    QList<MusicAlbum> mModifiedAlbums;
+
+    QList<MusicAudioTrack> mModifiedTracks;
+
+    QList<MusicArtist> mRemovedArtists;
+
+    QList<MusicAlbum> mRemovedAlbums;
+
+    QList<MusicAudioTrack> mRemovedTracks;
+
+    QList<qulonglong> mPendingAlbumUpdates;
+
+    QSet<qulonglong> mPendingAlbumIds;
+
+    QList<qulonglong> mPendingArtistUpdates;
+
+    QSet<qulonglong> mPendingArtistIds;
+
     qulonglong mAlbumId = 1;
 
     qulonglong mArtistId = 1;
@@ -134,6 +242,8 @@ public:
 
     qulonglong mDiscoverId = 1;
 
+    qulonglong mDirectoryId = 1;
+
     bool mInitFinished = false;
 
 };
@@ -157,10 +267,11 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
 
     if (!databaseFileName.isEmpty()) {
         tracksDatabase.setDatabaseName(QStringLiteral("file:") + databaseFileName);
+        tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
     } else {
         tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
+        tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
     }
-    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
 
     auto result = tracksDatabase.open();
     if (result) {
@@ -170,6 +281,18 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     }
     qDebug() << "DatabaseInterface::init" << (tracksDatabase.driver()->hasFeature(QSqlDriver::Transactions) ? "yes" : "no");
 
+    if (result && !databaseFileName.isEmpty()) {
+        QSqlQuery journalModeQuery(tracksDatabase);
+
+        if (!journalModeQuery.exec(QStringLiteral("PRAGMA journal_mode = WAL"))) {
+            qDebug() << "DatabaseInterface::init" << journalModeQuery.lastQuery() << journalModeQuery.lastError();
+        }
+
+        if (!journalModeQuery.exec(QStringLiteral("PRAGMA synchronous = NORMAL"))) {
+            qDebug() << "DatabaseInterface::init" << journalModeQuery.lastQuery() << journalModeQuery.lastError();
+        }
+    }
+
     d = new DatabaseInterfacePrivate(tracksDatabase);
 
     initDatabase();
@@ -180,6 +303,30 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     }
 }
 
+void DatabaseInterface::initReadOnly(const QString &dbName, const QString &databaseFileName)
+{
+    QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), dbName);
+
+    tracksDatabase.setDatabaseName(QStringLiteral("file:") + databaseFileName);
+    tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+
+    auto result = tracksDatabase.open();
+    if (!result) {
+        qDebug() << "DatabaseInterface::initReadOnly" << tracksDatabase.lastError();
+
+        return;
+    }
+
+    d = new DatabaseInterfacePrivate(tracksDatabase);
+
+    initRequest();
+}
+
+bool DatabaseInterface::isInitialized() const
+{
+    return d && d->mInitFinished;
+}
+
 MusicAlbum DatabaseInterface::albumFromTitle(QString title)
 {
     auto result = MusicAlbum();
@@ -191,6 +338,10 @@ MusicAlbum DatabaseInterface::albumFromTitle(QString title)
 
     result = internalAlbumFromTitle(title);
 
+    if (result.isValid()) {
+        result.setTracks(fetchTracks(result.databaseId()));
+    }
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return result;
@@ -308,60 +459,52 @@ QList<MusicAudioTrack> DatabaseInterface::allTracksFromSource(QString musicSourc
     return result;
 }
 
-QList<MusicAudioTrack> DatabaseInterface::allInvalidTracksFromSource(QString musicSource) const
+void DatabaseInterface::askRestoredTracks(const QString &musicSource)
 {
-    auto result = QList<MusicAudioTrack>();
+    auto restoredFiles = QList<MusicAudioTrack>();
 
     if (!d) {
-        return result;
+        Q_EMIT restoredTracks(musicSource, restoredFiles);
+        return;
     }
 
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return result;
+        Q_EMIT restoredTracks(musicSource, restoredFiles);
+        return;
     }
 
-    d->mSelectAllInvalidTracksFromSourceQuery.bindValue(QStringLiteral(":source"), musicSource);
+    d->mSelectTrackFilesFromSourceQuery.bindValue(QStringLiteral(":source"), musicSource);
 
-    auto queryResult = d->mSelectAllInvalidTracksFromSourceQuery.exec();
+    auto queryResult = d->mSelectTrackFilesFromSourceQuery.exec();
 
-    if (!queryResult || !d->mSelectAllInvalidTracksFromSourceQuery.isSelect() || !d->mSelectAllInvalidTracksFromSourceQuery.isActive()) {
-        qDebug() << "DatabaseInterface::allAlbums" << d->mSelectAllInvalidTracksFromSourceQuery.lastQuery();
-        qDebug() << "DatabaseInterface::allAlbums" << d->mSelectAllInvalidTracksFromSourceQuery.boundValues();
-        qDebug() << "DatabaseInterface::allAlbums" << d->mSelectAllInvalidTracksFromSourceQuery.lastError();
-
-        return result;
-    }
+    if (!queryResult || !d->mSelectTrackFilesFromSourceQuery.isSelect() || !d->mSelectTrackFilesFromSourceQuery.isActive()) {
+        qDebug() << "DatabaseInterface::askRestoredTracks" << d->mSelectTrackFilesFromSourceQuery.lastQuery();
+        qDebug() << "DatabaseInterface::askRestoredTracks" << d->mSelectTrackFilesFromSourceQuery.boundValues();
+        qDebug() << "DatabaseInterface::askRestoredTracks" << d->mSelectTrackFilesFromSourceQuery.lastError();
+    } else {
+        while(d->mSelectTrackFilesFromSourceQuery.next()) {
+            auto restoredFile = MusicAudioTrack();
 
-    while(d->mSelectAllInvalidTracksFromSourceQuery.next()) {
-        auto newTrack = MusicAudioTrack();
+            const auto &currentRecord = d->mSelectTrackFilesFromSourceQuery.record();
 
-        const auto &currentRecord = d->mSelectAllInvalidTracksFromSourceQuery.record();
+            restoredFile.setResourceURI(currentRecord.value(0).toUrl());
 
-        newTrack.setDatabaseId(currentRecord.value(0).toULongLong());
-        newTrack.setTitle(currentRecord.value(1).toString());
-        newTrack.setParentId(currentRecord.value(2).toString());
-        newTrack.setArtist(currentRecord.value(3).toString());
-        newTrack.setAlbumArtist(currentRecord.value(4).toString());
-        newTrack.setResourceURI(currentRecord.value(5).toUrl());
-        newTrack.setTrackNumber(currentRecord.value(6).toInt());
-        newTrack.setDiscNumber(currentRecord.value(7).toInt());
-        newTrack.setDuration(QTime::fromMSecsSinceStartOfDay(currentRecord.value(8).toInt()));
-        newTrack.setAlbumName(currentRecord.value(9).toString());
-        newTrack.setRating(currentRecord.value(10).toInt());
-        newTrack.setValid(true);
+            if (!currentRecord.isNull(2)) {
+                restoredFile.setFileSize(currentRecord.value(1).toLongLong());
+                restoredFile.setFileModificationTime(QDateTime::fromMSecsSinceEpoch(currentRecord.value(2).toLongLong()));
+                restoredFile.setFileInode(currentRecord.value(3).toULongLong());
+            }
 
-        result.push_back(newTrack);
+            restoredFiles.push_back(restoredFile);
+        }
     }
 
-    d->mSelectAllInvalidTracksFromSourceQuery.finish();
+    d->mSelectTrackFilesFromSourceQuery.finish();
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    finishTransaction();
 
-    return result;
+    Q_EMIT restoredTracks(musicSource, restoredFiles);
 }
 
 QList<MusicAlbum> DatabaseInterface::allAlbums()
@@ -387,23 +530,65 @@ QList<MusicAlbum> DatabaseInterface::allAlbums()
         return result;
     }
 
-    while(d->mSelectAllAlbumsQuery.next()) {
-        auto newAlbum = MusicAlbum();
+    auto newAlbum = MusicAlbum();
+    auto albumTrackIds = QList<qulonglong>();
+    auto albumTracksTitle = QStringList();
+    auto albumArtists = QStringList();
+    auto albumHighestTrackRating = 0;
 
-        const auto &currentRecord = d->mSelectAllAlbumsQuery.record();
+    auto storeAlbumSummary = [&]() {
+        std::sort(albumTracksTitle.begin(), albumTracksTitle.end());
+        albumTracksTitle.erase(std::unique(albumTracksTitle.begin(), albumTracksTitle.end()), albumTracksTitle.end());
+
+        std::sort(albumArtists.begin(), albumArtists.end());
+        albumArtists.erase(std::unique(albumArtists.begin(), albumArtists.end()), albumArtists.end());
 
-        newAlbum.setDatabaseId(currentRecord.value(0).toULongLong());
-        newAlbum.setTitle(currentRecord.value(1).toString());
-        newAlbum.setId(currentRecord.value(2).toString());
-        newAlbum.setArtist(currentRecord.value(3).toString());
-        newAlbum.setAlbumArtURI(currentRecord.value(4).toUrl());
-        newAlbum.setTracksCount(currentRecord.value(5).toInt());
-        newAlbum.setIsSingleDiscAlbum(currentRecord.value(6).toBool());
-        newAlbum.setTracks(fetchTracks(newAlbum.databaseId()));
-        newAlbum.setTrackIds(fetchTrackIds(newAlbum.databaseId()));
-        newAlbum.setValid(true);
+        newAlbum.setTrackIds(albumTrackIds);
+        newAlbum.setAllTracksTitle(albumTracksTitle);
+        newAlbum.setAllArtists(albumArtists);
+        newAlbum.setHighestTrackRating(albumHighestTrackRating);
 
         result.push_back(newAlbum);
+    };
+
+    while(d->mSelectAllAlbumsQuery.next()) {
+        const auto &currentRecord = d->mSelectAllAlbumsQuery.record();
+
+        auto albumId = currentRecord.value(0).toULongLong();
+
+        if (!newAlbum.isValid() || newAlbum.databaseId() != albumId) {
+            if (newAlbum.isValid()) {
+                storeAlbumSummary();
+            }
+
+            newAlbum = MusicAlbum();
+            albumTrackIds.clear();
+            albumTracksTitle.clear();
+            albumArtists.clear();
+            albumHighestTrackRating = 0;
+
+            newAlbum.setDatabaseId(albumId);
+            newAlbum.setTitle(currentRecord.value(1).toString());
+            newAlbum.setId(currentRecord.value(2).toString());
+            newAlbum.setArtist(currentRecord.value(3).toString());
+            newAlbum.setAlbumArtURI(currentRecord.value(4).toUrl());
+            newAlbum.setTracksCount(currentRecord.value(5).toInt());
+            newAlbum.setIsSingleDiscAlbum(currentRecord.value(6).toBool());
+            newAlbum.setValid(true);
+        }
+
+        if (currentRecord.isNull(7) || currentRecord.isNull(10)) {
+            continue;
+        }
+
+        albumTrackIds.push_back(currentRecord.value(7).toULongLong());
+        albumTracksTitle.push_back(currentRecord.value(8).toString());
+        albumArtists.push_back(currentRecord.value(9).toString());
+        albumHighestTrackRating = std::max(albumHighestTrackRating, currentRecord.value(11).toInt());
+    }
+
+    if (newAlbum.isValid()) {
+        storeAlbumSummary();
     }
 
     d->mSelectAllAlbumsQuery.finish();
@@ -429,8 +614,6 @@ QList<MusicArtist> DatabaseInterface::allArtists() const
         return result;
     }
 
-    QString currentFilter(QStringLiteral("%%1%"));
-
     auto queryResult = d->mSelectAllArtistsQuery.exec();
 
     if (!queryResult || !d->mSelectAllArtistsQuery.isSelect() || !d->mSelectAllArtistsQuery.isActive()) {
@@ -455,31 +638,9 @@ QList<MusicArtist> DatabaseInterface::allArtists() const
 
         newArtist.setDatabaseId(currentRecord.value(0).toULongLong());
         newArtist.setName(currentRecord.value(1).toString());
+        newArtist.setAlbumsCount(currentRecord.value(2).toInt());
         newArtist.setValid(true);
 
-        d->mSelectCountAlbumsForArtistQuery.bindValue(QStringLiteral(":artistName"), newArtist.name());
-
-        auto queryResult = d->mSelectCountAlbumsForArtistQuery.exec();
-
-        if (!queryResult || !d->mSelectCountAlbumsForArtistQuery.isSelect() || !d->mSelectCountAlbumsForArtistQuery.isActive() || !d->mSelectCountAlbumsForArtistQuery.next()) {
-            qDebug() << "DatabaseInterface::allArtists" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::allArtists" << d->mSelectCountAlbumsForArtistQuery.boundValues();
-            qDebug() << "DatabaseInterface::allArtists" << d->mSelectCountAlbumsForArtistQuery.lastError();
-
-            d->mSelectCountAlbumsForArtistQuery.finish();
-
-            transactionResult = finishTransaction();
-            if (!transactionResult) {
-                return result;
-            }
-
-            return result;
-        }
-
-        newArtist.setAlbumsCount(d->mSelectCountAlbumsForArtistQuery.record().value(0).toInt());
-
-        d->mSelectCountAlbumsForArtistQuery.finish();
-
         result.push_back(newArtist);
     }
 
@@ -544,28 +705,11 @@ MusicArtist DatabaseInterface::internalArtistFromId(qulonglong artistId) const
 
     result.setDatabaseId(currentRecord.value(0).toULongLong());
     result.setName(currentRecord.value(1).toString());
+    result.setAlbumsCount(currentRecord.value(2).toInt());
     result.setValid(true);
 
     d->mSelectArtistQuery.finish();
 
-    d->mSelectCountAlbumsForArtistQuery.bindValue(QStringLiteral(":artistName"), result.name());
-
-    queryResult = d->mSelectCountAlbumsForArtistQuery.exec();
-
-    if (!queryResult || !d->mSelectCountAlbumsForArtistQuery.isSelect() || !d->mSelectCountAlbumsForArtistQuery.isActive() || !d->mSelectCountAlbumsForArtistQuery.next()) {
-        qDebug() << "DatabaseInterface::internalArtistFromId" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
-        qDebug() << "DatabaseInterface::internalArtistFromId" << d->mSelectCountAlbumsForArtistQuery.boundValues();
-        qDebug() << "DatabaseInterface::internalArtistFromId" << d->mSelectCountAlbumsForArtistQuery.lastError();
-
-        d->mSelectCountAlbumsForArtistQuery.finish();
-
-        return result;
-    }
-
-    result.setAlbumsCount(d->mSelectCountAlbumsForArtistQuery.record().value(0).toInt());
-
-    d->mSelectCountAlbumsForArtistQuery.finish();
-
     return result;
 }
 
@@ -615,22 +759,101 @@ qulonglong DatabaseInterface::trackIdFromTitleAlbumArtist(QString title, QString
     return result;
 }
 
+void DatabaseInterface::loadAlbumTracks(qulonglong albumId)
+{
+    if (!d) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto result = internalAlbumFromId(albumId);
+
+    if (result.isValid()) {
+        result.setTracks(fetchTracks(albumId));
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    if (result.isValid()) {
+        Q_EMIT albumTracksLoaded(result);
+    }
+}
+
+void DatabaseInterface::searchItems(const QString &searchText)
+{
+    auto albumIds = QList<qulonglong>();
+    auto artistIds = QList<qulonglong>();
+    auto trackIds = QList<qulonglong>();
+
+    auto matchText = QString();
+    const auto &searchWords = searchText.toLower().split(QRegularExpression(QStringLiteral("[^\\p{L}\\p{N}]+")), QString::SkipEmptyParts);
+    for (const auto &oneWord : searchWords) {
+        if (!matchText.isEmpty()) {
+            matchText += QStringLiteral(" ");
+        }
+        matchText += oneWord + QStringLiteral("*");
+    }
+
+    if (!d || matchText.isEmpty()) {
+        Q_EMIT searchResultsReady(searchText, albumIds, artistIds, trackIds);
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    internalSearchIds(d->mSearchAlbumsQuery, matchText, albumIds);
+    internalSearchIds(d->mSearchArtistsQuery, matchText, artistIds);
+    internalSearchIds(d->mSearchTracksQuery, matchText, trackIds);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    Q_EMIT searchResultsReady(searchText, albumIds, artistIds, trackIds);
+}
+
 void DatabaseInterface::insertTracksList(QList<MusicAudioTrack> tracks, const QHash<QString, QUrl> &covers, QString musicSource)
+{
+    internalInsertTracksList(tracks, covers, musicSource);
+
+    Q_EMIT tracksListInserted(musicSource);
+}
+
+void DatabaseInterface::internalInsertTracksList(const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers, const QString &musicSource)
 {
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
 
-    for(const auto &oneTrack : tracks) {
-        d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+    auto otherTracks = QList<MusicAudioTrack>();
+
+    auto batchResult = internalInsertTracksBatch(tracks, covers, musicSource, otherTracks);
+    if (!batchResult) {
+        rollBackTransaction();
+        return;
+    }
+
+    for(const auto &oneTrack : otherTracks) {
+        bindFileName(d->mSelectTracksMapping, oneTrack.resourceURI());
 
         auto result = d->mSelectTracksMapping.exec();
 
         if (!result || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
-            qDebug() << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastQuery();
-            qDebug() << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.boundValues();
-            qDebug() << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastError();
+            qDebug() << "DatabaseInterface::internalInsertTracksList" << d->mSelectTracksMapping.lastQuery();
+            qDebug() << "DatabaseInterface::internalInsertTracksList" << d->mSelectTracksMapping.boundValues();
+            qDebug() << "DatabaseInterface::internalInsertTracksList" << d->mSelectTracksMapping.lastError();
 
             d->mSelectTracksMapping.finish();
 
@@ -650,13 +873,20 @@ void DatabaseInterface::insertTracksList(QList<MusicAudioTrack> tracks, const QH
 
         internalInsertTrack(oneTrack, covers, 0);
 
+        updateTrackFileStat(oneTrack);
+
         Q_EMIT newTrackFile(oneTrack);
     }
 
+    updatePendingAlbums();
+    updatePendingArtists();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
     }
+
+    emitPendingChanges();
 }
 
 void DatabaseInterface::removeTracksList(const QList<QUrl> removedTracks)
@@ -666,85 +896,480 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> removedTracks)
         return;
     }
 
-    QList<MusicAudioTrack> willRemoveTask;
-
-    for (auto removedTrackFileName : removedTracks) {
-        d->mSelectTrackFromFilePathQuery.bindValue(QStringLiteral(":filePath"), removedTrackFileName.toString());
-
-        auto result = d->mSelectTrackFromFilePathQuery.exec();
-
-        if (!result || !d->mSelectTrackFromFilePathQuery.isSelect() || !d->mSelectTrackFromFilePathQuery.isActive()) {
-            qDebug() << "DatabaseInterface::removeTracksList" << d->mSelectTrackFromFilePathQuery.lastQuery();
-            qDebug() << "DatabaseInterface::removeTracksList" << d->mSelectTrackFromFilePathQuery.boundValues();
-            qDebug() << "DatabaseInterface::removeTracksList" << d->mSelectTrackFromFilePathQuery.lastError();
-
-            continue;
-        }
-
-        while (d->mSelectTrackFromFilePathQuery.next()) {
-            MusicAudioTrack removedTrack;
+    auto parentDirectories = QSet<QString>();
+    for (const auto &oneRemovedTrack : removedTracks) {
+        auto directoryPath = QString();
+        auto baseName = QString();
+        splitFileName(oneRemovedTrack.toString(), directoryPath, baseName);
 
-            const auto &currentRecord = d->mSelectTrackFromFilePathQuery.record();
+        parentDirectories.insert(directoryPath);
+    }
 
-            removedTrack.setDatabaseId(currentRecord.value(0).toULongLong());
-            removedTrack.setTitle(currentRecord.value(1).toString());
-            removedTrack.setParentId(currentRecord.value(2).toString());
-            removedTrack.setArtist(currentRecord.value(3).toString());
-            removedTrack.setAlbumArtist(currentRecord.value(4).toString());
-            removedTrack.setResourceURI(currentRecord.value(5).toUrl());
-            removedTrack.setTrackNumber(currentRecord.value(6).toInt());
-            removedTrack.setDiscNumber(currentRecord.value(7).toInt());
-            removedTrack.setDuration(QTime::fromMSecsSinceStartOfDay(currentRecord.value(8).toInt()));
-            removedTrack.setAlbumName(currentRecord.value(9).toString());
-            removedTrack.setRating(currentRecord.value(10).toInt());
-            removedTrack.setValid(true);
+    auto removedDirectories = QSet<QString>();
+    for (const auto &oneRemovedTrack : removedTracks) {
+        const auto &directoryPath = oneRemovedTrack.toString() + QLatin1Char('/');
 
-            willRemoveTask.push_back(removedTrack);
+        if (parentDirectories.contains(directoryPath) || d->mDirectoryIds.contains(directoryPath)) {
+            removedDirectories.insert(directoryPath);
         }
-
-        d->mSelectTrackFromFilePathQuery.finish();
     }
 
-    for (auto oneRemovedTrack : willRemoveTask) {
-        removeTrackInDatabase(oneRemovedTrack.databaseId());
-        Q_EMIT trackRemoved(oneRemovedTrack);
-
-        const auto &modifiedAlbum = internalAlbumFromTitle(oneRemovedTrack.albumName());
-        const auto &allArtistTracks = internalTracksFromAuthor(oneRemovedTrack.artist());
-        const auto &removedArtistId = internalArtistIdFromName(oneRemovedTrack.artist());
-        const auto &removedArtist = internalArtistFromId(removedArtistId);
+    auto removedFiles = QList<QUrl>();
+    for (const auto &oneRemovedTrack : removedTracks) {
+        auto directoryPath = QString();
+        auto baseName = QString();
+        splitFileName(oneRemovedTrack.toString(), directoryPath, baseName);
 
-        if (modifiedAlbum.isValid() && !modifiedAlbum.isEmpty()) {
-            updateTracksCount(modifiedAlbum.databaseId());
-            updateIsSingleDiscAlbumFromId(modifiedAlbum.databaseId());
+        if (removedDirectories.contains(directoryPath)) {
+            continue;
         }
 
-        if (modifiedAlbum.isValid() && modifiedAlbum.isEmpty()) {
-            removeAlbumInDatabase(modifiedAlbum.databaseId());
-            Q_EMIT albumRemoved(modifiedAlbum);
-        }
+        const auto &treePath = oneRemovedTrack.toString() + QLatin1Char('/');
 
-        if (allArtistTracks.isEmpty()) {
-            removeArtistInDatabase(removedArtistId);
-            Q_EMIT artistRemoved(removedArtist);
+        if (removedDirectories.contains(treePath)) {
+            internalRemoveDirectoryTree(treePath);
+        } else {
+            removedFiles.push_back(oneRemovedTrack);
         }
     }
 
+    internalRemoveTracksList(removedFiles);
+
+    updatePendingAlbums();
+    updatePendingArtists();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
     }
+
+    emitPendingChanges();
 }
 
-void DatabaseInterface::modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers)
+void DatabaseInterface::removeDirectoryTree(const QUrl &removedDirectory)
 {
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
 
-    for (const auto &oneModifiedTrack : modifiedTracks) {
-        if (oneModifiedTrack.albumArtist().isEmpty()) {
+    auto directoryPath = removedDirectory.toString();
+    if (!directoryPath.endsWith(QLatin1Char('/'))) {
+        directoryPath.append(QLatin1Char('/'));
+    }
+
+    internalRemoveDirectoryTree(directoryPath);
+
+    updatePendingAlbums();
+    updatePendingArtists();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    emitPendingChanges();
+}
+
+void DatabaseInterface::beginSourceScan(const QString &musicSource)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    const auto discoverId = insertMusicSource(musicSource);
+
+    d->mSelectSourceScanGenerationQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+
+    auto queryResult = d->mSelectSourceScanGenerationQuery.exec();
+
+    if (!queryResult || !d->mSelectSourceScanGenerationQuery.isSelect() || !d->mSelectSourceScanGenerationQuery.isActive()) {
+        qDebug() << "DatabaseInterface::beginSourceScan" << d->mSelectSourceScanGenerationQuery.lastQuery();
+        qDebug() << "DatabaseInterface::beginSourceScan" << d->mSelectSourceScanGenerationQuery.boundValues();
+        qDebug() << "DatabaseInterface::beginSourceScan" << d->mSelectSourceScanGenerationQuery.lastError();
+
+        d->mSelectSourceScanGenerationQuery.finish();
+
+        rollBackTransaction();
+        return;
+    }
+
+    auto scanGeneration = qulonglong(0);
+    if (d->mSelectSourceScanGenerationQuery.next()) {
+        scanGeneration = d->mSelectSourceScanGenerationQuery.record().value(0).toULongLong();
+    }
+
+    d->mSelectSourceScanGenerationQuery.finish();
+
+    d->mSelectScannedDirectoriesQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+
+    queryResult = d->mSelectScannedDirectoriesQuery.exec();
+
+    if (!queryResult || !d->mSelectScannedDirectoriesQuery.isSelect() || !d->mSelectScannedDirectoriesQuery.isActive()) {
+        qDebug() << "DatabaseInterface::beginSourceScan" << d->mSelectScannedDirectoriesQuery.lastQuery();
+        qDebug() << "DatabaseInterface::beginSourceScan" << d->mSelectScannedDirectoriesQuery.boundValues();
+        qDebug() << "DatabaseInterface::beginSourceScan" << d->mSelectScannedDirectoriesQuery.lastError();
+
+        d->mSelectScannedDirectoriesQuery.finish();
+
+        rollBackTransaction();
+        return;
+    }
+
+    auto &scannedDirectories = d->mScannedDirectories[discoverId];
+    scannedDirectories.clear();
+
+    while (d->mSelectScannedDirectoriesQuery.next()) {
+        const auto &currentRecord = d->mSelectScannedDirectoriesQuery.record();
+
+        scannedDirectories[currentRecord.value(0).toULongLong()] = currentRecord.value(1).toLongLong();
+    }
+
+    d->mSelectScannedDirectoriesQuery.finish();
+
+    d->mScanGenerations[discoverId] = std::max(scanGeneration, d->mScanGenerations.value(discoverId)) + 1;
+    d->mChangedDirectories.remove(discoverId);
+
+    finishTransaction();
+}
+
+void DatabaseInterface::markSeenTracksList(const QList<QUrl> &seenTracks, const QHash<QUrl, QDateTime> &seenDirectories, const QString &musicSource)
+{
+    const auto discoverId = d->mDiscoverIds.value(musicSource);
+
+    if (discoverId == 0 || !d->mScanGenerations.contains(discoverId)) {
+        return;
+    }
+
+    auto &scannedDirectories = d->mScannedDirectories[discoverId];
+    auto &changedDirectories = d->mChangedDirectories[discoverId];
+
+    for (auto itDirectory = seenDirectories.cbegin(); itDirectory != seenDirectories.cend(); ++itDirectory) {
+        auto directoryPath = itDirectory.key().toString();
+        if (!directoryPath.endsWith(QLatin1Char('/'))) {
+            directoryPath.append(QLatin1Char('/'));
+        }
+
+        const auto modifiedTime = itDirectory.value().toMSecsSinceEpoch();
+        const auto directoryId = d->mDirectoryIds.value(directoryPath);
+
+        auto itScannedDirectory = scannedDirectories.find(directoryId);
+        if (itScannedDirectory != scannedDirectories.end()) {
+            const auto isUnchanged = itScannedDirectory.value() == modifiedTime;
+
+            scannedDirectories.erase(itScannedDirectory);
+
+            if (isUnchanged) {
+                continue;
+            }
+        }
+
+        changedDirectories[directoryPath] = modifiedTime;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    for (const auto &oneSeenTrack : seenTracks) {
+        auto directoryPath = QString();
+        auto baseName = QString();
+        splitFileName(oneSeenTrack.toString(), directoryPath, baseName);
+
+        const auto directoryId = d->mDirectoryIds.value(directoryPath);
+        if (directoryId == 0 || !changedDirectories.contains(directoryPath)) {
+            continue;
+        }
+
+        d->mUpdateTrackScanGenerationQuery.bindValue(QStringLiteral(":directoryId"), directoryId);
+        d->mUpdateTrackScanGenerationQuery.bindValue(QStringLiteral(":fileName"), baseName);
+        d->mUpdateTrackScanGenerationQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+        d->mUpdateTrackScanGenerationQuery.bindValue(QStringLiteral(":scanGeneration"), d->mScanGenerations.value(discoverId));
+
+        auto queryResult = d->mUpdateTrackScanGenerationQuery.exec();
+
+        if (!queryResult || !d->mUpdateTrackScanGenerationQuery.isActive()) {
+            qDebug() << "DatabaseInterface::markSeenTracksList" << d->mUpdateTrackScanGenerationQuery.lastQuery();
+            qDebug() << "DatabaseInterface::markSeenTracksList" << d->mUpdateTrackScanGenerationQuery.boundValues();
+            qDebug() << "DatabaseInterface::markSeenTracksList" << d->mUpdateTrackScanGenerationQuery.lastError();
+        }
+
+        d->mUpdateTrackScanGenerationQuery.finish();
+    }
+
+    finishTransaction();
+}
+
+void DatabaseInterface::finishSourceScan(const QString &musicSource)
+{
+    const auto discoverId = d->mDiscoverIds.value(musicSource);
+
+    if (discoverId == 0 || !d->mScanGenerations.contains(discoverId)) {
+        return;
+    }
+
+    const auto &changedDirectories = d->mChangedDirectories.take(discoverId);
+    const auto &vanishedDirectories = d->mScannedDirectories.take(discoverId);
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    const auto scanGeneration = d->mScanGenerations.value(discoverId);
+
+    for (auto itDirectory = changedDirectories.cbegin(); itDirectory != changedDirectories.cend(); ++itDirectory) {
+        const auto directoryId = d->mDirectoryIds.value(itDirectory.key());
+        if (directoryId == 0) {
+            continue;
+        }
+
+        d->mUpdateDirectoryScanGenerationQuery.bindValue(QStringLiteral(":directoryId"), directoryId);
+        d->mUpdateDirectoryScanGenerationQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+        d->mUpdateDirectoryScanGenerationQuery.bindValue(QStringLiteral(":scanGeneration"), scanGeneration);
+        d->mUpdateDirectoryScanGenerationQuery.bindValue(QStringLiteral(":modifiedTime"), itDirectory.value());
+
+        auto queryResult = d->mUpdateDirectoryScanGenerationQuery.exec();
+
+        if (!queryResult || !d->mUpdateDirectoryScanGenerationQuery.isActive()) {
+            qDebug() << "DatabaseInterface::finishSourceScan" << d->mUpdateDirectoryScanGenerationQuery.lastQuery();
+            qDebug() << "DatabaseInterface::finishSourceScan" << d->mUpdateDirectoryScanGenerationQuery.boundValues();
+            qDebug() << "DatabaseInterface::finishSourceScan" << d->mUpdateDirectoryScanGenerationQuery.lastError();
+        }
+
+        d->mUpdateDirectoryScanGenerationQuery.finish();
+    }
+
+    for (auto itDirectory = vanishedDirectories.cbegin(); itDirectory != vanishedDirectories.cend(); ++itDirectory) {
+        d->mRemoveScannedDirectoryQuery.bindValue(QStringLiteral(":directoryId"), itDirectory.key());
+        d->mRemoveScannedDirectoryQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+
+        auto queryResult = d->mRemoveScannedDirectoryQuery.exec();
+
+        if (!queryResult || !d->mRemoveScannedDirectoryQuery.isActive()) {
+            qDebug() << "DatabaseInterface::finishSourceScan" << d->mRemoveScannedDirectoryQuery.lastQuery();
+            qDebug() << "DatabaseInterface::finishSourceScan" << d->mRemoveScannedDirectoryQuery.boundValues();
+            qDebug() << "DatabaseInterface::finishSourceScan" << d->mRemoveScannedDirectoryQuery.lastError();
+        }
+
+        d->mRemoveScannedDirectoryQuery.finish();
+    }
+
+    d->mSelectUnseenTrackFilesQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+    d->mSelectUnseenTrackFilesQuery.bindValue(QStringLiteral(":scanGeneration"), scanGeneration);
+
+    auto queryResult = d->mSelectUnseenTrackFilesQuery.exec();
+
+    if (!queryResult || !d->mSelectUnseenTrackFilesQuery.isSelect() || !d->mSelectUnseenTrackFilesQuery.isActive()) {
+        qDebug() << "DatabaseInterface::finishSourceScan" << d->mSelectUnseenTrackFilesQuery.lastQuery();
+        qDebug() << "DatabaseInterface::finishSourceScan" << d->mSelectUnseenTrackFilesQuery.boundValues();
+        qDebug() << "DatabaseInterface::finishSourceScan" << d->mSelectUnseenTrackFilesQuery.lastError();
+
+        d->mSelectUnseenTrackFilesQuery.finish();
+
+        rollBackTransaction();
+        return;
+    }
+
+    auto unseenTracks = QList<QUrl>();
+
+    while (d->mSelectUnseenTrackFilesQuery.next()) {
+        unseenTracks.push_back(d->mSelectUnseenTrackFilesQuery.record().value(0).toUrl());
+    }
+
+    d->mSelectUnseenTrackFilesQuery.finish();
+
+    if (unseenTracks.isEmpty()) {
+        finishTransaction();
+        emitAlbumCovers(musicSource);
+        return;
+    }
+
+    internalRemoveTracksList(unseenTracks);
+
+    d->mRemoveUnseenTrackFilesQuery.bindValue(QStringLiteral(":discoverId"), discoverId);
+    d->mRemoveUnseenTrackFilesQuery.bindValue(QStringLiteral(":scanGeneration"), scanGeneration);
+
+    queryResult = d->mRemoveUnseenTrackFilesQuery.exec();
+
+    if (!queryResult || !d->mRemoveUnseenTrackFilesQuery.isActive()) {
+        qDebug() << "DatabaseInterface::finishSourceScan" << d->mRemoveUnseenTrackFilesQuery.lastQuery();
+        qDebug() << "DatabaseInterface::finishSourceScan" << d->mRemoveUnseenTrackFilesQuery.boundValues();
+        qDebug() << "DatabaseInterface::finishSourceScan" << d->mRemoveUnseenTrackFilesQuery.lastError();
+    }
+
+    d->mRemoveUnseenTrackFilesQuery.finish();
+
+    updatePendingAlbums();
+    updatePendingArtists();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    emitPendingChanges();
+
+    emitAlbumCovers(musicSource);
+}
+
+void DatabaseInterface::emitAlbumCovers(const QString &musicSource)
+{
+    auto queryResult = d->mSelectAlbumCoversQuery.exec();
+
+    if (!queryResult || !d->mSelectAlbumCoversQuery.isSelect() || !d->mSelectAlbumCoversQuery.isActive()) {
+        qDebug() << "DatabaseInterface::emitAlbumCovers" << d->mSelectAlbumCoversQuery.lastQuery();
+        qDebug() << "DatabaseInterface::emitAlbumCovers" << d->mSelectAlbumCoversQuery.lastError();
+
+        d->mSelectAlbumCoversQuery.finish();
+
+        return;
+    }
+
+    auto albumCovers = QList<QUrl>();
+    while (d->mSelectAlbumCoversQuery.next()) {
+        albumCovers.push_back(d->mSelectAlbumCoversQuery.record().value(0).toUrl());
+    }
+
+    d->mSelectAlbumCoversQuery.finish();
+
+    Q_EMIT albumCoversListed(musicSource, albumCovers);
+}
+
+void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTracks)
+{
+    QList<MusicAudioTrack> willRemoveTask;
+
+    for (auto removedTrackFileName : removedTracks) {
+        bindFileName(d->mSelectTrackFromFilePathQuery, removedTrackFileName);
+
+        auto result = d->mSelectTrackFromFilePathQuery.exec();
+
+        if (!result || !d->mSelectTrackFromFilePathQuery.isSelect() || !d->mSelectTrackFromFilePathQuery.isActive()) {
+            qDebug() << "DatabaseInterface::removeTracksList" << d->mSelectTrackFromFilePathQuery.lastQuery();
+            qDebug() << "DatabaseInterface::removeTracksList" << d->mSelectTrackFromFilePathQuery.boundValues();
+            qDebug() << "DatabaseInterface::removeTracksList" << d->mSelectTrackFromFilePathQuery.lastError();
+
+            continue;
+        }
+
+        while (d->mSelectTrackFromFilePathQuery.next()) {
+            MusicAudioTrack removedTrack;
+
+            const auto &currentRecord = d->mSelectTrackFromFilePathQuery.record();
+
+            removedTrack.setDatabaseId(currentRecord.value(0).toULongLong());
+            removedTrack.setTitle(currentRecord.value(1).toString());
+            removedTrack.setParentId(currentRecord.value(2).toString());
+            removedTrack.setArtist(currentRecord.value(3).toString());
+            removedTrack.setAlbumArtist(currentRecord.value(4).toString());
+            removedTrack.setResourceURI(currentRecord.value(5).toUrl());
+            removedTrack.setTrackNumber(currentRecord.value(6).toInt());
+            removedTrack.setDiscNumber(currentRecord.value(7).toInt());
+            removedTrack.setDuration(QTime::fromMSecsSinceStartOfDay(currentRecord.value(8).toInt()));
+            removedTrack.setAlbumName(currentRecord.value(9).toString());
+            removedTrack.setRating(currentRecord.value(10).toInt());
+            removedTrack.setValid(true);
+
+            willRemoveTask.push_back(removedTrack);
+        }
+
+        d->mSelectTrackFromFilePathQuery.finish();
+    }
+
+    for (auto oneRemovedTrack : willRemoveTask) {
+        removeTrackInDatabase(oneRemovedTrack.databaseId());
+        d->mRemovedTracks.push_back(oneRemovedTrack);
+        Q_EMIT trackRemoved(oneRemovedTrack);
+
+        const auto &modifiedAlbumKey = qMakePair(oneRemovedTrack.albumName(), internalArtistIdFromName(oneRemovedTrack.albumArtist()));
+        const auto &modifiedAlbum = internalAlbumFromId(d->mAlbumIds.value(modifiedAlbumKey));
+        const auto &allArtistTracks = internalTracksFromAuthor(oneRemovedTrack.artist());
+        const auto &removedArtistId = internalArtistIdFromName(oneRemovedTrack.artist());
+        const auto &removedArtist = internalArtistFromId(removedArtistId);
+
+        if (modifiedAlbum.isValid() && !modifiedAlbum.isEmpty()) {
+            updateAlbumLater(modifiedAlbum.databaseId());
+        }
+
+        if (modifiedAlbum.isValid() && modifiedAlbum.isEmpty()) {
+            removeAlbumInDatabase(modifiedAlbum.databaseId());
+            d->mRemovedAlbums.push_back(modifiedAlbum);
+            Q_EMIT albumRemoved(modifiedAlbum);
+        }
+
+        if (allArtistTracks.isEmpty()) {
+            removeArtistInDatabase(removedArtistId);
+            d->mRemovedArtists.push_back(removedArtist);
+            Q_EMIT artistRemoved(removedArtist);
+        }
+    }
+}
+
+void DatabaseInterface::internalRemoveDirectoryTree(const QString &directoryPath)
+{
+    auto directoryPathEnd = directoryPath;
+    directoryPathEnd[directoryPathEnd.size() - 1] = QChar(QLatin1Char('/').unicode() + 1);
+
+    d->mSelectDirectoryTreeTrackFilesQuery.bindValue(QStringLiteral(":directoryPath"), directoryPath);
+    d->mSelectDirectoryTreeTrackFilesQuery.bindValue(QStringLiteral(":directoryPathEnd"), directoryPathEnd);
+
+    auto queryResult = d->mSelectDirectoryTreeTrackFilesQuery.exec();
+
+    if (!queryResult || !d->mSelectDirectoryTreeTrackFilesQuery.isSelect() || !d->mSelectDirectoryTreeTrackFilesQuery.isActive()) {
+        qDebug() << "DatabaseInterface::internalRemoveDirectoryTree" << d->mSelectDirectoryTreeTrackFilesQuery.lastQuery();
+        qDebug() << "DatabaseInterface::internalRemoveDirectoryTree" << d->mSelectDirectoryTreeTrackFilesQuery.boundValues();
+        qDebug() << "DatabaseInterface::internalRemoveDirectoryTree" << d->mSelectDirectoryTreeTrackFilesQuery.lastError();
+
+        d->mSelectDirectoryTreeTrackFilesQuery.finish();
+
+        return;
+    }
+
+    auto removedFiles = QList<QUrl>();
+    while (d->mSelectDirectoryTreeTrackFilesQuery.next()) {
+        removedFiles.push_back(d->mSelectDirectoryTreeTrackFilesQuery.record().value(0).toUrl());
+    }
+
+    d->mSelectDirectoryTreeTrackFilesQuery.finish();
+
+    internalRemoveTracksList(removedFiles);
+
+    for (auto removeQuery : {&d->mRemoveDirectoryTreeTracksMappingQuery, &d->mRemoveDirectoryTreeScansQuery, &d->mRemoveDirectoryTreeQuery}) {
+        removeQuery->bindValue(QStringLiteral(":directoryPath"), directoryPath);
+        removeQuery->bindValue(QStringLiteral(":directoryPathEnd"), directoryPathEnd);
+
+        queryResult = removeQuery->exec();
+
+        if (!queryResult || !removeQuery->isActive()) {
+            qDebug() << "DatabaseInterface::internalRemoveDirectoryTree" << removeQuery->lastQuery();
+            qDebug() << "DatabaseInterface::internalRemoveDirectoryTree" << removeQuery->boundValues();
+            qDebug() << "DatabaseInterface::internalRemoveDirectoryTree" << removeQuery->lastError();
+        }
+
+        removeQuery->finish();
+    }
+
+    for (auto itDirectory = d->mDirectoryIds.begin(); itDirectory != d->mDirectoryIds.end(); ) {
+        if (itDirectory.key().startsWith(directoryPath)) {
+            itDirectory = d->mDirectoryIds.erase(itDirectory);
+        } else {
+            ++itDirectory;
+        }
+    }
+}
+
+void DatabaseInterface::modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    for (const auto &oneModifiedTrack : modifiedTracks) {
+        if (oneModifiedTrack.albumArtist().isEmpty()) {
             continue;
         }
 
@@ -801,14 +1426,20 @@ void DatabaseInterface::modifyTracksList(const QList<MusicAudioTrack> &modifiedT
             updateTrackOrigin(originTrackId, oneModifiedTrack.resourceURI());
 
             if (originTrack.isValid() || otherTrackId != 0) {
-                Q_EMIT trackModified(internalTrackFromDatabaseId(originTrackId));
-                Q_EMIT albumModified(internalAlbumFromId(albumId));
+                const auto &modifiedTrack = internalTrackFromDatabaseId(originTrackId);
+                d->mModifiedTracks.push_back(modifiedTrack);
+                Q_EMIT trackModified(modifiedTrack);
+
+                const auto &modifiedAlbum = internalAlbumFromId(albumId);
+                d->mModifiedAlbums.push_back(modifiedAlbum);
+                Q_EMIT albumModified(modifiedAlbum);
             } else {
-                Q_EMIT trackAdded(internalTrackFromDatabaseId(originTrackId));
+                const auto &newTrack = internalTrackFromDatabaseId(originTrackId);
+                d->mAddedTracks.push_back(newTrack);
+                Q_EMIT trackAdded(newTrack);
             }
 
-            updateIsSingleDiscAlbumFromId(albumId);
-            updateTracksCount(albumId);
+            updateAlbumLater(albumId);
         } else {
             d->mInsertTrackQuery.finish();
 
@@ -820,10 +1451,19 @@ void DatabaseInterface::modifyTracksList(const QList<MusicAudioTrack> &modifiedT
         }
     }
 
+    for (const auto &oneModifiedTrack : modifiedTracks) {
+        updateTrackFileStat(oneModifiedTrack);
+    }
+
+    updatePendingAlbums();
+    updatePendingArtists();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
     }
+
+    emitPendingChanges();
 }
 
 bool DatabaseInterface::startTransaction() const
@@ -851,6 +1491,8 @@ bool DatabaseInterface::finishTransaction() const
     if (!transactionResult) {
         qDebug() << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
+        clearPendingChanges();
+
         return result;
     }
 
@@ -871,11 +1513,142 @@ bool DatabaseInterface::rollBackTransaction() const
         return result;
     }
 
+    loadIdCaches();
+
+    clearPendingChanges();
+
     result = true;
 
     return result;
 }
 
+void DatabaseInterface::clearPendingChanges() const
+{
+    d->mAddedArtists.clear();
+    d->mAddedAlbums.clear();
+    d->mAddedTracks.clear();
+    d->mModifiedArtists.clear();
+    d->mModifiedAlbums.clear();
+    d->mModifiedTracks.clear();
+    d->mRemovedArtists.clear();
+    d->mRemovedAlbums.clear();
+    d->mRemovedTracks.clear();
+    d->mPendingAlbumUpdates.clear();
+    d->mPendingAlbumIds.clear();
+    d->mPendingArtistUpdates.clear();
+    d->mPendingArtistIds.clear();
+}
+
+void DatabaseInterface::updateAlbumLater(qulonglong albumId) const
+{
+    if (d->mPendingAlbumIds.contains(albumId)) {
+        return;
+    }
+
+    d->mPendingAlbumIds.insert(albumId);
+    d->mPendingAlbumUpdates.push_back(albumId);
+}
+
+void DatabaseInterface::updatePendingAlbums()
+{
+    for (auto oneAlbumId : d->mPendingAlbumUpdates) {
+        if (!d->mAlbumKeys.contains(oneAlbumId)) {
+            continue;
+        }
+
+        updateIsSingleDiscAlbumFromId(oneAlbumId);
+        updateAlbumSearchEntry(oneAlbumId);
+
+        if (updateTracksCount(oneAlbumId)) {
+            const auto &modifiedAlbum = internalAlbumFromId(oneAlbumId);
+            d->mModifiedAlbums.push_back(modifiedAlbum);
+            Q_EMIT albumModified(modifiedAlbum);
+        }
+    }
+
+    d->mPendingAlbumUpdates.clear();
+    d->mPendingAlbumIds.clear();
+}
+
+void DatabaseInterface::updateArtistLater(qulonglong artistId) const
+{
+    if (d->mPendingArtistIds.contains(artistId)) {
+        return;
+    }
+
+    d->mPendingArtistIds.insert(artistId);
+    d->mPendingArtistUpdates.push_back(artistId);
+}
+
+void DatabaseInterface::updatePendingArtists()
+{
+    auto addedArtistsRows = QHash<qulonglong, int>();
+    for (int i = 0; i < d->mAddedArtists.size(); ++i) {
+        addedArtistsRows[d->mAddedArtists[i].databaseId()] = i;
+    }
+
+    for (auto oneArtistId : d->mPendingArtistUpdates) {
+        if (!d->mArtistNames.contains(oneArtistId)) {
+            continue;
+        }
+
+        const auto &modifiedArtist = internalArtistFromId(oneArtistId);
+
+        auto itAddedArtist = addedArtistsRows.constFind(oneArtistId);
+        if (itAddedArtist != addedArtistsRows.constEnd()) {
+            d->mAddedArtists[itAddedArtist.value()] = modifiedArtist;
+            continue;
+        }
+
+        d->mModifiedArtists.push_back(modifiedArtist);
+        Q_EMIT artistModified(modifiedArtist);
+    }
+
+    d->mPendingArtistUpdates.clear();
+    d->mPendingArtistIds.clear();
+}
+
+void DatabaseInterface::emitPendingChanges()
+{
+    if (!d->mAddedArtists.isEmpty()) {
+        Q_EMIT artistsAdded(d->mAddedArtists);
+    }
+
+    if (!d->mAddedAlbums.isEmpty()) {
+        Q_EMIT albumsAdded(d->mAddedAlbums);
+    }
+
+    if (!d->mAddedTracks.isEmpty()) {
+        Q_EMIT tracksAdded(d->mAddedTracks);
+    }
+
+    if (!d->mModifiedTracks.isEmpty()) {
+        Q_EMIT tracksModified(d->mModifiedTracks);
+    }
+
+    if (!d->mModifiedArtists.isEmpty()) {
+        Q_EMIT artistsModified(d->mModifiedArtists);
+    }
+
+    if (!d->mModifiedAlbums.isEmpty()) {
+        Q_EMIT albumsModified(d->mModifiedAlbums);
+    }
+
+    if (!d->mRemovedTracks.isEmpty()) {
+        Q_EMIT tracksRemoved(d->mRemovedTracks);
+    }
+
+    if (!d->mRemovedAlbums.isEmpty()) {
+        Q_EMIT albumsRemoved(d->mRemovedAlbums);
+    }
+
+    if (!d->mRemovedArtists.isEmpty()) {
+        Q_EMIT artistsRemoved(d->mRemovedArtists);
+    }
+
+    clearPendingChanges();
+}
+
 void DatabaseInterface::initDatabase() const
 {
     auto transactionResult = startTransaction();
@@ -902,12 +1675,33 @@ void DatabaseInterface::initDatabase() const
 
         const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Artists` (`ID` INTEGER PRIMARY KEY NOT NULL, "
                                                                    "`Name` VARCHAR(55) NOT NULL, "
+                                                                   "`AlbumsCount` INTEGER NOT NULL DEFAULT 0, "
                                                                    "UNIQUE (`Name`))"));
 
         if (!result) {
             qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
             qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
         }
+    } else {
+        auto listColumns = d->mTracksDatabase.record(QStringLiteral("Artists"));
+
+        if (!listColumns.contains(QStringLiteral("AlbumsCount"))) {
+            QSqlQuery alterSchemaQuery(d->mTracksDatabase);
+
+            auto result = alterSchemaQuery.exec(QStringLiteral("ALTER TABLE `Artists` "
+                                                               "ADD COLUMN `AlbumsCount` INTEGER NOT NULL DEFAULT 0"));
+
+            if (!result) {
+                qDebug() << "DatabaseInterface::initDatabase" << alterSchemaQuery.lastError();
+            }
+
+            result = alterSchemaQuery.exec(QStringLiteral("UPDATE `Artists` "
+                                                          "SET `AlbumsCount` = (SELECT COUNT(*) FROM `Albums` WHERE `ArtistID` = `Artists`.`ID`)"));
+
+            if (!result) {
+                qDebug() << "DatabaseInterface::initDatabase" << alterSchemaQuery.lastError();
+            }
+        }
     }
 
     if (!listTables.contains(QStringLiteral("Albums"))) {
@@ -963,19 +1757,110 @@ void DatabaseInterface::initDatabase() const
         }
     }
 
-    if (!listTables.contains(QStringLiteral("TracksMapping"))) {
+    if (!listTables.contains(QStringLiteral("Directories"))) {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Directories` ("
+                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Path` VARCHAR(255) NOT NULL, "
+                                                                   "UNIQUE (`Path`))"));
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+        }
+    }
+
+    auto upgradeTracksMapping = listTables.contains(QStringLiteral("TracksMappingWithFileName"));
+    auto renamedTracksMapping = false;
+
+    if (listTables.contains(QStringLiteral("TracksMapping"))) {
+        auto listColumns = d->mTracksDatabase.record(QStringLiteral("TracksMapping"));
+
+        const auto newColumns = QList<QPair<QString, QString>>({
+            {QStringLiteral("FileSize"), QStringLiteral("INTEGER NULL")},
+            {QStringLiteral("FileModifiedTime"), QStringLiteral("INTEGER NULL")},
+            {QStringLiteral("FileInode"), QStringLiteral("INTEGER NULL")},
+            {QStringLiteral("ScanGeneration"), QStringLiteral("INTEGER NOT NULL DEFAULT 0")}});
+
+        for (const auto &oneColumn : newColumns) {
+            if (listColumns.contains(oneColumn.first)) {
+                continue;
+            }
+
+            QSqlQuery alterSchemaQuery(d->mTracksDatabase);
+
+            const auto &result = alterSchemaQuery.exec(QStringLiteral("ALTER TABLE `TracksMapping` "
+                                                                       "ADD COLUMN `%1` %2").arg(oneColumn.first, oneColumn.second));
+
+            if (!result) {
+                qDebug() << "DatabaseInterface::initDatabase" << alterSchemaQuery.lastError();
+            }
+        }
+
+        if (!listColumns.contains(QStringLiteral("DirectoryID"))) {
+            QSqlQuery alterSchemaQuery(d->mTracksDatabase);
+
+            const auto &result = alterSchemaQuery.exec(QStringLiteral("ALTER TABLE `TracksMapping` "
+                                                                       "RENAME TO `TracksMappingWithFileName`"));
+
+            if (!result) {
+                qDebug() << "DatabaseInterface::initDatabase" << alterSchemaQuery.lastError();
+
+                rollBackTransaction();
+                return;
+            }
+
+            upgradeTracksMapping = true;
+            renamedTracksMapping = true;
+        }
+    }
+
+    if (!listTables.contains(QStringLiteral("TracksMapping")) || renamedTracksMapping) {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksMapping` ("
+                                                                   "`TrackID` INTEGER NULL, "
+                                                                   "`DiscoverID` INTEGER NOT NULL, "
+                                                                   "`DirectoryID` INTEGER NOT NULL, "
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`Priority` INTEGER NOT NULL, "
+                                                                   "`TrackValid` BOOLEAN NOT NULL, "
+                                                                   "`FileSize` INTEGER NULL, "
+                                                                   "`FileModifiedTime` INTEGER NULL, "
+                                                                   "`FileInode` INTEGER NULL, "
+                                                                   "`ScanGeneration` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "PRIMARY KEY (`DirectoryID`, `FileName`), "
+                                                                   "CONSTRAINT TracksUnique UNIQUE (`TrackID`, `Priority`), "
+                                                                   "CONSTRAINT fk_tracksmapping_trackID FOREIGN KEY (`TrackID`) REFERENCES `Tracks`(`ID`), "
+                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`), "
+                                                                   "CONSTRAINT fk_tracksmapping_directoryID FOREIGN KEY (`DirectoryID`) REFERENCES `Directories`(`ID`))"));
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+
+            rollBackTransaction();
+            return;
+        }
+    }
+
+    if (upgradeTracksMapping && !upgradeTracksMappingToDirectories()) {
+        qDebug() << "DatabaseInterface::initDatabase" << "TracksMapping upgrade failed, keeping the previous schema";
+
+        rollBackTransaction();
+        return;
+    }
+
+    if (!listTables.contains(QStringLiteral("ScannedDirectories"))) {
         QSqlQuery createSchemaQuery(d->mTracksDatabase);
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksMapping` ("
-                                                                   "`TrackID` INTEGER NULL, "
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `ScannedDirectories` ("
+                                                                   "`DirectoryID` INTEGER NOT NULL, "
                                                                    "`DiscoverID` INTEGER NOT NULL, "
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`Priority` INTEGER NOT NULL, "
-                                                                   "`TrackValid` BOOLEAN NOT NULL, "
-                                                                   "PRIMARY KEY (`FileName`), "
-                                                                   "CONSTRAINT TracksUnique UNIQUE (`TrackID`, `Priority`), "
-                                                                   "CONSTRAINT fk_tracksmapping_trackID FOREIGN KEY (`TrackID`) REFERENCES `Tracks`(`ID`), "
-                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+                                                                   "`ScanGeneration` INTEGER NOT NULL, "
+                                                                   "`ModifiedTime` INTEGER NOT NULL, "
+                                                                   "PRIMARY KEY (`DirectoryID`, `DiscoverID`), "
+                                                                   "CONSTRAINT fk_scanneddirectories_directoryID FOREIGN KEY (`DirectoryID`) REFERENCES `Directories`(`ID`), "
+                                                                   "CONSTRAINT fk_scanneddirectories_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
 
         if (!result) {
             qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
@@ -1013,8 +1898,21 @@ void DatabaseInterface::initDatabase() const
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`TracksFileNameIndex` ON `TracksMapping` "
-                                                                  "(`FileName`)"));
+                                                                  "`TracksMappingScanGenerationIndex` ON `TracksMapping` "
+                                                                  "(`DiscoverID`, `ScanGeneration`)"));
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ScannedDirectoriesScanGenerationIndex` ON `ScannedDirectories` "
+                                                                  "(`DiscoverID`, `ScanGeneration`)"));
 
         if (!result) {
             qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
@@ -1034,12 +1932,171 @@ void DatabaseInterface::initDatabase() const
         }
     }
 
+    if (!listTables.contains(QStringLiteral("TracksSearch"))) {
+        initSearchIndex();
+    }
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
     }
 }
 
+bool DatabaseInterface::upgradeTracksMappingToDirectories() const
+{
+    QSqlQuery selectDirectoriesQuery(d->mTracksDatabase);
+
+    auto result = selectDirectoriesQuery.exec(QStringLiteral("SELECT `ID`, `Path` FROM `Directories`"));
+
+    if (!result || !selectDirectoriesQuery.isSelect() || !selectDirectoriesQuery.isActive()) {
+        qDebug() << "DatabaseInterface::upgradeTracksMappingToDirectories" << selectDirectoriesQuery.lastQuery();
+        qDebug() << "DatabaseInterface::upgradeTracksMappingToDirectories" << selectDirectoriesQuery.lastError();
+
+        return false;
+    }
+
+    auto directoryIds = QHash<QString, qulonglong>();
+    auto nextDirectoryId = qulonglong(1);
+
+    while (selectDirectoriesQuery.next()) {
+        const auto directoryId = selectDirectoriesQuery.record().value(0).toULongLong();
+
+        directoryIds[selectDirectoriesQuery.record().value(1).toString()] = directoryId;
+        nextDirectoryId = std::max(nextDirectoryId, directoryId + 1);
+    }
+
+    selectDirectoriesQuery.finish();
+
+    QSqlQuery selectOldMappingQuery(d->mTracksDatabase);
+
+    result = selectOldMappingQuery.exec(QStringLiteral("SELECT `TrackID`, `DiscoverID`, `FileName`, `Priority`, `TrackValid`, "
+                                                       "`FileSize`, `FileModifiedTime`, `FileInode`, `ScanGeneration` "
+                                                       "FROM `TracksMappingWithFileName`"));
+
+    if (!result || !selectOldMappingQuery.isSelect() || !selectOldMappingQuery.isActive()) {
+        qDebug() << "DatabaseInterface::upgradeTracksMappingToDirectories" << selectOldMappingQuery.lastQuery();
+        qDebug() << "DatabaseInterface::upgradeTracksMappingToDirectories" << selectOldMappingQuery.lastError();
+
+        return false;
+    }
+
+    auto directoriesValues = QVariantList();
+    auto tracksMappingValues = QVariantList();
+
+    while (selectOldMappingQuery.next()) {
+        const auto &currentRecord = selectOldMappingQuery.record();
+
+        auto directoryPath = QString();
+        auto baseName = QString();
+        splitFileName(currentRecord.value(2).toString(), directoryPath, baseName);
+
+        auto itDirectory = directoryIds.constFind(directoryPath);
+        if (itDirectory == directoryIds.constEnd()) {
+            itDirectory = directoryIds.insert(directoryPath, nextDirectoryId);
+            directoriesValues << nextDirectoryId << directoryPath;
+
+            ++nextDirectoryId;
+        }
+
+        tracksMappingValues << currentRecord.value(0) << currentRecord.value(1) << itDirectory.value() << baseName
+                            << currentRecord.value(3) << currentRecord.value(4) << currentRecord.value(5)
+                            << currentRecord.value(6) << currentRecord.value(7) << currentRecord.value(8);
+    }
+
+    selectOldMappingQuery.finish();
+
+    result = insertMultipleRows(QStringLiteral("INSERT INTO `Directories` (`ID`, `Path`) VALUES "), 2, directoriesValues);
+
+    if (result) {
+        result = insertMultipleRows(QStringLiteral("INSERT OR IGNORE INTO `TracksMapping` (`TrackID`, `DiscoverID`, `DirectoryID`, `FileName`, "
+                                                   "`Priority`, `TrackValid`, `FileSize`, `FileModifiedTime`, `FileInode`, `ScanGeneration`) VALUES "),
+                                    10, tracksMappingValues);
+    }
+
+    if (!result) {
+        return false;
+    }
+
+    QSqlQuery dropOldMappingQuery(d->mTracksDatabase);
+
+    result = dropOldMappingQuery.exec(QStringLiteral("DROP TABLE `TracksMappingWithFileName`"));
+
+    if (!result) {
+        qDebug() << "DatabaseInterface::upgradeTracksMappingToDirectories" << dropOldMappingQuery.lastError();
+    }
+
+    return result;
+}
+
+void DatabaseInterface::initSearchIndex() const
+{
+    QSqlQuery createSearchQuery(d->mTracksDatabase);
+
+    auto searchModule = QStringLiteral("fts5(%1)");
+
+    auto result = createSearchQuery.exec(QStringLiteral("CREATE VIRTUAL TABLE `ArtistsSearch` USING fts5(`Name`)"));
+
+    if (!result) {
+        searchModule = QStringLiteral("fts4(%1, tokenize=unicode61)");
+
+        result = createSearchQuery.exec(QStringLiteral("CREATE VIRTUAL TABLE `ArtistsSearch` USING fts4(`Name`, tokenize=unicode61)"));
+    }
+
+    if (!result) {
+        qDebug() << "DatabaseInterface::initSearchIndex" << createSearchQuery.lastQuery();
+        qDebug() << "DatabaseInterface::initSearchIndex" << createSearchQuery.lastError();
+
+        return;
+    }
+
+    const auto &searchIndexQueries = QStringList{
+            QStringLiteral("CREATE VIRTUAL TABLE `AlbumsSearch` USING ") + searchModule.arg(QStringLiteral("`Title`, `ArtistName`, `AllArtists`")),
+            QStringLiteral("CREATE VIRTUAL TABLE `TracksSearch` USING ") + searchModule.arg(QStringLiteral("`Title`, `ArtistName`, `AlbumTitle`")),
+            QStringLiteral("INSERT INTO `ArtistsSearch` (rowid, `Name`) "
+                           "SELECT `ID`, `Name` FROM `Artists`"),
+            QStringLiteral("INSERT INTO `AlbumsSearch` (rowid, `Title`, `ArtistName`, `AllArtists`) "
+                           "SELECT album.`ID`, album.`Title`, artist.`Name`, "
+                           "(SELECT group_concat(trackArtist.`Name`, ' ') FROM `Tracks` tracks, `Artists` trackArtist "
+                           "WHERE tracks.`AlbumID` = album.`ID` AND trackArtist.`ID` = tracks.`ArtistID`) "
+                           "FROM `Albums` album, `Artists` artist "
+                           "WHERE artist.`ID` = album.`ArtistID`"),
+            QStringLiteral("INSERT INTO `TracksSearch` (rowid, `Title`, `ArtistName`, `AlbumTitle`) "
+                           "SELECT tracks.`ID`, tracks.`Title`, artist.`Name`, album.`Title` "
+                           "FROM `Tracks` tracks, `Artists` artist, `Albums` album "
+                           "WHERE artist.`ID` = tracks.`ArtistID` AND album.`ID` = tracks.`AlbumID`"),
+            QStringLiteral("CREATE TRIGGER `ArtistsSearchInsert` AFTER INSERT ON `Artists` BEGIN "
+                           "INSERT INTO `ArtistsSearch` (rowid, `Name`) VALUES (new.`ID`, new.`Name`); "
+                           "END"),
+            QStringLiteral("CREATE TRIGGER `ArtistsSearchDelete` AFTER DELETE ON `Artists` BEGIN "
+                           "DELETE FROM `ArtistsSearch` WHERE rowid = old.`ID`; "
+                           "END"),
+            QStringLiteral("CREATE TRIGGER `AlbumsSearchInsert` AFTER INSERT ON `Albums` BEGIN "
+                           "INSERT INTO `AlbumsSearch` (rowid, `Title`, `ArtistName`, `AllArtists`) "
+                           "VALUES (new.`ID`, new.`Title`, (SELECT `Name` FROM `Artists` WHERE `ID` = new.`ArtistID`), ''); "
+                           "END"),
+            QStringLiteral("CREATE TRIGGER `AlbumsSearchDelete` AFTER DELETE ON `Albums` BEGIN "
+                           "DELETE FROM `AlbumsSearch` WHERE rowid = old.`ID`; "
+                           "END"),
+            QStringLiteral("CREATE TRIGGER `TracksSearchInsert` AFTER INSERT ON `Tracks` BEGIN "
+                           "INSERT INTO `TracksSearch` (rowid, `Title`, `ArtistName`, `AlbumTitle`) "
+                           "VALUES (new.`ID`, new.`Title`, (SELECT `Name` FROM `Artists` WHERE `ID` = new.`ArtistID`), "
+                           "(SELECT `Title` FROM `Albums` WHERE `ID` = new.`AlbumID`)); "
+                           "END"),
+            QStringLiteral("CREATE TRIGGER `TracksSearchDelete` AFTER DELETE ON `Tracks` BEGIN "
+                           "DELETE FROM `TracksSearch` WHERE rowid = old.`ID`; "
+                           "END"),
+    };
+
+    for (const auto &oneQueryText : searchIndexQueries) {
+        result = createSearchQuery.exec(oneQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initSearchIndex" << createSearchQuery.lastQuery();
+            qDebug() << "DatabaseInterface::initSearchIndex" << createSearchQuery.lastError();
+        }
+    }
+}
+
 void DatabaseInterface::initRequest()
 {
     auto transactionResult = startTransaction();
@@ -1075,11 +2132,22 @@ void DatabaseInterface::initRequest()
                                                   "artist.`Name`, "
                                                   "album.`CoverFileName`, "
                                                   "album.`TracksCount`, "
-                                                  "album.`IsSingleDiscAlbum` "
-                                                  "FROM `Albums` album, `Artists` artist "
-                                                  "WHERE "
-                                                  "artist.`ID` = album.`ArtistID` "
-                                                  "ORDER BY album.`Title`");
+                                                  "album.`IsSingleDiscAlbum`, "
+                                                  "tracks.`ID`, "
+                                                  "tracks.`Title`, "
+                                                  "trackArtist.`Name`, "
+                                                  "directory.`Path` || tracksMapping.`FileName`, "
+                                                  "tracks.`Rating` "
+                                                  "FROM `Albums` album "
+                                                  "INNER JOIN `Artists` artist ON artist.`ID` = album.`ArtistID` "
+                                                  "LEFT OUTER JOIN `Tracks` tracks ON tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT OUTER JOIN `Artists` trackArtist ON trackArtist.`ID` = tracks.`ArtistID` "
+                                                  "LEFT OUTER JOIN `TracksMapping` tracksMapping ON tracksMapping.`TrackID` = tracks.`ID` AND tracksMapping.`Priority` = 1 "
+                                                  "LEFT OUTER JOIN `Directories` directory ON directory.`ID` = tracksMapping.`DirectoryID` "
+                                                  "ORDER BY album.`Title`, "
+                                                  "album.`ID`, "
+                                                  "tracks.`DiscNumber` ASC, "
+                                                  "tracks.`TrackNumber` ASC");
 
         auto result = d->mSelectAllAlbumsQuery.prepare(selectAllAlbumsText);
 
@@ -1091,7 +2159,8 @@ void DatabaseInterface::initRequest()
 
     {
         auto selectAllArtistsWithFilterText = QStringLiteral("SELECT `ID`, "
-                                                            "`Name` "
+                                                            "`Name`, "
+                                                            "`AlbumsCount` "
                                                             "FROM `Artists`");
 
         auto result = d->mSelectAllArtistsQuery.prepare(selectAllArtistsWithFilterText);
@@ -1108,17 +2177,18 @@ void DatabaseInterface::initRequest()
                                                   "tracks.`AlbumID`, "
                                                   "artist.`Name`, "
                                                   "artistAlbum.`Name`, "
-                                                  "tracksMapping.`FileName`, "
+                                                  "directory.`Path` || tracksMapping.`FileName`, "
                                                   "tracks.`TrackNumber`, "
                                                   "tracks.`DiscNumber`, "
                                                   "tracks.`Duration`, "
                                                   "tracks.`Rating` "
-                                                  "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping "
+                                                  "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping, `Directories` directory "
                                                   "WHERE "
                                                   "artist.`ID` = tracks.`ArtistID` AND "
                                                   "tracks.`AlbumID` = album.`ID` AND "
                                                   "artistAlbum.`ID` = album.`ArtistID` AND "
                                                   "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                  "tracksMapping.`DirectoryID` = directory.`ID` AND "
                                                   "tracksMapping.`Priority` = 1");
 
         auto result = d->mSelectAllTracksQuery.prepare(selectAllTracksText);
@@ -1129,52 +2199,20 @@ void DatabaseInterface::initRequest()
         }
     }
 
-    {
-        auto selectAllInvalidTracksFromSourceQueryText = QStringLiteral("SELECT tracks.`ID`, "
-                                                                        "tracks.`Title`, "
-                                                                        "tracks.`AlbumID`, "
-                                                                        "artist.`Name`, "
-                                                                        "artistAlbum.`Name`, "
-                                                                        "tracksMapping.`FileName`, "
-                                                                        "tracks.`TrackNumber`, "
-                                                                        "tracks.`DiscNumber`, "
-                                                                        "tracks.`Duration`, "
-                                                                        "album.`Title`, "
-                                                                        "tracks.`Rating` "
-                                                                        "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, "
-                                                                        "`Albums` album , `TracksMapping` tracksMapping, `DiscoverSource` source "
-                                                                        "WHERE "
-                                                                        "artist.`ID` = tracks.`ArtistID` AND "
-                                                                        "tracks.`AlbumID` = album.`ID` AND "
-                                                                        "artistAlbum.`ID` = album.`ArtistID` AND "
-                                                                        "source.`Name` = :source AND "
-                                                                        "source.`ID` = tracksMapping.`DiscoverID` AND "
-                                                                        "tracksMapping.`TrackValid` = 0 AND "
-                                                                        "tracksMapping.`TrackID` = tracks.`ID` AND "
-                                                                        "tracksMapping.`Priority` = 1");
-
-        auto result = d->mSelectAllInvalidTracksFromSourceQuery.prepare(selectAllInvalidTracksFromSourceQueryText);
-
-        if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << selectAllInvalidTracksFromSourceQueryText << d->mSelectAllInvalidTracksFromSourceQuery.lastError();
-            qDebug() << d->mTracksDatabase.lastError();
-        }
-    }
-
     {
         auto selectAllTracksFromSourceQueryText = QStringLiteral("SELECT tracks.`ID`, "
                                                                  "tracks.`Title`, "
                                                                  "tracks.`AlbumID`, "
                                                                  "artist.`Name`, "
                                                                  "artistAlbum.`Name`, "
-                                                                 "tracksMapping.`FileName`, "
+                                                                 "directory.`Path` || tracksMapping.`FileName`, "
                                                                  "tracks.`TrackNumber`, "
                                                                  "tracks.`DiscNumber`, "
                                                                  "tracks.`Duration`, "
                                                                  "album.`Title`, "
                                                                  "tracks.`Rating` "
                                                                  "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, "
-                                                                 "`Albums` album , `TracksMapping` tracksMapping, `DiscoverSource` source "
+                                                                 "`Albums` album , `TracksMapping` tracksMapping, `Directories` directory, `DiscoverSource` source "
                                                                  "WHERE "
                                                                  "artist.`ID` = tracks.`ArtistID` AND "
                                                                  "tracks.`AlbumID` = album.`ID` AND "
@@ -1182,6 +2220,7 @@ void DatabaseInterface::initRequest()
                                                                  "source.`Name` = :source AND "
                                                                  "source.`ID` = tracksMapping.`DiscoverID` AND "
                                                                  "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                                 "tracksMapping.`DirectoryID` = directory.`ID` AND "
                                                                  "tracksMapping.`Priority` = 1");
 
         auto result = d->mSelectAllTracksFromSourceQuery.prepare(selectAllTracksFromSourceQueryText);
@@ -1192,21 +2231,6 @@ void DatabaseInterface::initRequest()
         }
     }
 
-    {
-        auto selectArtistByNameText = QStringLiteral("SELECT `ID`, "
-                                                     "`Name` "
-                                                     "FROM `Artists` "
-                                                     "WHERE "
-                                                     "`Name` = :name");
-
-        auto result = d->mSelectArtistByNameQuery.prepare(selectArtistByNameText);
-
-        if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << selectArtistByNameText << d->mSelectArtistByNameQuery.lastError();
-            qDebug() << d->mTracksDatabase.lastError();
-        }
-    }
-
     {
         auto insertArtistsText = QStringLiteral("INSERT INTO `Artists` (`ID`, `Name`) "
                                                              "VALUES (:artistId, :name)");
@@ -1226,14 +2250,15 @@ void DatabaseInterface::initRequest()
                                                    "tracks.`AlbumID`, "
                                                    "artist.`Name`, "
                                                    "artistAlbum.`Name`, "
-                                                   "tracksMapping.`FileName`, "
+                                                   "directory.`Path` || tracksMapping.`FileName`, "
                                                    "tracks.`TrackNumber`, "
                                                    "tracks.`DiscNumber`, "
                                                    "tracks.`Duration`, "
                                                    "tracks.`Rating` "
-                                                   "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping "
+                                                   "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping, `Directories` directory "
                                                    "WHERE "
                                                    "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                   "tracksMapping.`DirectoryID` = directory.`ID` AND "
                                                    "tracks.`AlbumID` = :albumId AND "
                                                    "artist.`ID` = tracks.`ArtistID` AND "
                                                    "album.`ID` = :albumId AND "
@@ -1256,19 +2281,20 @@ void DatabaseInterface::initRequest()
                                                          "tracks.`AlbumID`, "
                                                          "artist.`Name`, "
                                                          "artistAlbum.`Name`, "
-                                                         "tracksMapping.`FileName`, "
+                                                         "directory.`Path` || tracksMapping.`FileName`, "
                                                          "tracks.`TrackNumber`, "
                                                          "tracks.`DiscNumber`, "
                                                          "tracks.`Duration`, "
                                                          "tracks.`Rating`, "
                                                          "album.`CoverFileName` "
-                                                         "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping "
+                                                         "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping, `Directories` directory "
                                                          "WHERE "
                                                          "tracks.`ID` = :trackId AND "
                                                          "artist.`ID` = tracks.`ArtistID` AND "
                                                          "artistAlbum.`ID` = album.`ArtistID` AND "
                                                          "tracks.`AlbumID` = album.`ID` AND "
                                                          "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                         "tracksMapping.`DirectoryID` = directory.`ID` AND "
                                                          "tracksMapping.`Priority` = 1");
 
         auto result = d->mSelectTrackFromIdQuery.prepare(selectTrackFromIdQueryText);
@@ -1278,15 +2304,15 @@ void DatabaseInterface::initRequest()
         }
     }
     {
-        auto selectCountAlbumsQueryText = QStringLiteral("SELECT count(*) "
-                                                         "FROM `Albums` album, `Artists` artist "
-                                                         "WHERE artist.`Name` = :artistName AND "
-                                                         "artist.`ID` = album.`ArtistID`");
+        auto updateArtistAlbumsCountQueryText = QStringLiteral("UPDATE `Artists` "
+                                                               "SET `AlbumsCount` = (SELECT COUNT(*) FROM `Albums` WHERE `ArtistID` = :artistId) "
+                                                               "WHERE "
+                                                               "`ID` = :artistId");
 
-        const auto result = d->mSelectCountAlbumsForArtistQuery.prepare(selectCountAlbumsQueryText);
+        const auto result = d->mUpdateArtistAlbumsCountQuery.prepare(updateArtistAlbumsCountQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateArtistAlbumsCountQuery.lastError();
         }
     }
     {
@@ -1312,8 +2338,8 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto insertTrackMappingQueryText = QStringLiteral("INSERT INTO `TracksMapping` (`FileName`, `DiscoverID`, `Priority`, `TrackValid`) "
-                                                   "VALUES (:fileName, :discoverId, :priority, 1)");
+        auto insertTrackMappingQueryText = QStringLiteral("INSERT INTO `TracksMapping` (`DirectoryID`, `FileName`, `DiscoverID`, `Priority`, `TrackValid`, `ScanGeneration`) "
+                                                   "VALUES (:directoryId, :fileName, :discoverId, :priority, 1, :scanGeneration)");
 
         auto result = d->mInsertTrackMapping.prepare(insertTrackMappingQueryText);
 
@@ -1323,18 +2349,183 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `TracksMapping` SET `TrackValid` = 0");
+        auto updateTrackFileStatQueryText = QStringLiteral("UPDATE `TracksMapping` SET `FileSize` = :fileSize, "
+                                                           "`FileModifiedTime` = :fileModifiedTime, `FileInode` = :fileInode "
+                                                           "WHERE `DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directoryPath) AND "
+                                                           "`FileName` = :fileName");
+
+        auto result = d->mUpdateTrackFileStat.prepare(updateTrackFileStatQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackFileStat.lastError();
+        }
+    }
+
+    {
+        auto selectTrackFilesFromSourceQueryText = QStringLiteral("SELECT directory.`Path` || tracksMapping.`FileName`, tracksMapping.`FileSize`, "
+                                                                  "tracksMapping.`FileModifiedTime`, tracksMapping.`FileInode` "
+                                                                  "FROM `TracksMapping` tracksMapping, `Directories` directory, `DiscoverSource` source "
+                                                                  "WHERE "
+                                                                  "tracksMapping.`DirectoryID` = directory.`ID` AND "
+                                                                  "tracksMapping.`DiscoverID` = source.`ID` AND "
+                                                                  "source.`Name` = :source");
+
+        auto result = d->mSelectTrackFilesFromSourceQuery.prepare(selectTrackFilesFromSourceQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackFilesFromSourceQuery.lastError();
+        }
+    }
+
+    {
+        auto selectSourceScanGenerationQueryText = QStringLiteral("SELECT MAX(`ScanGeneration`) FROM ("
+                                                                  "SELECT MAX(`ScanGeneration`) AS `ScanGeneration` FROM `TracksMapping` "
+                                                                  "WHERE `DiscoverID` = :discoverId "
+                                                                  "UNION ALL "
+                                                                  "SELECT MAX(`ScanGeneration`) AS `ScanGeneration` FROM `ScannedDirectories` "
+                                                                  "WHERE `DiscoverID` = :discoverId)");
+
+        auto result = d->mSelectSourceScanGenerationQuery.prepare(selectSourceScanGenerationQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectSourceScanGenerationQuery.lastError();
+        }
+    }
+
+    {
+        auto selectScannedDirectoriesQueryText = QStringLiteral("SELECT `DirectoryID`, `ModifiedTime` FROM `ScannedDirectories` "
+                                                                "WHERE `DiscoverID` = :discoverId");
+
+        auto result = d->mSelectScannedDirectoriesQuery.prepare(selectScannedDirectoriesQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectScannedDirectoriesQuery.lastError();
+        }
+    }
+
+    {
+        auto updateDirectoryScanGenerationQueryText = QStringLiteral("INSERT OR REPLACE INTO `ScannedDirectories` (`DirectoryID`, `DiscoverID`, `ScanGeneration`, `ModifiedTime`) "
+                                                                     "VALUES (:directoryId, :discoverId, :scanGeneration, :modifiedTime)");
+
+        auto result = d->mUpdateDirectoryScanGenerationQuery.prepare(updateDirectoryScanGenerationQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateDirectoryScanGenerationQuery.lastError();
+        }
+    }
+
+    {
+        auto updateTrackScanGenerationQueryText = QStringLiteral("UPDATE `TracksMapping` SET `ScanGeneration` = :scanGeneration "
+                                                                 "WHERE `DirectoryID` = :directoryId AND `FileName` = :fileName AND `DiscoverID` = :discoverId");
+
+        auto result = d->mUpdateTrackScanGenerationQuery.prepare(updateTrackScanGenerationQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackScanGenerationQuery.lastError();
+        }
+    }
+
+    {
+        auto selectUnseenTrackFilesQueryText = QStringLiteral("SELECT directory.`Path` || tracksMapping.`FileName` "
+                                                              "FROM `TracksMapping` tracksMapping, `Directories` directory "
+                                                              "WHERE tracksMapping.`DirectoryID` = directory.`ID` AND "
+                                                              "tracksMapping.`DiscoverID` = :discoverId AND tracksMapping.`ScanGeneration` < :scanGeneration AND "
+                                                              "tracksMapping.`DirectoryID` NOT IN (SELECT `DirectoryID` FROM `ScannedDirectories` "
+                                                              "WHERE `DiscoverID` = :discoverId AND `ScanGeneration` < :scanGeneration)");
+
+        auto result = d->mSelectUnseenTrackFilesQuery.prepare(selectUnseenTrackFilesQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectUnseenTrackFilesQuery.lastError();
+        }
+    }
+
+    {
+        auto selectAlbumCoversQueryText = QStringLiteral("SELECT DISTINCT `CoverFileName` FROM `Albums`");
+
+        auto result = d->mSelectAlbumCoversQuery.prepare(selectAlbumCoversQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumCoversQuery.lastError();
+        }
+    }
+
+    {
+        auto removeUnseenTrackFilesQueryText = QStringLiteral("DELETE FROM `TracksMapping` "
+                                                              "WHERE `DiscoverID` = :discoverId AND `ScanGeneration` < :scanGeneration AND "
+                                                              "`DirectoryID` NOT IN (SELECT `DirectoryID` FROM `ScannedDirectories` "
+                                                              "WHERE `DiscoverID` = :discoverId AND `ScanGeneration` < :scanGeneration)");
+
+        auto result = d->mRemoveUnseenTrackFilesQuery.prepare(removeUnseenTrackFilesQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveUnseenTrackFilesQuery.lastError();
+        }
+    }
+
+    {
+        auto removeScannedDirectoryQueryText = QStringLiteral("DELETE FROM `ScannedDirectories` "
+                                                              "WHERE `DirectoryID` = :directoryId AND `DiscoverID` = :discoverId");
+
+        auto result = d->mRemoveScannedDirectoryQuery.prepare(removeScannedDirectoryQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveScannedDirectoryQuery.lastError();
+        }
+    }
+
+    {
+        auto selectDirectoryTreeTrackFilesQueryText = QStringLiteral("SELECT directory.`Path` || tracksMapping.`FileName` "
+                                                                     "FROM `TracksMapping` tracksMapping, `Directories` directory "
+                                                                     "WHERE tracksMapping.`DirectoryID` = directory.`ID` AND "
+                                                                     "directory.`Path` >= :directoryPath AND directory.`Path` < :directoryPathEnd");
+
+        auto result = d->mSelectDirectoryTreeTrackFilesQuery.prepare(selectDirectoryTreeTrackFilesQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectDirectoryTreeTrackFilesQuery.lastError();
+        }
+    }
+
+    {
+        auto removeDirectoryTreeTracksMappingQueryText = QStringLiteral("DELETE FROM `TracksMapping` "
+                                                                        "WHERE `DirectoryID` IN (SELECT `ID` FROM `Directories` "
+                                                                        "WHERE `Path` >= :directoryPath AND `Path` < :directoryPathEnd)");
+
+        auto result = d->mRemoveDirectoryTreeTracksMappingQuery.prepare(removeDirectoryTreeTracksMappingQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveDirectoryTreeTracksMappingQuery.lastError();
+        }
+    }
+
+    {
+        auto removeDirectoryTreeScansQueryText = QStringLiteral("DELETE FROM `ScannedDirectories` "
+                                                                "WHERE `DirectoryID` IN (SELECT `ID` FROM `Directories` "
+                                                                "WHERE `Path` >= :directoryPath AND `Path` < :directoryPathEnd)");
+
+        auto result = d->mRemoveDirectoryTreeScansQuery.prepare(removeDirectoryTreeScansQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveDirectoryTreeScansQuery.lastError();
+        }
+    }
+
+    {
+        auto removeDirectoryTreeQueryText = QStringLiteral("DELETE FROM `Directories` "
+                                                           "WHERE `Path` >= :directoryPath AND `Path` < :directoryPathEnd");
 
-        auto result = d->mInitialUpdateTracksValidity.prepare(initialUpdateTracksValidityQueryText);
+        auto result = d->mRemoveDirectoryTreeQuery.prepare(removeDirectoryTreeQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInitialUpdateTracksValidity.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveDirectoryTreeQuery.lastError();
         }
     }
 
     {
         auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `TracksMapping` SET `TrackValid` = 1, `TrackID` = :trackId, `Priority` = :priority "
-                                                                   "WHERE `FileName` = :fileName");
+                                                                   "WHERE `DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directoryPath) AND "
+                                                                   "`FileName` = :fileName");
 
         auto result = d->mUpdateTrackMapping.prepare(initialUpdateTracksValidityQueryText);
 
@@ -1344,7 +2535,9 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto selectTracksMappingQueryText = QStringLiteral("SELECT `TrackID`, `FileName`, `DiscoverID`, `Priority` FROM `TracksMapping` WHERE `FileName` = :fileName");
+        auto selectTracksMappingQueryText = QStringLiteral("SELECT `TrackID`, `FileName`, `DiscoverID`, `Priority` FROM `TracksMapping` "
+                                                           "WHERE `DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directoryPath) AND "
+                                                           "`FileName` = :fileName");
 
         auto result = d->mSelectTracksMapping.prepare(selectTracksMappingQueryText);
 
@@ -1354,7 +2547,9 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto selectTracksMappingPriorityQueryText = QStringLiteral("SELECT count(*) FROM `TracksMapping` WHERE `TrackID` = :trackId AND `FileName` != :fileName");
+        auto selectTracksMappingPriorityQueryText = QStringLiteral("SELECT count(*) FROM `TracksMapping` WHERE `TrackID` = :trackId AND "
+                                                                   "NOT (`DirectoryID` IS (SELECT `ID` FROM `Directories` WHERE `Path` = :directoryPath) AND "
+                                                                   "`FileName` = :fileName)");
 
         auto result = d->mSelectTracksMappingPriority.prepare(selectTracksMappingPriorityQueryText);
 
@@ -1375,25 +2570,27 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto selectMusicSourceQueryText = QStringLiteral("SELECT `ID` FROM `DiscoverSource` WHERE `Name` = :name");
+        auto insertDirectoryQueryText = QStringLiteral("INSERT OR IGNORE INTO `Directories` (`ID`, `Path`) "
+                                                       "VALUES (:directoryId, :path)");
 
-        auto result = d->mSelectMusicSource.prepare(selectMusicSourceQueryText);
+        auto result = d->mInsertDirectoryQuery.prepare(insertDirectoryQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << d->mInsertDirectoryQuery.lastError();
         }
     }
 
     {
         auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.`ID`,  tracksMapping.`FileName` "
-                                                   "FROM `Tracks` tracks, `Artists` artist, `TracksMapping` tracksMapping "
+                                                   "tracks.`ID`, directory.`Path` || tracksMapping.`FileName` "
+                                                   "FROM `Tracks` tracks, `Artists` artist, `TracksMapping` tracksMapping, `Directories` directory "
                                                    "WHERE "
                                                    "tracks.`Title` = :title AND "
                                                    "tracks.`AlbumID` = :album AND "
                                                    "artist.`Name` = :artist AND "
                                                    "artist.`ID` = tracks.`ArtistID` AND "
                                                    "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                   "tracksMapping.`DirectoryID` = directory.`ID` AND "
                                                    "tracksMapping.`Priority` = 1");
 
         auto result = d->mSelectTrackIdFromTitleAlbumIdArtistQuery.prepare(selectTrackQueryText);
@@ -1473,7 +2670,7 @@ void DatabaseInterface::initRequest()
                                                               "tracks.`Title`, "
                                                               "tracks.`ID`, "
                                                               "artist.`Name`, "
-                                                              "tracksMapping.`FileName`, "
+                                                              "directory.`Path` || tracksMapping.`FileName`, "
                                                               "tracks.`TrackNumber`, "
                                                               "tracks.`DiscNumber`, "
                                                               "tracks.`Duration`, "
@@ -1481,13 +2678,14 @@ void DatabaseInterface::initRequest()
                                                               "albums.`Title`, "
                                                               "albumArtist.`Name`, "
                                                               "tracks.`Rating` "
-                                                              "FROM `Tracks` tracks, `Albums` albums, `Artists` artist, `Artists` albumArtist, `TracksMapping` tracksMapping "
+                                                              "FROM `Tracks` tracks, `Albums` albums, `Artists` artist, `Artists` albumArtist, `TracksMapping` tracksMapping, `Directories` directory "
                                                               "WHERE "
                                                               "artist.`Name` = :artistName AND "
                                                               "tracks.`AlbumID` = albums.`ID` AND "
                                                               "artist.`ID` = tracks.`ArtistID` AND "
                                                               "albumArtist.`ID` = albums.`ArtistID` AND "
                                                               "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                              "tracksMapping.`DirectoryID` = directory.`ID` AND "
                                                               "tracksMapping.`Priority` = 1 "
                                                               "ORDER BY tracks.`Title` ASC, "
                                                               "albums.`Title` ASC");
@@ -1501,7 +2699,8 @@ void DatabaseInterface::initRequest()
 
     {
         auto selectArtistQueryText = QStringLiteral("SELECT `ID`, "
-                                                     "`Name` "
+                                                     "`Name`, "
+                                                     "`AlbumsCount` "
                                                      "FROM `Artists` "
                                                      "WHERE "
                                                      "`ID` = :artistId");
@@ -1521,19 +2720,21 @@ void DatabaseInterface::initRequest()
                                                                "tracks.`AlbumID`, "
                                                                "artist.`Name`, "
                                                                "artistAlbum.`Name`, "
-                                                               "tracksMapping.`FileName`, "
+                                                               "directory.`Path` || tracksMapping.`FileName`, "
                                                                "tracks.`TrackNumber`, "
                                                                "tracks.`DiscNumber`, "
                                                                "tracks.`Duration`, "
                                                                "album.`Title`, "
                                                                "tracks.`Rating` "
-                                                               "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping "
+                                                               "FROM `Tracks` tracks, `Artists` artist, `Artists` artistAlbum, `Albums` album, `TracksMapping` tracksMapping, `Directories` directory "
                                                                "WHERE "
                                                                "tracks.`AlbumID` = album.`ID` AND "
                                                                "artist.`ID` = tracks.`ArtistID` AND "
                                                                "artistAlbum.`ID` = album.`ArtistID` AND "
                                                                "tracksMapping.`TrackID` = tracks.`ID` AND "
-                                                               "tracksMapping.`FileName` = :filePath AND "
+                                                               "tracksMapping.`DirectoryID` = directory.`ID` AND "
+                                                               "tracksMapping.`DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directoryPath) AND "
+                                                               "tracksMapping.`FileName` = :fileName AND "
                                                                "tracksMapping.`Priority` = 1");
 
         auto result = d->mSelectTrackFromFilePathQuery.prepare(selectTrackFromFilePathQueryText);
@@ -1583,6 +2784,90 @@ void DatabaseInterface::initRequest()
         }
     }
 
+    {
+        auto selectAlbumTracksKeysQueryText = QStringLiteral("SELECT "
+                                                             "album.`CoverFileName`, "
+                                                             "albumArtist.`Name`, "
+                                                             "tracks.`Title`, "
+                                                             "tracks.`ArtistID` "
+                                                             "FROM `Albums` album "
+                                                             "INNER JOIN `Artists` albumArtist ON albumArtist.`ID` = album.`ArtistID` "
+                                                             "LEFT OUTER JOIN `Tracks` tracks ON tracks.`AlbumID` = album.`ID` "
+                                                             "WHERE "
+                                                             "album.`ID` = :albumId");
+
+        auto result = d->mSelectAlbumTracksKeysQuery.prepare(selectAlbumTracksKeysQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumTracksKeysQuery.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumTracksKeysQuery.lastQuery();
+        }
+    }
+
+    {
+        auto updateAlbumSearchQueryText = QStringLiteral("UPDATE `AlbumsSearch` "
+                                                         "SET `AllArtists` = "
+                                                         "(SELECT group_concat(artist.`Name`, ' ') FROM `Tracks` tracks, `Artists` artist "
+                                                         "WHERE tracks.`AlbumID` = :albumId AND artist.`ID` = tracks.`ArtistID`) "
+                                                         "WHERE "
+                                                         "rowid = :albumId");
+
+        auto result = d->mUpdateAlbumSearchQuery.prepare(updateAlbumSearchQueryText);
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumSearchQuery.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << updateAlbumSearchQueryText;
+        }
+    }
+
+    {
+        auto searchAlbumsText = QStringLiteral("SELECT rowid FROM `AlbumsSearch` "
+                                               "WHERE `AlbumsSearch` MATCH :searchText");
+
+        auto result = d->mSearchAlbumsQuery.prepare(searchAlbumsText + QStringLiteral(" ORDER BY rank"));
+
+        if (!result) {
+            result = d->mSearchAlbumsQuery.prepare(searchAlbumsText);
+        }
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSearchAlbumsQuery.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << searchAlbumsText;
+        }
+    }
+
+    {
+        auto searchArtistsText = QStringLiteral("SELECT rowid FROM `ArtistsSearch` "
+                                                "WHERE `ArtistsSearch` MATCH :searchText");
+
+        auto result = d->mSearchArtistsQuery.prepare(searchArtistsText + QStringLiteral(" ORDER BY rank"));
+
+        if (!result) {
+            result = d->mSearchArtistsQuery.prepare(searchArtistsText);
+        }
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSearchArtistsQuery.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << searchArtistsText;
+        }
+    }
+
+    {
+        auto searchTracksText = QStringLiteral("SELECT rowid FROM `TracksSearch` "
+                                               "WHERE `TracksSearch` MATCH :searchText");
+
+        auto result = d->mSearchTracksQuery.prepare(searchTracksText + QStringLiteral(" ORDER BY rank"));
+
+        if (!result) {
+            result = d->mSearchTracksQuery.prepare(searchTracksText);
+        }
+
+        if (!result) {
+            qDebug() << "DatabaseInterface::initRequest" << d->mSearchTracksQuery.lastError();
+            qDebug() << "DatabaseInterface::initRequest" << searchTracksText;
+        }
+    }
+
     transactionResult = finishTransaction();
 
     d->mInitFinished = true;
@@ -1597,39 +2882,22 @@ qulonglong DatabaseInterface::insertAlbum(QString title, QString albumArtist, QU
         return result;
     }
 
-    d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":title"), title);
-    d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":artistId"), insertArtist(albumArtist));
-
-    auto queryResult = d->mSelectAlbumIdFromTitleQuery.exec();
-
-    if (!queryResult || !d->mSelectAlbumIdFromTitleQuery.isSelect() || !d->mSelectAlbumIdFromTitleQuery.isActive()) {
-        qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleQuery.lastError();
-
-        d->mSelectAlbumIdFromTitleQuery.finish();
-
-        return result;
-    }
-
-    if (d->mSelectAlbumIdFromTitleQuery.next()) {
-        result = d->mSelectAlbumIdFromTitleQuery.record().value(0).toULongLong();
-
-        d->mSelectAlbumIdFromTitleQuery.finish();
+    auto artistId = insertArtist(albumArtist);
+    const auto &albumKey = qMakePair(title, artistId);
 
+    result = d->mAlbumIds.value(albumKey);
+    if (result != 0) {
         return result;
     }
 
-    d->mSelectAlbumIdFromTitleQuery.finish();
-
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":albumId"), d->mAlbumId);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":title"), title);
-    d->mInsertAlbumQuery.bindValue(QStringLiteral(":artistId"), insertArtist(albumArtist));
+    d->mInsertAlbumQuery.bindValue(QStringLiteral(":artistId"), artistId);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":coverFileName"), albumArtURI);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":tracksCount"), tracksCount);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":isSingleDiscAlbum"), isSingleDiscAlbum);
 
-    queryResult = d->mInsertAlbumQuery.exec();
+    auto queryResult = d->mInsertAlbumQuery.exec();
 
     if (!queryResult || !d->mInsertAlbumQuery.isActive()) {
         qDebug() << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.lastQuery();
@@ -1643,13 +2911,37 @@ qulonglong DatabaseInterface::insertAlbum(QString title, QString albumArtist, QU
 
     result = d->mAlbumId;
 
-    ++d->mAlbumId;
+    d->mAlbumIds[albumKey] = result;
+    d->mAlbumKeys[result] = albumKey;
+
+    ++d->mAlbumId;
+
+    d->mInsertAlbumQuery.finish();
+
+    updateArtistAlbumsCount(artistId);
+
+    const auto &newAlbum = internalAlbumFromId(d->mAlbumId - 1);
+    d->mAddedAlbums.push_back(newAlbum);
+    Q_EMIT albumAdded(newAlbum);
+
+    return result;
+}
+
+void DatabaseInterface::updateArtistAlbumsCount(qulonglong artistId) const
+{
+    d->mUpdateArtistAlbumsCountQuery.bindValue(QStringLiteral(":artistId"), artistId);
 
-    d->mInsertAlbumQuery.finish();
+    auto result = d->mUpdateArtistAlbumsCountQuery.exec();
 
-    Q_EMIT albumAdded(internalAlbumFromId(d->mAlbumId - 1));
+    if (!result || !d->mUpdateArtistAlbumsCountQuery.isActive()) {
+        qDebug() << "DatabaseInterface::updateArtistAlbumsCount" << d->mUpdateArtistAlbumsCountQuery.lastQuery();
+        qDebug() << "DatabaseInterface::updateArtistAlbumsCount" << d->mUpdateArtistAlbumsCountQuery.boundValues();
+        qDebug() << "DatabaseInterface::updateArtistAlbumsCount" << d->mUpdateArtistAlbumsCountQuery.lastError();
+    } else {
+        updateArtistLater(artistId);
+    }
 
-    return result;
+    d->mUpdateArtistAlbumsCountQuery.finish();
 }
 
 void DatabaseInterface::updateIsSingleDiscAlbumFromId(qulonglong albumId) const
@@ -1671,42 +2963,63 @@ void DatabaseInterface::updateIsSingleDiscAlbumFromId(qulonglong albumId) const
     d->mUpdateIsSingleDiscAlbumFromIdQuery.finish();
 }
 
-qulonglong DatabaseInterface::insertArtist(QString name)
+void DatabaseInterface::updateAlbumSearchEntry(qulonglong albumId) const
 {
-    auto result = qulonglong(0);
+    d->mUpdateAlbumSearchQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
-    if (name.isEmpty()) {
-        return result;
+    auto result = d->mUpdateAlbumSearchQuery.exec();
+
+    if (!result || !d->mUpdateAlbumSearchQuery.isActive()) {
+        qDebug() << "DatabaseInterface::updateAlbumSearchEntry" << d->mUpdateAlbumSearchQuery.lastQuery();
+        qDebug() << "DatabaseInterface::updateAlbumSearchEntry" << d->mUpdateAlbumSearchQuery.boundValues();
+        qDebug() << "DatabaseInterface::updateAlbumSearchEntry" << d->mUpdateAlbumSearchQuery.lastError();
     }
 
-    d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
+    d->mUpdateAlbumSearchQuery.finish();
+}
+
+bool DatabaseInterface::internalSearchIds(QSqlQuery &searchQuery, const QString &matchText, QList<qulonglong> &ids) const
+{
+    searchQuery.bindValue(QStringLiteral(":searchText"), matchText);
 
-    auto queryResult = d->mSelectArtistByNameQuery.exec();
+    auto result = searchQuery.exec();
 
-    if (!queryResult || !d->mSelectArtistByNameQuery.isSelect() || !d->mSelectArtistByNameQuery.isActive()) {
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
+    if (!result || !searchQuery.isSelect() || !searchQuery.isActive()) {
+        qDebug() << "DatabaseInterface::internalSearchIds" << searchQuery.lastQuery();
+        qDebug() << "DatabaseInterface::internalSearchIds" << searchQuery.boundValues();
+        qDebug() << "DatabaseInterface::internalSearchIds" << searchQuery.lastError();
 
-        d->mSelectArtistByNameQuery.finish();
+        searchQuery.finish();
 
-        return result;
+        return false;
+    }
+
+    while (searchQuery.next()) {
+        ids.push_back(searchQuery.record().value(0).toULongLong());
     }
 
-    if (d->mSelectArtistByNameQuery.next()) {
-        result = d->mSelectArtistByNameQuery.record().value(0).toULongLong();
+    searchQuery.finish();
+
+    return true;
+}
 
-        d->mSelectArtistByNameQuery.finish();
+qulonglong DatabaseInterface::insertArtist(QString name)
+{
+    auto result = qulonglong(0);
 
+    if (name.isEmpty()) {
         return result;
     }
 
-    d->mSelectArtistByNameQuery.finish();
+    result = d->mArtistIds.value(name);
+    if (result != 0) {
+        return result;
+    }
 
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":artistId"), d->mArtistId);
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertArtistsQuery.exec();
+    auto queryResult = d->mInsertArtistsQuery.exec();
 
     if (!queryResult || !d->mInsertArtistsQuery.isActive()) {
         qDebug() << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.lastQuery();
@@ -1720,20 +3033,31 @@ qulonglong DatabaseInterface::insertArtist(QString name)
 
     result = d->mArtistId;
 
+    d->mArtistIds[name] = result;
+    d->mArtistNames[result] = name;
+
     ++d->mArtistId;
 
     d->mInsertArtistsQuery.finish();
 
-    Q_EMIT artistAdded(internalArtistFromId(d->mArtistId - 1));
+    const auto &newArtist = internalArtistFromId(d->mArtistId - 1);
+    d->mAddedArtists.push_back(newArtist);
+    Q_EMIT artistAdded(newArtist);
 
     return result;
 }
 
 void DatabaseInterface::insertTrackOrigin(QUrl fileNameURI, qulonglong discoverId)
 {
+    auto directoryPath = QString();
+    auto baseName = QString();
+    splitFileName(fileNameURI.toString(), directoryPath, baseName);
+
     d->mInsertTrackMapping.bindValue(QStringLiteral(":discoverId"), discoverId);
-    d->mInsertTrackMapping.bindValue(QStringLiteral(":fileName"), fileNameURI);
+    d->mInsertTrackMapping.bindValue(QStringLiteral(":directoryId"), insertDirectory(directoryPath));
+    d->mInsertTrackMapping.bindValue(QStringLiteral(":fileName"), baseName);
     d->mInsertTrackMapping.bindValue(QStringLiteral(":priority"), 1);
+    d->mInsertTrackMapping.bindValue(QStringLiteral(":scanGeneration"), d->mScanGenerations.value(discoverId));
 
     auto queryResult = d->mInsertTrackMapping.exec();
 
@@ -1753,7 +3077,7 @@ void DatabaseInterface::insertTrackOrigin(QUrl fileNameURI, qulonglong discoverI
 void DatabaseInterface::updateTrackOrigin(qulonglong trackId, QUrl fileName)
 {
     d->mUpdateTrackMapping.bindValue(QStringLiteral(":trackId"), trackId);
-    d->mUpdateTrackMapping.bindValue(QStringLiteral(":fileName"), fileName);
+    bindFileName(d->mUpdateTrackMapping, fileName);
     d->mUpdateTrackMapping.bindValue(QStringLiteral(":priority"), computeTrackPriority(trackId, fileName) + 1);
 
     auto queryResult = d->mUpdateTrackMapping.exec();
@@ -1771,6 +3095,38 @@ void DatabaseInterface::updateTrackOrigin(qulonglong trackId, QUrl fileName)
     d->mInsertTrackMapping.finish();
 }
 
+void DatabaseInterface::appendFileStatValues(const MusicAudioTrack &track, QVariantList &values) const
+{
+    if (!track.fileModificationTime().isValid()) {
+        values << QVariant() << QVariant() << QVariant();
+        return;
+    }
+
+    values << track.fileSize() << track.fileModificationTime().toMSecsSinceEpoch() << track.fileInode();
+}
+
+void DatabaseInterface::updateTrackFileStat(const MusicAudioTrack &track)
+{
+    if (!track.fileModificationTime().isValid()) {
+        return;
+    }
+
+    bindFileName(d->mUpdateTrackFileStat, track.resourceURI());
+    d->mUpdateTrackFileStat.bindValue(QStringLiteral(":fileSize"), track.fileSize());
+    d->mUpdateTrackFileStat.bindValue(QStringLiteral(":fileModifiedTime"), track.fileModificationTime().toMSecsSinceEpoch());
+    d->mUpdateTrackFileStat.bindValue(QStringLiteral(":fileInode"), track.fileInode());
+
+    auto queryResult = d->mUpdateTrackFileStat.exec();
+
+    if (!queryResult || !d->mUpdateTrackFileStat.isActive()) {
+        qDebug() << "DatabaseInterface::updateTrackFileStat" << d->mUpdateTrackFileStat.lastQuery();
+        qDebug() << "DatabaseInterface::updateTrackFileStat" << d->mUpdateTrackFileStat.boundValues();
+        qDebug() << "DatabaseInterface::updateTrackFileStat" << d->mUpdateTrackFileStat.lastError();
+    }
+
+    d->mUpdateTrackFileStat.finish();
+}
+
 int DatabaseInterface::computeTrackPriority(qulonglong trackId, QUrl fileName)
 {
     auto result = int(0);
@@ -1780,7 +3136,7 @@ int DatabaseInterface::computeTrackPriority(qulonglong trackId, QUrl fileName)
     }
 
     d->mSelectTracksMappingPriority.bindValue(QStringLiteral(":trackId"), trackId);
-    d->mSelectTracksMappingPriority.bindValue(QStringLiteral(":fileName"), fileName);
+    bindFileName(d->mSelectTracksMappingPriority, fileName);
 
     auto queryResult = d->mSelectTracksMappingPriority.exec();
 
@@ -1843,14 +3199,20 @@ void DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrack, con
         updateTrackOrigin(originTrackId, oneTrack.resourceURI());
 
         if (isModifiedTrack) {
-            Q_EMIT trackModified(internalTrackFromDatabaseId(originTrackId));
-            Q_EMIT albumModified(internalAlbumFromId(albumId));
+            const auto &modifiedTrack = internalTrackFromDatabaseId(originTrackId);
+            d->mModifiedTracks.push_back(modifiedTrack);
+            Q_EMIT trackModified(modifiedTrack);
+
+            const auto &modifiedAlbum = internalAlbumFromId(albumId);
+            d->mModifiedAlbums.push_back(modifiedAlbum);
+            Q_EMIT albumModified(modifiedAlbum);
         } else {
-            Q_EMIT trackAdded(internalTrackFromDatabaseId(originTrackId));
+            const auto &newTrack = internalTrackFromDatabaseId(originTrackId);
+            d->mAddedTracks.push_back(newTrack);
+            Q_EMIT trackAdded(newTrack);
         }
 
-        updateIsSingleDiscAlbumFromId(albumId);
-        updateTracksCount(albumId);
+        updateAlbumLater(albumId);
     } else {
         d->mInsertTrackQuery.finish();
 
@@ -1860,37 +3222,290 @@ void DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrack, con
     }
 }
 
-qulonglong DatabaseInterface::internalArtistIdFromName(QString name)
+bool DatabaseInterface::internalInsertTracksBatch(const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers,
+                                                  const QString &musicSource, QList<MusicAudioTrack> &otherTracks)
 {
-    auto result = qulonglong(0);
+    auto existingFileNames = QSet<QString>();
 
-    if (name.isEmpty()) {
+    auto result = internalExistingFileNames(tracks, existingFileNames);
+    if (!result) {
         return result;
     }
 
-    d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
+    auto discoverId = qulonglong(0);
+    auto albumsData = QHash<qulonglong, MusicAlbum>();
+    auto albumsTracksKeys = QHash<qulonglong, QSet<QPair<QString, qulonglong>>>();
+    auto modifiedAlbumIds = QList<qulonglong>();
+    auto newTracks = QList<MusicAudioTrack>();
+    auto newTracksFiles = QList<MusicAudioTrack>();
+    auto tracksValues = QVariantList();
+    auto tracksMappingValues = QVariantList();
+
+    for (const auto &oneTrack : tracks) {
+        const auto &fileName = oneTrack.resourceURI().toString();
+
+        if (oneTrack.albumArtist().isEmpty() || oneTrack.albumName().isEmpty() || oneTrack.artist().isEmpty() ||
+                existingFileNames.contains(fileName)) {
+            otherTracks.push_back(oneTrack);
+            continue;
+        }
+
+        existingFileNames.insert(fileName);
+
+        auto albumId = insertAlbum(oneTrack.albumName(), oneTrack.albumArtist(), covers[oneTrack.albumName()], 0, true);
+
+        if (albumId == 0) {
+            otherTracks.push_back(oneTrack);
+            continue;
+        }
+
+        if (!albumsData.contains(albumId)) {
+            result = internalAlbumTracksKeys(albumId, albumsData[albumId], albumsTracksKeys[albumId]);
+            if (!result) {
+                return result;
+            }
+        }
+
+        auto artistId = insertArtist(oneTrack.artist());
+
+        if (artistId == 0) {
+            otherTracks.push_back(oneTrack);
+            continue;
+        }
+
+        auto &albumTracksKeys = albumsTracksKeys[albumId];
+        const auto &trackKey = qMakePair(oneTrack.title(), artistId);
+
+        if (albumTracksKeys.contains(trackKey)) {
+            otherTracks.push_back(oneTrack);
+            continue;
+        }
+
+        albumTracksKeys.insert(trackKey);
+
+        if (discoverId == 0) {
+            discoverId = insertMusicSource(musicSource);
+        }
+
+        if (!modifiedAlbumIds.contains(albumId)) {
+            modifiedAlbumIds.push_back(albumId);
+        }
+
+        const auto &albumData = albumsData[albumId];
+        auto trackId = d->mTrackId;
+        ++d->mTrackId;
+
+        tracksValues << trackId << oneTrack.title() << albumId << artistId << oneTrack.trackNumber() << oneTrack.discNumber()
+                     << QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()) << oneTrack.rating();
 
-    auto queryResult = d->mSelectArtistByNameQuery.exec();
+        auto directoryPath = QString();
+        auto baseName = QString();
+        splitFileName(fileName, directoryPath, baseName);
 
-    if (!queryResult || !d->mSelectArtistByNameQuery.isSelect() || !d->mSelectArtistByNameQuery.isActive()) {
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
+        tracksMappingValues << insertDirectory(directoryPath) << baseName << discoverId << 1 << 1 << trackId;
+        appendFileStatValues(oneTrack, tracksMappingValues);
+        tracksMappingValues << d->mScanGenerations.value(discoverId);
+
+        MusicAudioTrack newTrack;
+
+        newTrack.setDatabaseId(trackId);
+        newTrack.setTitle(oneTrack.title());
+        newTrack.setAlbumName(oneTrack.albumName());
+        newTrack.setArtist(oneTrack.artist());
+        newTrack.setAlbumArtist(albumData.artist());
+        newTrack.setResourceURI(oneTrack.resourceURI());
+        newTrack.setAlbumCover(albumData.albumArtURI());
+        newTrack.setTrackNumber(oneTrack.trackNumber());
+        newTrack.setDiscNumber(oneTrack.discNumber());
+        newTrack.setDuration(oneTrack.duration());
+        newTrack.setRating(oneTrack.rating());
+        newTrack.setValid(true);
 
-        d->mSelectArtistByNameQuery.finish();
+        newTracks.push_back(newTrack);
+        newTracksFiles.push_back(oneTrack);
+    }
 
+    if (newTracks.isEmpty()) {
         return result;
     }
 
-    if (!d->mSelectArtistByNameQuery.next()) {
-        d->mSelectArtistByNameQuery.finish();
+    result = insertMultipleRows(QStringLiteral("INSERT INTO `Tracks` (`ID`, `Title`, `AlbumID`, `ArtistID`, `TrackNumber`, `DiscNumber`, `Duration`, `Rating`) VALUES "),
+                                8, tracksValues);
+    if (!result) {
+        return result;
+    }
 
+    result = insertMultipleRows(QStringLiteral("INSERT INTO `TracksMapping` (`DirectoryID`, `FileName`, `DiscoverID`, `Priority`, `TrackValid`, `TrackID`, "
+                                               "`FileSize`, `FileModifiedTime`, `FileInode`, `ScanGeneration`) VALUES "),
+                                10, tracksMappingValues);
+    if (!result) {
         return result;
     }
 
-    result = d->mSelectArtistByNameQuery.record().value(0).toULongLong();
+    d->mAddedTracks.append(newTracks);
+
+    for (const auto &oneTrack : newTracks) {
+        Q_EMIT trackAdded(oneTrack);
+    }
+
+    for (auto oneAlbumId : modifiedAlbumIds) {
+        updateAlbumLater(oneAlbumId);
+    }
+
+    for (const auto &oneTrack : newTracksFiles) {
+        Q_EMIT newTrackFile(oneTrack);
+    }
+
+    return result;
+}
+
+bool DatabaseInterface::internalExistingFileNames(const QList<MusicAudioTrack> &tracks, QSet<QString> &existingFileNames) const
+{
+    auto result = true;
+
+    auto knownFiles = QVariantList();
+
+    for (const auto &oneTrack : tracks) {
+        auto directoryPath = QString();
+        auto baseName = QString();
+        splitFileName(oneTrack.resourceURI().toString(), directoryPath, baseName);
+
+        auto itDirectory = d->mDirectoryIds.constFind(directoryPath);
+        if (itDirectory == d->mDirectoryIds.constEnd()) {
+            continue;
+        }
+
+        knownFiles << itDirectory.value() << baseName;
+    }
+
+    const auto filesPerQuery = sqliteMaximumBoundValues / 2;
+    const auto filesCount = knownFiles.size() / 2;
+
+    for (int firstIndex = 0; firstIndex < filesCount; firstIndex += filesPerQuery) {
+        auto lastIndex = std::min(firstIndex + filesPerQuery, filesCount);
+
+        auto conditions = QStringList();
+        for (int i = firstIndex; i < lastIndex; ++i) {
+            conditions.push_back(QStringLiteral("(tracksMapping.`DirectoryID` = ? AND tracksMapping.`FileName` = ?)"));
+        }
+
+        QSqlQuery selectFileNamesQuery(d->mTracksDatabase);
+
+        result = selectFileNamesQuery.prepare(QStringLiteral("SELECT directory.`Path` || tracksMapping.`FileName` "
+                                                             "FROM `TracksMapping` tracksMapping, `Directories` directory "
+                                                             "WHERE tracksMapping.`DirectoryID` = directory.`ID` AND (") +
+                                              conditions.join(QStringLiteral(" OR ")) + QStringLiteral(")"));
+
+        if (result) {
+            for (int i = 2 * firstIndex; i < 2 * lastIndex; ++i) {
+                selectFileNamesQuery.addBindValue(knownFiles[i]);
+            }
+
+            result = selectFileNamesQuery.exec();
+        }
+
+        if (!result || !selectFileNamesQuery.isSelect() || !selectFileNamesQuery.isActive()) {
+            qDebug() << "DatabaseInterface::internalExistingFileNames" << selectFileNamesQuery.lastQuery();
+            qDebug() << "DatabaseInterface::internalExistingFileNames" << selectFileNamesQuery.lastError();
+
+            return false;
+        }
+
+        while (selectFileNamesQuery.next()) {
+            existingFileNames.insert(selectFileNamesQuery.record().value(0).toString());
+        }
+    }
+
+    return result;
+}
+
+bool DatabaseInterface::internalAlbumTracksKeys(qulonglong albumId, MusicAlbum &albumData, QSet<QPair<QString, qulonglong>> &tracksKeys) const
+{
+    d->mSelectAlbumTracksKeysQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    auto result = d->mSelectAlbumTracksKeysQuery.exec();
+
+    if (!result || !d->mSelectAlbumTracksKeysQuery.isSelect() || !d->mSelectAlbumTracksKeysQuery.isActive()) {
+        qDebug() << "DatabaseInterface::internalAlbumTracksKeys" << d->mSelectAlbumTracksKeysQuery.lastQuery();
+        qDebug() << "DatabaseInterface::internalAlbumTracksKeys" << d->mSelectAlbumTracksKeysQuery.boundValues();
+        qDebug() << "DatabaseInterface::internalAlbumTracksKeys" << d->mSelectAlbumTracksKeysQuery.lastError();
+
+        d->mSelectAlbumTracksKeysQuery.finish();
+
+        return false;
+    }
+
+    while (d->mSelectAlbumTracksKeysQuery.next()) {
+        const auto &currentRecord = d->mSelectAlbumTracksKeysQuery.record();
+
+        albumData.setAlbumArtURI(currentRecord.value(0).toUrl());
+        albumData.setArtist(currentRecord.value(1).toString());
+
+        if (!currentRecord.isNull(2)) {
+            tracksKeys.insert(qMakePair(currentRecord.value(2).toString(), currentRecord.value(3).toULongLong()));
+        }
+    }
+
+    d->mSelectAlbumTracksKeysQuery.finish();
+
+    return result;
+}
+
+bool DatabaseInterface::insertMultipleRows(const QString &insertText, int columnsCount, const QVariantList &values) const
+{
+    auto result = true;
+
+    const auto rowsPerQuery = std::max(1, sqliteMaximumBoundValues / columnsCount);
+    const auto rowsCount = values.size() / columnsCount;
+
+    auto rowPlaceholders = QStringList();
+    for (int i = 0; i < columnsCount; ++i) {
+        rowPlaceholders.push_back(QStringLiteral("?"));
+    }
+    const auto rowText = QStringLiteral("(") + rowPlaceholders.join(QStringLiteral(", ")) + QStringLiteral(")");
+
+    for (int firstRow = 0; firstRow < rowsCount; firstRow += rowsPerQuery) {
+        auto lastRow = std::min(firstRow + rowsPerQuery, rowsCount);
+
+        auto allRowsText = QStringList();
+        for (int i = firstRow; i < lastRow; ++i) {
+            allRowsText.push_back(rowText);
+        }
+
+        QSqlQuery insertRowsQuery(d->mTracksDatabase);
+
+        result = insertRowsQuery.prepare(insertText + allRowsText.join(QStringLiteral(", ")));
+
+        if (result) {
+            for (int i = firstRow * columnsCount; i < lastRow * columnsCount; ++i) {
+                insertRowsQuery.addBindValue(values[i]);
+            }
+
+            result = insertRowsQuery.exec();
+        }
+
+        if (!result || !insertRowsQuery.isActive()) {
+            qDebug() << "DatabaseInterface::insertMultipleRows" << insertRowsQuery.lastQuery();
+            qDebug() << "DatabaseInterface::insertMultipleRows" << insertRowsQuery.lastError();
+
+            return false;
+        }
+
+        insertRowsQuery.finish();
+    }
+
+    return result;
+}
+
+qulonglong DatabaseInterface::internalArtistIdFromName(QString name)
+{
+    auto result = qulonglong(0);
+
+    if (name.isEmpty()) {
+        return result;
+    }
 
-    d->mSelectArtistByNameQuery.finish();
+    result = d->mArtistIds.value(name);
 
     return result;
 }
@@ -1920,6 +3535,12 @@ void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
         qDebug() << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastQuery();
         qDebug() << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.boundValues();
         qDebug() << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastError();
+    } else {
+        const auto &albumKey = d->mAlbumKeys.take(albumId);
+
+        d->mAlbumIds.remove(albumKey);
+
+        updateArtistAlbumsCount(albumKey.second);
     }
 
     d->mRemoveAlbumQuery.finish();
@@ -1935,11 +3556,99 @@ void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
         qDebug() << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
         qDebug() << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
         qDebug() << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
+    } else {
+        d->mArtistIds.remove(d->mArtistNames.take(artistId));
     }
 
     d->mRemoveArtistQuery.finish();
 }
 
+void DatabaseInterface::loadIdCaches() const
+{
+    d->mArtistIds.clear();
+    d->mArtistNames.clear();
+    d->mAlbumIds.clear();
+    d->mAlbumKeys.clear();
+    d->mDiscoverIds.clear();
+    d->mDirectoryIds.clear();
+
+    {
+        QSqlQuery selectArtistsQuery(d->mTracksDatabase);
+
+        auto result = selectArtistsQuery.exec(QStringLiteral("SELECT `ID`, `Name` FROM `Artists`"));
+
+        if (!result || !selectArtistsQuery.isSelect() || !selectArtistsQuery.isActive()) {
+            qDebug() << "DatabaseInterface::loadIdCaches" << selectArtistsQuery.lastError();
+        }
+
+        while (selectArtistsQuery.next()) {
+            const auto &currentRecord = selectArtistsQuery.record();
+            auto artistId = currentRecord.value(0).toULongLong();
+            const auto &artistName = currentRecord.value(1).toString();
+
+            d->mArtistIds[artistName] = artistId;
+            d->mArtistNames[artistId] = artistName;
+            d->mArtistId = std::max(d->mArtistId, artistId + 1);
+        }
+    }
+
+    {
+        QSqlQuery selectAlbumsQuery(d->mTracksDatabase);
+
+        auto result = selectAlbumsQuery.exec(QStringLiteral("SELECT `ID`, `Title`, `ArtistID` FROM `Albums`"));
+
+        if (!result || !selectAlbumsQuery.isSelect() || !selectAlbumsQuery.isActive()) {
+            qDebug() << "DatabaseInterface::loadIdCaches" << selectAlbumsQuery.lastError();
+        }
+
+        while (selectAlbumsQuery.next()) {
+            const auto &currentRecord = selectAlbumsQuery.record();
+            auto albumId = currentRecord.value(0).toULongLong();
+            const auto &albumKey = qMakePair(currentRecord.value(1).toString(), currentRecord.value(2).toULongLong());
+
+            d->mAlbumIds[albumKey] = albumId;
+            d->mAlbumKeys[albumId] = albumKey;
+            d->mAlbumId = std::max(d->mAlbumId, albumId + 1);
+        }
+    }
+
+    {
+        QSqlQuery selectMusicSourcesQuery(d->mTracksDatabase);
+
+        auto result = selectMusicSourcesQuery.exec(QStringLiteral("SELECT `ID`, `Name` FROM `DiscoverSource`"));
+
+        if (!result || !selectMusicSourcesQuery.isSelect() || !selectMusicSourcesQuery.isActive()) {
+            qDebug() << "DatabaseInterface::loadIdCaches" << selectMusicSourcesQuery.lastError();
+        }
+
+        while (selectMusicSourcesQuery.next()) {
+            const auto &currentRecord = selectMusicSourcesQuery.record();
+            auto discoverId = currentRecord.value(0).toULongLong();
+
+            d->mDiscoverIds[currentRecord.value(1).toString()] = discoverId;
+            d->mDiscoverId = std::max(d->mDiscoverId, discoverId + 1);
+        }
+    }
+
+    {
+        QSqlQuery selectDirectoriesQuery(d->mTracksDatabase);
+
+        auto result = selectDirectoriesQuery.exec(QStringLiteral("SELECT `ID`, `Path` FROM `Directories`"));
+
+        if (!result || !selectDirectoriesQuery.isSelect() || !selectDirectoriesQuery.isActive()) {
+            qDebug() << "DatabaseInterface::loadIdCaches" << selectDirectoriesQuery.lastError();
+        }
+
+        while (selectDirectoriesQuery.next()) {
+            const auto &currentRecord = selectDirectoriesQuery.record();
+            auto directoryId = currentRecord.value(0).toULongLong();
+
+            d->mDirectoryIds[currentRecord.value(1).toString()] = directoryId;
+            d->mDirectoryId = std::max(d->mDirectoryId, directoryId + 1);
+        }
+    }
+}
+
 void DatabaseInterface::reloadExistingDatabase()
 {
     auto transactionResult = startTransaction();
@@ -1947,9 +3656,10 @@ void DatabaseInterface::reloadExistingDatabase()
         return;
     }
 
-    d->mInitialUpdateTracksValidity.exec();
     qDebug() << "DatabaseInterface::reloadExistingDatabase";
 
+    loadIdCaches();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
@@ -1957,58 +3667,37 @@ void DatabaseInterface::reloadExistingDatabase()
 
     const auto restoredArtists = allArtists();
     for (const auto oneArtist : restoredArtists) {
-        d->mArtistId = std::max(d->mArtistId, oneArtist.databaseId());
         Q_EMIT artistAdded(oneArtist);
     }
-    ++d->mArtistId;
+    Q_EMIT artistsAdded(restoredArtists);
 
     const auto restoredAlbums = allAlbums();
     for (const auto oneAlbum : restoredAlbums) {
-        d->mAlbumId = std::max(d->mAlbumId, oneAlbum.databaseId());
         Q_EMIT albumAdded(oneAlbum);
     }
-    ++d->mAlbumId;
+    Q_EMIT albumsAdded(restoredAlbums);
 
     const auto restoredTracks = allTracks();
     for (const auto oneTrack : restoredTracks) {
         d->mTrackId = std::max(d->mTrackId, oneTrack.databaseId());
         Q_EMIT trackAdded(oneTrack);
     }
+    Q_EMIT tracksAdded(restoredTracks);
     ++d->mTrackId;
 }
 
 qulonglong DatabaseInterface::insertMusicSource(QString name)
 {
-    qulonglong result = 0;
-
-    d->mSelectMusicSource.bindValue(QStringLiteral(":name"), name);
-
-    auto queryResult = d->mSelectMusicSource.exec();
-
-    if (!queryResult || !d->mSelectMusicSource.isSelect() || !d->mSelectMusicSource.isActive()) {
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastQuery();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.boundValues();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastError();
-
-        d->mSelectMusicSource.finish();
-
-        return result;
-    }
-
-    if (d->mSelectMusicSource.next()) {
-        result = d->mSelectMusicSource.record().value(0).toULongLong();
-
-        d->mSelectMusicSource.finish();
+    qulonglong result = d->mDiscoverIds.value(name);
 
+    if (result != 0) {
         return result;
     }
 
-    d->mSelectMusicSource.finish();
-
     d->mInsertMusicSource.bindValue(QStringLiteral(":discoverId"), d->mDiscoverId);
     d->mInsertMusicSource.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertMusicSource.exec();
+    auto queryResult = d->mInsertMusicSource.exec();
 
     if (!queryResult || !d->mInsertMusicSource.isActive()) {
         qDebug() << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.lastQuery();
@@ -2022,12 +3711,46 @@ qulonglong DatabaseInterface::insertMusicSource(QString name)
 
     d->mInsertMusicSource.finish();
 
+    d->mDiscoverIds[name] = d->mDiscoverId;
+
     ++d->mDiscoverId;
 
     return d->mDiscoverId - 1;
 }
 
-QMap<qulonglong, MusicAudioTrack> DatabaseInterface::fetchTracks(qulonglong albumId)
+qulonglong DatabaseInterface::insertDirectory(const QString &directoryPath)
+{
+    qulonglong result = d->mDirectoryIds.value(directoryPath);
+
+    if (result != 0) {
+        return result;
+    }
+
+    d->mInsertDirectoryQuery.bindValue(QStringLiteral(":directoryId"), d->mDirectoryId);
+    d->mInsertDirectoryQuery.bindValue(QStringLiteral(":path"), directoryPath);
+
+    auto queryResult = d->mInsertDirectoryQuery.exec();
+
+    if (!queryResult || !d->mInsertDirectoryQuery.isActive()) {
+        qDebug() << "DatabaseInterface::insertDirectory" << d->mInsertDirectoryQuery.lastQuery();
+        qDebug() << "DatabaseInterface::insertDirectory" << d->mInsertDirectoryQuery.boundValues();
+        qDebug() << "DatabaseInterface::insertDirectory" << d->mInsertDirectoryQuery.lastError();
+
+        d->mInsertDirectoryQuery.finish();
+
+        return d->mDirectoryId;
+    }
+
+    d->mInsertDirectoryQuery.finish();
+
+    d->mDirectoryIds[directoryPath] = d->mDirectoryId;
+
+    ++d->mDirectoryId;
+
+    return d->mDirectoryId - 1;
+}
+
+QMap<qulonglong, MusicAudioTrack> DatabaseInterface::fetchTracks(qulonglong albumId) const
 {
     auto allTracks = QMap<qulonglong, MusicAudioTrack>();
 
@@ -2063,36 +3786,53 @@ QMap<qulonglong, MusicAudioTrack> DatabaseInterface::fetchTracks(qulonglong albu
 
     d->mSelectTrackQuery.finish();
 
-    updateTracksCount(albumId);
-
     return allTracks;
 }
 
-QList<qulonglong> DatabaseInterface::fetchTrackIds(qulonglong albumId) const
+void DatabaseInterface::fetchTracksSummary(qulonglong albumId, MusicAlbum &album) const
 {
     auto allTrackIds = QList<qulonglong>();
+    auto allTracksTitle = QStringList();
+    auto allArtists = QStringList();
+    auto highestTrackRating = 0;
 
     d->mSelectTrackQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
     auto result = d->mSelectTrackQuery.exec();
 
     if (!result || !d->mSelectTrackQuery.isSelect() || !d->mSelectTrackQuery.isActive()) {
-        qDebug() << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.lastQuery();
-        qDebug() << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.boundValues();
-        qDebug() << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.lastError();
+        qDebug() << "DatabaseInterface::fetchTracksSummary" << d->mSelectTrackQuery.lastQuery();
+        qDebug() << "DatabaseInterface::fetchTracksSummary" << d->mSelectTrackQuery.boundValues();
+        qDebug() << "DatabaseInterface::fetchTracksSummary" << d->mSelectTrackQuery.lastError();
     }
 
     while (d->mSelectTrackQuery.next()) {
-        allTrackIds.push_back(d->mSelectTrackQuery.record().value(0).toULongLong());
+        const auto &currentRecord = d->mSelectTrackQuery.record();
+
+        allTrackIds.push_back(currentRecord.value(0).toULongLong());
+        allTracksTitle.push_back(currentRecord.value(1).toString());
+        allArtists.push_back(currentRecord.value(3).toString());
+        highestTrackRating = std::max(highestTrackRating, currentRecord.value(9).toInt());
     }
 
     d->mSelectTrackQuery.finish();
 
-    return allTrackIds;
+    std::sort(allTracksTitle.begin(), allTracksTitle.end());
+    allTracksTitle.erase(std::unique(allTracksTitle.begin(), allTracksTitle.end()), allTracksTitle.end());
+
+    std::sort(allArtists.begin(), allArtists.end());
+    allArtists.erase(std::unique(allArtists.begin(), allArtists.end()), allArtists.end());
+
+    album.setTrackIds(allTrackIds);
+    album.setAllTracksTitle(allTracksTitle);
+    album.setAllArtists(allArtists);
+    album.setHighestTrackRating(highestTrackRating);
 }
 
-void DatabaseInterface::updateTracksCount(qulonglong albumId)
+bool DatabaseInterface::updateTracksCount(qulonglong albumId)
 {
+    auto tracksCountChanged = false;
+
     d->mSelectAlbumTrackCountQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
     auto result = d->mSelectAlbumTrackCountQuery.exec();
@@ -2104,13 +3844,13 @@ void DatabaseInterface::updateTracksCount(qulonglong albumId)
 
         d->mSelectAlbumTrackCountQuery.finish();
 
-        return;
+        return tracksCountChanged;
     }
 
     if (!d->mSelectAlbumTrackCountQuery.next()) {
         d->mSelectAlbumTrackCountQuery.finish();
 
-        return;
+        return tracksCountChanged;
     }
 
     auto oldTracksCount = d->mSelectAlbumTrackCountQuery.record().value(0).toInt();
@@ -2126,7 +3866,7 @@ void DatabaseInterface::updateTracksCount(qulonglong albumId)
 
         d->mUpdateAlbumQuery.finish();
 
-        return;
+        return tracksCountChanged;
     }
 
     d->mUpdateAlbumQuery.finish();
@@ -2142,20 +3882,22 @@ void DatabaseInterface::updateTracksCount(qulonglong albumId)
 
         d->mSelectAlbumTrackCountQuery.finish();
 
-        return;
+        return tracksCountChanged;
     }
 
     if (!d->mSelectAlbumTrackCountQuery.next()) {
         d->mSelectAlbumTrackCountQuery.finish();
 
-        return;
+        return tracksCountChanged;
     }
 
     auto newTracksCount = d->mSelectAlbumTrackCountQuery.record().value(0).toInt();
 
-    if (newTracksCount != oldTracksCount) {
-        Q_EMIT albumModified(internalAlbumFromId(albumId));
-    }
+    d->mSelectAlbumTrackCountQuery.finish();
+
+    tracksCountChanged = (newTracksCount != oldTracksCount);
+
+    return tracksCountChanged;
 }
 
 MusicAlbum DatabaseInterface::internalAlbumFromId(qulonglong albumId)
@@ -2191,12 +3933,12 @@ MusicAlbum DatabaseInterface::internalAlbumFromId(qulonglong albumId)
     retrievedAlbum.setAlbumArtURI(currentRecord.value(4).toUrl());
     retrievedAlbum.setTracksCount(currentRecord.value(5).toInt());
     retrievedAlbum.setIsSingleDiscAlbum(currentRecord.value(6).toBool());
-    retrievedAlbum.setTracks(fetchTracks(albumId));
-    retrievedAlbum.setTrackIds(fetchTrackIds(albumId));
     retrievedAlbum.setValid(true);
 
     d->mSelectAlbumQuery.finish();
 
+    fetchTracksSummary(albumId, retrievedAlbum);
+
     return retrievedAlbum;
 }
 
@@ -2321,7 +4063,7 @@ qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl fileName) c
         return result;
     }
 
-    d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), fileName);
+    bindFileName(d->mSelectTracksMapping, fileName);
 
     auto queryResult = d->mSelectTracksMapping.exec();
 
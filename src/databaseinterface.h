@@ -28,11 +28,15 @@
 #include <QString>
 #include <QHash>
 #include <QList>
+#include <QSet>
+#include <QPair>
 #include <QVariant>
 #include <QUrl>
+#include <QDateTime>
 
 class DatabaseInterfacePrivate;
 class QMutex;
+class QSqlQuery;
 
 class DatabaseInterface : public QObject
 {
@@ -54,14 +58,16 @@ public:
 
     Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {});
 
+    Q_INVOKABLE void initReadOnly(const QString &dbName, const QString &databaseFileName);
+
+    bool isInitialized() const;
+
     MusicAlbum albumFromTitle(QString title);
 
     QList<MusicAudioTrack> allTracks() const;
 
     QList<MusicAudioTrack> allTracksFromSource(QString musicSource) const;
 
-    QList<MusicAudioTrack> allInvalidTracksFromSource(QString musicSource) const;
-
     QList<MusicAlbum> allAlbums();
 
     QList<MusicArtist> allArtists() const;
@@ -92,16 +98,59 @@ Q_SIGNALS:
 
     void trackModified(MusicAudioTrack modifiedTrack);
 
+    void artistsAdded(const QList<MusicArtist> &newArtists);
+
+    void albumsAdded(const QList<MusicAlbum> &newAlbums);
+
+    void tracksAdded(const QList<MusicAudioTrack> &newTracks);
+
+    void artistsRemoved(const QList<MusicArtist> &removedArtists);
+
+    void albumsRemoved(const QList<MusicAlbum> &removedAlbums);
+
+    void tracksRemoved(const QList<MusicAudioTrack> &removedTracks);
+
+    void artistsModified(const QList<MusicArtist> &modifiedArtists);
+
+    void albumsModified(const QList<MusicAlbum> &modifiedAlbums);
+
+    void tracksModified(const QList<MusicAudioTrack> &modifiedTracks);
+
     void requestsInitDone();
 
     void newTrackFile(MusicAudioTrack newTrack);
 
+    void albumTracksLoaded(MusicAlbum album);
+
+    void tracksListInserted(const QString &musicSource);
+
+    void restoredTracks(const QString &musicSource, const QList<MusicAudioTrack> &restoredFiles);
+
+    void searchResultsReady(const QString &searchText, const QList<qulonglong> &albumIds,
+                            const QList<qulonglong> &artistIds, const QList<qulonglong> &trackIds);
+
+    void albumCoversListed(const QString &musicSource, const QList<QUrl> &albumCovers);
+
 public Q_SLOTS:
 
+    void loadAlbumTracks(qulonglong albumId);
+
+    void searchItems(const QString &searchText);
+
+    void askRestoredTracks(const QString &musicSource);
+
     void insertTracksList(QList<MusicAudioTrack> tracks, const QHash<QString, QUrl> &covers, QString musicSource);
 
     void removeTracksList(const QList<QUrl> removedTracks);
 
+    void removeDirectoryTree(const QUrl &removedDirectory);
+
+    void beginSourceScan(const QString &musicSource);
+
+    void markSeenTracksList(const QList<QUrl> &seenTracks, const QHash<QUrl, QDateTime> &seenDirectories, const QString &musicSource);
+
+    void finishSourceScan(const QString &musicSource);
+
     void modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers);
 
 private:
@@ -112,11 +161,25 @@ private:
 
     bool rollBackTransaction() const;
 
-    QMap<qulonglong, MusicAudioTrack> fetchTracks(qulonglong albumId);
+    void clearPendingChanges() const;
 
-    QList<qulonglong> fetchTrackIds(qulonglong albumId) const;
+    void emitPendingChanges();
 
-    void updateTracksCount(qulonglong albumId);
+    void emitAlbumCovers(const QString &musicSource);
+
+    void updateAlbumLater(qulonglong albumId) const;
+
+    void updatePendingAlbums();
+
+    void updateArtistLater(qulonglong artistId) const;
+
+    void updatePendingArtists();
+
+    QMap<qulonglong, MusicAudioTrack> fetchTracks(qulonglong albumId) const;
+
+    void fetchTracksSummary(qulonglong albumId, MusicAlbum &album) const;
+
+    bool updateTracksCount(qulonglong albumId);
 
     MusicArtist internalArtistFromId(qulonglong artistId) const;
 
@@ -136,12 +199,20 @@ private:
 
     void initDatabase() const;
 
+    bool upgradeTracksMappingToDirectories() const;
+
+    void initSearchIndex() const;
+
     void initRequest();
 
     qulonglong insertAlbum(QString title, QString albumArtist, QUrl albumArtURI, int tracksCount, bool isSingleDiscAlbum);
 
     void updateIsSingleDiscAlbumFromId(qulonglong albumId) const;
 
+    void updateAlbumSearchEntry(qulonglong albumId) const;
+
+    void updateArtistAlbumsCount(qulonglong artistId) const;
+
     qulonglong insertArtist(QString name);
 
     qulonglong internalArtistIdFromName(QString name);
@@ -152,18 +223,43 @@ private:
 
     void removeArtistInDatabase(qulonglong artistId);
 
+    void loadIdCaches() const;
+
     void reloadExistingDatabase();
 
     qulonglong insertMusicSource(QString name);
 
+    qulonglong insertDirectory(const QString &directoryPath);
+
     void insertTrackOrigin(QUrl fileNameURI, qulonglong discoverId);
 
     void updateTrackOrigin(qulonglong trackId, QUrl fileName);
 
+    void appendFileStatValues(const MusicAudioTrack &track, QVariantList &values) const;
+
+    void updateTrackFileStat(const MusicAudioTrack &track);
+
     int computeTrackPriority(qulonglong trackId, QUrl fileName);
 
+    void internalInsertTracksList(const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers, const QString &musicSource);
+
     void internalInsertTrack(const MusicAudioTrack &oneModifiedTrack, const QHash<QString, QUrl> &covers, int originTrackId);
 
+    void internalRemoveTracksList(const QList<QUrl> &removedTracks);
+
+    void internalRemoveDirectoryTree(const QString &directoryPath);
+
+    bool internalInsertTracksBatch(const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers,
+                                   const QString &musicSource, QList<MusicAudioTrack> &otherTracks);
+
+    bool internalExistingFileNames(const QList<MusicAudioTrack> &tracks, QSet<QString> &existingFileNames) const;
+
+    bool internalAlbumTracksKeys(qulonglong albumId, MusicAlbum &albumData, QSet<QPair<QString, qulonglong>> &tracksKeys) const;
+
+    bool internalSearchIds(QSqlQuery &searchQuery, const QString &matchText, QList<qulonglong> &ids) const;
+
+    bool insertMultipleRows(const QString &insertText, int columnsCount, const QVariantList &values) const;
+
     DatabaseInterfacePrivate *d;
 
 };
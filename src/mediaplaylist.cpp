@@ -25,6 +25,8 @@
 #include <QUrl>
 #include <QPersistentModelIndex>
 #include <QList>
+#include <QHash>
+#include <QPair>
 #include <QDebug>
 
 #include <algorithm>
@@ -372,7 +374,7 @@ void MediaPlayList::move(int from, int to, int n)
 void MediaPlayList::enqueue(MusicAlbum album)
 {
     for (auto oneTrackIndex = 0; oneTrackIndex < album.tracksCount(); ++oneTrackIndex) {
-        enqueue(album.trackFromIndex(oneTrackIndex).databaseId());
+        enqueue(album.trackIdFromIndex(oneTrackIndex));
     }
 }
 
@@ -550,6 +552,92 @@ void MediaPlayList::trackRemoved(MusicAudioTrack track)
     }
 }
 
+void MediaPlayList::tracksChanged(const QList<MusicAudioTrack> &tracks)
+{
+    auto tracksById = QHash<qulonglong, int>();
+    auto tracksByName = QHash<QPair<QString, QPair<QString, QString>>, int>();
+
+    for (int trackIndex = 0; trackIndex < tracks.size(); ++trackIndex) {
+        const auto &oneTrack = tracks[trackIndex];
+
+        tracksById[oneTrack.databaseId()] = trackIndex;
+
+        const auto &nameKey = qMakePair(oneTrack.title(), qMakePair(oneTrack.albumName(), oneTrack.artist()));
+        if (!tracksByName.contains(nameKey)) {
+            tracksByName[nameKey] = trackIndex;
+        }
+    }
+
+    for (int i = 0; i < d->mData.size(); ++i) {
+        auto &oneEntry = d->mData[i];
+
+        if (oneEntry.mIsArtist) {
+            continue;
+        }
+
+        if (oneEntry.mIsValid) {
+            auto itTrack = tracksById.constFind(oneEntry.mId);
+            if (itTrack == tracksById.constEnd()) {
+                continue;
+            }
+
+            const auto &track = tracks[itTrack.value()];
+
+            if (d->mTrackData[i] != track) {
+                d->mTrackData[i] = track;
+
+                Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
+            }
+        } else {
+            auto itTrack = tracksByName.find(qMakePair(oneEntry.mTitle, qMakePair(oneEntry.mAlbum, oneEntry.mArtist)));
+            if (itTrack == tracksByName.end()) {
+                continue;
+            }
+
+            const auto &track = tracks[itTrack.value()];
+            tracksByName.erase(itTrack);
+
+            d->mTrackData[i] = track;
+            oneEntry.mId = track.databaseId();
+            oneEntry.mIsValid = true;
+
+            Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
+        }
+    }
+}
+
+void MediaPlayList::tracksRemoved(const QList<MusicAudioTrack> &tracks)
+{
+    auto tracksById = QHash<qulonglong, int>();
+
+    for (int trackIndex = 0; trackIndex < tracks.size(); ++trackIndex) {
+        tracksById[tracks[trackIndex].databaseId()] = trackIndex;
+    }
+
+    for (int i = 0; i < d->mData.size(); ++i) {
+        auto &oneEntry = d->mData[i];
+
+        if (!oneEntry.mIsValid) {
+            continue;
+        }
+
+        auto itTrack = tracksById.constFind(oneEntry.mId);
+        if (itTrack == tracksById.constEnd()) {
+            continue;
+        }
+
+        const auto &track = tracks[itTrack.value()];
+
+        oneEntry.mTitle = track.title();
+        oneEntry.mArtist = track.artist();
+        oneEntry.mAlbum = track.albumName();
+
+        oneEntry.mIsValid = false;
+
+        Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
+    }
+}
+
 void MediaPlayList::setMusicListenersManager(MusicListenersManager *musicListenersManager)
 {
     if (d->mMusicListenersManager == musicListenersManager) {
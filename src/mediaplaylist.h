@@ -162,6 +162,10 @@ public Q_SLOTS:
 
     void trackRemoved(MusicAudioTrack track);
 
+    void tracksChanged(const QList<MusicAudioTrack> &tracks);
+
+    void tracksRemoved(const QList<MusicAudioTrack> &tracks);
+
     void setMusicListenersManager(MusicListenersManager* musicListenersManager);
 
 private Q_SLOTS:
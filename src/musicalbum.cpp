@@ -50,8 +50,16 @@ public:
 
     QList<qulonglong> mTrackIds;
 
+    QStringList mAllArtists;
+
+    QStringList mAllTracksTitle;
+
     int mTracksCount = 0;
 
+    int mHighestTrackRating = 0;
+
+    bool mTracksLoaded = false;
+
     bool mIsValid = false;
 
     bool mIsSingleDiscAlbum = true;
@@ -143,6 +151,10 @@ void MusicAlbum::setTracksCount(int count)
 
 int MusicAlbum::tracksCount() const
 {
+    if (!d->mTracksLoaded) {
+        return d->mTrackIds.size();
+    }
+
     return d->mTracks.size();
 }
 
@@ -199,6 +211,12 @@ bool MusicAlbum::isSingleDiscAlbum() const
 void MusicAlbum::setTracks(const QMap<qulonglong, MusicAudioTrack> &allTracks)
 {
     d->mTracks = allTracks;
+    d->mTracksLoaded = true;
+}
+
+bool MusicAlbum::tracksLoaded() const
+{
+    return d->mTracksLoaded;
 }
 
 QList<qulonglong> MusicAlbum::tracksKeys() const
@@ -236,8 +254,17 @@ int MusicAlbum::trackIndexFromId(qulonglong id) const
     return result;
 }
 
+void MusicAlbum::setAllArtists(const QStringList &value)
+{
+    d->mAllArtists = value;
+}
+
 QStringList MusicAlbum::allArtists() const
 {
+    if (!d->mTracksLoaded) {
+        return d->mAllArtists;
+    }
+
     auto result = QList<QString>();
 
     for (const auto &oneTrack : d->mTracks) {
@@ -250,8 +277,17 @@ QStringList MusicAlbum::allArtists() const
     return result;
 }
 
+void MusicAlbum::setAllTracksTitle(const QStringList &value)
+{
+    d->mAllTracksTitle = value;
+}
+
 QStringList MusicAlbum::allTracksTitle() const
 {
+    if (!d->mTracksLoaded) {
+        return d->mAllTracksTitle;
+    }
+
     auto result = QList<QString>();
 
     for (const auto &oneTrack : d->mTracks) {
@@ -304,8 +340,17 @@ bool operator==(const MusicAlbum &album1, const MusicAlbum &album2)
     return album1.artist() == album2.artist() && album1.title() == album2.title();
 }
 
+void MusicAlbum::setHighestTrackRating(int value)
+{
+    d->mHighestTrackRating = value;
+}
+
 int MusicAlbum::highestTrackRating() const
 {
+    if (!d->mTracksLoaded) {
+        return d->mHighestTrackRating;
+    }
+
     int result = 0;
 
     for (const auto &oneTrack : d->mTracks) {
@@ -90,6 +90,8 @@ public:
 
     void setTracks(const QMap<qulonglong, MusicAudioTrack> &allTracks);
 
+    bool tracksLoaded() const;
+
     QList<qulonglong> tracksKeys() const;
 
     MusicAudioTrack trackFromIndex(int index) const;
@@ -100,8 +102,12 @@ public:
 
     int trackIndexFromId(qulonglong id) const;
 
+    void setAllArtists(const QStringList &value);
+
     QStringList allArtists() const;
 
+    void setAllTracksTitle(const QStringList &value);
+
     QStringList allTracksTitle() const;
 
     bool isEmpty() const;
@@ -112,6 +118,8 @@ public:
 
     void updateTrack(MusicAudioTrack modifiedTrack, int index);
 
+    void setHighestTrackRating(int value);
+
     int highestTrackRating() const;
 
 private:
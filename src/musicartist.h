@@ -21,6 +21,7 @@
 #define MUSICARTIST_H
 
 #include <QString>
+#include <QMetaType>
 
 class MusicArtistPrivate;
 class QDebug;
@@ -67,4 +68,6 @@ QDebug& operator<<(QDebug &stream, const MusicArtist &data);
 
 bool operator==(const MusicArtist &artist1, const MusicArtist &artist2);
 
+Q_DECLARE_METATYPE(MusicArtist)
+
 #endif // MUSICARTIST_H
@@ -77,6 +77,12 @@ public:
 
     int mRating = -1;
 
+    qint64 mFileSize = -1;
+
+    QDateTime mFileModificationTime;
+
+    qulonglong mFileInode = 0;
+
     bool mIsValid = false;
 
 };
@@ -297,6 +303,36 @@ int MusicAudioTrack::rating() const
     return d->mRating;
 }
 
+void MusicAudioTrack::setFileSize(qint64 value)
+{
+    d->mFileSize = value;
+}
+
+qint64 MusicAudioTrack::fileSize() const
+{
+    return d->mFileSize;
+}
+
+void MusicAudioTrack::setFileModificationTime(const QDateTime &value)
+{
+    d->mFileModificationTime = value;
+}
+
+const QDateTime &MusicAudioTrack::fileModificationTime() const
+{
+    return d->mFileModificationTime;
+}
+
+void MusicAudioTrack::setFileInode(qulonglong value)
+{
+    d->mFileInode = value;
+}
+
+qulonglong MusicAudioTrack::fileInode() const
+{
+    return d->mFileInode;
+}
+
 QDebug& operator<<(QDebug &stream, const MusicAudioTrack &data)
 {
     stream << data.title() << data.artist() << data.albumName() << data.albumArtist() << data.duration();
@@ -22,6 +22,7 @@
 
 #include <QString>
 #include <QTime>
+#include <QDateTime>
 #include <QUrl>
 #include <QMetaType>
 
@@ -114,6 +115,18 @@ public:
 
     int rating() const;
 
+    void setFileSize(qint64 value);
+
+    qint64 fileSize() const;
+
+    void setFileModificationTime(const QDateTime &value);
+
+    const QDateTime& fileModificationTime() const;
+
+    void setFileInode(qulonglong value);
+
+    qulonglong fileInode() const;
+
 private:
 
     MusicAudioTrackPrivate *d = nullptr;
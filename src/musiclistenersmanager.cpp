@@ -33,6 +33,12 @@
 #include "mediaplaylist.h"
 #include "file/filelistener.h"
 #include "trackslistener.h"
+#include "scanprogress.h"
+#include "scanscheduler.h"
+
+#if defined Qt5DBus_FOUND && Qt5DBus_FOUND
+#include <QDBusConnection>
+#endif
 
 #include <QThread>
 #include <QMutex>
@@ -40,12 +46,22 @@
 #include <QDir>
 #include <QCoreApplication>
 
+#include <array>
+
+static const int readDatabasesCount = 2;
+
 class MusicListenersManagerPrivate
 {
 public:
 
     QThread mDatabaseThread;
 
+    std::array<QThread, readDatabasesCount> mReadDatabaseThreads;
+
+    ScanProgress mScanProgress;
+
+    ScanScheduler mScanScheduler;
+
 #if defined UPNPQT_FOUND && UPNPQT_FOUND
     UpnpListener mUpnpListener;
 #endif
@@ -60,6 +76,14 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    std::array<DatabaseInterface, readDatabasesCount> mReadDatabaseInterfaces;
+
+    QString mDatabaseFileName;
+
+    int mNextReadDatabase = 0;
+
+    bool mSearchDatabaseReady = false;
+
 };
 
 MusicListenersManager::MusicListenersManager(QObject *parent)
@@ -82,30 +106,59 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
         databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
     }
 
+    d->mDatabaseFileName = databaseFileName;
+
+    if (!d->mDatabaseFileName.isEmpty()) {
+        for (int i = 0; i < readDatabasesCount; ++i) {
+            d->mReadDatabaseThreads[i].start();
+            d->mReadDatabaseInterfaces[i].moveToThread(&d->mReadDatabaseThreads[i]);
+        }
+    }
+
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
                               Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName));
 
-    connect(&d->mDatabaseInterface, &DatabaseInterface::artistAdded,
-               this, &MusicListenersManager::artistAdded);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::albumAdded,
-               this, &MusicListenersManager::albumAdded);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::trackAdded,
-               this, &MusicListenersManager::trackAdded);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::artistRemoved,
-               this, &MusicListenersManager::artistRemoved);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::albumRemoved,
-               this, &MusicListenersManager::albumRemoved);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::trackRemoved,
-               this, &MusicListenersManager::trackRemoved);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::artistModified,
-               this, &MusicListenersManager::artistModified);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::albumModified,
-               this, &MusicListenersManager::albumModified);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::trackModified,
-               this, &MusicListenersManager::trackModified);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::artistsAdded,
+               this, &MusicListenersManager::artistsAdded);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::albumsAdded,
+               this, &MusicListenersManager::albumsAdded);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::tracksAdded,
+               this, &MusicListenersManager::tracksAdded);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::artistsRemoved,
+               this, &MusicListenersManager::artistsRemoved);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::albumsRemoved,
+               this, &MusicListenersManager::albumsRemoved);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::tracksRemoved,
+               this, &MusicListenersManager::tracksRemoved);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::artistsModified,
+               this, &MusicListenersManager::artistsModified);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::albumsModified,
+               this, &MusicListenersManager::albumsModified);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::tracksModified,
+               this, &MusicListenersManager::tracksModified);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::albumTracksLoaded,
+               this, &MusicListenersManager::albumTracksLoaded);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::searchResultsReady,
+               this, &MusicListenersManager::searchResultsReady);
+
+    for (auto &oneReadDatabase : d->mReadDatabaseInterfaces) {
+        connect(&oneReadDatabase, &DatabaseInterface::searchResultsReady,
+                this, &MusicListenersManager::searchResultsReady);
+    }
+
+    connect(&d->mReadDatabaseInterfaces[0], &DatabaseInterface::requestsInitDone,
+            this, [this]() {d->mSearchDatabaseReady = true;});
 
     connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
             this, &MusicListenersManager::applicationAboutToQuit);
+
+#if defined Qt5DBus_FOUND && Qt5DBus_FOUND
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/org/kde/elisa/ScanProgress"), &d->mScanProgress,
+                                                 QDBusConnection::ExportAllProperties | QDBusConnection::ExportAllSignals);
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/org/kde/elisa/ScanScheduler"), &d->mScanScheduler,
+                                                 QDBusConnection::ExportAllProperties | QDBusConnection::ExportAllSignals |
+                                                 QDBusConnection::ExportScriptableSlots | QDBusConnection::ExportNonScriptableSlots);
+#endif
 }
 
 MusicListenersManager::~MusicListenersManager()
@@ -118,26 +171,57 @@ DatabaseInterface *MusicListenersManager::viewDatabase() const
     return &d->mDatabaseInterface;
 }
 
+ScanProgress *MusicListenersManager::scanProgress() const
+{
+    return &d->mScanProgress;
+}
+
+ScanScheduler *MusicListenersManager::scanScheduler() const
+{
+    return &d->mScanScheduler;
+}
+
 void MusicListenersManager::subscribeForTracks(MediaPlayList *client)
 {
-    auto helper = new TracksListener(&d->mDatabaseInterface);
+    auto database = &d->mDatabaseInterface;
+    auto databaseThread = &d->mDatabaseThread;
+
+    if (!d->mDatabaseFileName.isEmpty()) {
+        database = &d->mReadDatabaseInterfaces[d->mNextReadDatabase];
+        databaseThread = &d->mReadDatabaseThreads[d->mNextReadDatabase];
+        d->mNextReadDatabase = (d->mNextReadDatabase + 1) % readDatabasesCount;
+    }
+
+    auto helper = new TracksListener(database);
 
-    helper->moveToThread(&d->mDatabaseThread);
+    helper->moveToThread(databaseThread);
 
-    connect(this, &MusicListenersManager::trackRemoved, client, &MediaPlayList::trackRemoved);
-    connect(this, &MusicListenersManager::trackAdded, client, &MediaPlayList::trackChanged);
-    connect(this, &MusicListenersManager::trackModified, client, &MediaPlayList::trackChanged);
+    connect(database, &DatabaseInterface::requestsInitDone, helper, &TracksListener::databaseReady);
+
+    connect(this, &MusicListenersManager::tracksRemoved, client, &MediaPlayList::tracksRemoved);
+    connect(this, &MusicListenersManager::tracksAdded, client, &MediaPlayList::tracksChanged);
+    connect(this, &MusicListenersManager::tracksModified, client, &MediaPlayList::tracksChanged);
     connect(helper, &TracksListener::trackChanged, client, &MediaPlayList::trackChanged);
     connect(helper, &TracksListener::albumAdded, client, &MediaPlayList::albumAdded);
     connect(client, &MediaPlayList::newTrackByIdInList, helper, &TracksListener::trackByIdInList);
     connect(client, &MediaPlayList::newTrackByNameInList, helper, &TracksListener::trackByNameInList);
     connect(client, &MediaPlayList::newArtistInList, helper, &TracksListener::newArtistInList);
-    connect(&d->mDatabaseInterface, &DatabaseInterface::trackAdded, helper, &TracksListener::trackAdded);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::tracksAdded, helper, &TracksListener::tracksAdded);
 }
 
 void MusicListenersManager::databaseReady()
 {
+    if (!d->mDatabaseFileName.isEmpty()) {
+        for (int i = 0; i < readDatabasesCount; ++i) {
+            QMetaObject::invokeMethod(&d->mReadDatabaseInterfaces[i], "initReadOnly", Qt::QueuedConnection,
+                                      Q_ARG(QString, QStringLiteral("listenersReader%1").arg(i)),
+                                      Q_ARG(QString, d->mDatabaseFileName));
+        }
+    }
+
 #if defined KF5Baloo_FOUND && KF5Baloo_FOUND
+    d->mBalooListener.setScanProgress(&d->mScanProgress);
+    d->mBalooListener.setScanScheduler(&d->mScanScheduler);
     d->mBalooListener.setDatabaseInterface(&d->mDatabaseInterface);
     d->mBalooListener.moveToThread(&d->mDatabaseThread);
     connect(this, &MusicListenersManager::applicationIsTerminating,
@@ -155,6 +239,8 @@ void MusicListenersManager::databaseReady()
 #endif
 
 #if (!defined KF5Baloo_FOUND || !KF5Baloo_FOUND) && defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+    d->mFileListener.setScanProgress(&d->mScanProgress);
+    d->mFileListener.setScanScheduler(&d->mScanScheduler);
     d->mFileListener.setDatabaseInterface(&d->mDatabaseInterface);
     d->mFileListener.moveToThread(&d->mDatabaseThread);
     connect(this, &MusicListenersManager::applicationIsTerminating,
@@ -168,10 +254,35 @@ void MusicListenersManager::databaseReady()
 
 void MusicListenersManager::applicationAboutToQuit()
 {
+    d->mScanScheduler.cancel();
+
     Q_EMIT applicationIsTerminating();
 
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
+
+    for (auto &oneThread : d->mReadDatabaseThreads) {
+        oneThread.exit();
+        oneThread.wait();
+    }
+}
+
+void MusicListenersManager::requestAlbumTracks(qulonglong albumId)
+{
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "loadAlbumTracks", Qt::QueuedConnection,
+                              Q_ARG(qulonglong, albumId));
+}
+
+void MusicListenersManager::searchItems(const QString &searchText)
+{
+    auto database = &d->mDatabaseInterface;
+
+    if (!d->mDatabaseFileName.isEmpty() && d->mSearchDatabaseReady) {
+        database = &d->mReadDatabaseInterfaces[0];
+    }
+
+    QMetaObject::invokeMethod(database, "searchItems", Qt::QueuedConnection,
+                              Q_ARG(QString, searchText));
 }
 
 
@@ -29,6 +29,8 @@
 class MusicListenersManagerPrivate;
 class DatabaseInterface;
 class MediaPlayList;
+class ScanProgress;
+class ScanScheduler;
 
 class MusicListenersManager : public QObject
 {
@@ -39,6 +41,14 @@ class MusicListenersManager : public QObject
                READ viewDatabase
                NOTIFY viewDatabaseChanged)
 
+    Q_PROPERTY(ScanProgress* scanProgress
+               READ scanProgress
+               CONSTANT)
+
+    Q_PROPERTY(ScanScheduler* scanScheduler
+               READ scanScheduler
+               CONSTANT)
+
 public:
 
     explicit MusicListenersManager(QObject *parent = 0);
@@ -47,29 +57,38 @@ public:
 
     DatabaseInterface* viewDatabase() const;
 
+    ScanProgress* scanProgress() const;
+
+    ScanScheduler* scanScheduler() const;
+
     void subscribeForTracks(MediaPlayList *client);
 
 Q_SIGNALS:
 
     void viewDatabaseChanged();
 
-    void artistAdded(MusicArtist newArtist);
+    void artistsAdded(const QList<MusicArtist> &newArtists);
 
-    void albumAdded(MusicAlbum newAlbum);
+    void albumsAdded(const QList<MusicAlbum> &newAlbums);
 
-    void trackAdded(MusicAudioTrack newTrack);
+    void tracksAdded(const QList<MusicAudioTrack> &newTracks);
 
-    void artistRemoved(MusicArtist removedArtist);
+    void artistsRemoved(const QList<MusicArtist> &removedArtists);
 
-    void albumRemoved(MusicAlbum removedAlbum);
+    void albumsRemoved(const QList<MusicAlbum> &removedAlbums);
 
-    void trackRemoved(MusicAudioTrack removedTrack);
+    void tracksRemoved(const QList<MusicAudioTrack> &removedTracks);
 
-    void artistModified(MusicArtist modifiedArtist);
+    void artistsModified(const QList<MusicArtist> &modifiedArtists);
 
-    void albumModified(MusicAlbum modifiedAlbum);
+    void albumsModified(const QList<MusicAlbum> &modifiedAlbums);
 
-    void trackModified(MusicAudioTrack modifiedTrack);
+    void tracksModified(const QList<MusicAudioTrack> &modifiedTracks);
+
+    void albumTracksLoaded(MusicAlbum album);
+
+    void searchResultsReady(const QString &searchText, const QList<qulonglong> &albumIds,
+                            const QList<qulonglong> &artistIds, const QList<qulonglong> &trackIds);
 
     void applicationIsTerminating();
 
@@ -81,6 +100,10 @@ public Q_SLOTS:
 
     void applicationAboutToQuit();
 
+    void requestAlbumTracks(qulonglong albumId);
+
+    void searchItems(const QString &searchText);
+
 private:
 
     MusicListenersManagerPrivate *d;
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "scanprogress.h"
+
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+class ScanProgressPrivate
+{
+public:
+
+    QAtomicInt mActiveScans;
+
+    QAtomicInteger<quint64> mFilesDiscoveredCounter;
+
+    QAtomicInteger<quint64> mFilesExtractedCounter;
+
+    QAtomicInteger<quint64> mTracksWrittenCounter;
+
+    QAtomicInteger<quint64> mBytesScannedCounter;
+
+    QTimer mUpdateTimer;
+
+    QElapsedTimer mRateTimer;
+
+    quint64 mLastFilesExtracted = 0;
+
+    bool mScanning = false;
+
+    qulonglong mFilesDiscovered = 0;
+
+    qulonglong mFilesExtracted = 0;
+
+    qulonglong mTracksWritten = 0;
+
+    qulonglong mBytesScanned = 0;
+
+    double mFilesPerSecond = 0.;
+
+    int mRemainingSeconds = 0;
+
+};
+
+ScanProgress::ScanProgress(QObject *parent) : QObject(parent), d(new ScanProgressPrivate)
+{
+    d->mUpdateTimer.setInterval(500);
+
+    connect(&d->mUpdateTimer, &QTimer::timeout, this, &ScanProgress::updateProgress);
+}
+
+ScanProgress::~ScanProgress()
+{
+}
+
+bool ScanProgress::isScanning() const
+{
+    return d->mScanning;
+}
+
+qulonglong ScanProgress::filesDiscovered() const
+{
+    return d->mFilesDiscovered;
+}
+
+qulonglong ScanProgress::filesExtracted() const
+{
+    return d->mFilesExtracted;
+}
+
+qulonglong ScanProgress::tracksWritten() const
+{
+    return d->mTracksWritten;
+}
+
+qulonglong ScanProgress::bytesScanned() const
+{
+    return d->mBytesScanned;
+}
+
+double ScanProgress::filesPerSecond() const
+{
+    return d->mFilesPerSecond;
+}
+
+int ScanProgress::remainingSeconds() const
+{
+    return d->mRemainingSeconds;
+}
+
+int ScanProgress::updateInterval() const
+{
+    return d->mUpdateTimer.interval();
+}
+
+void ScanProgress::setUpdateInterval(int updateInterval)
+{
+    if (d->mUpdateTimer.interval() == updateInterval) {
+        return;
+    }
+
+    d->mUpdateTimer.setInterval(updateInterval);
+
+    Q_EMIT updateIntervalChanged();
+}
+
+void ScanProgress::scanStarted()
+{
+    if (d->mActiveScans.fetchAndAddOrdered(1) != 0) {
+        return;
+    }
+
+    d->mFilesDiscoveredCounter.store(0);
+    d->mFilesExtractedCounter.store(0);
+    d->mTracksWrittenCounter.store(0);
+    d->mBytesScannedCounter.store(0);
+
+    QMetaObject::invokeMethod(this, "startUpdates", Qt::QueuedConnection);
+}
+
+void ScanProgress::scanFinished()
+{
+    if (d->mActiveScans.fetchAndAddOrdered(-1) != 1) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, "updateProgress", Qt::QueuedConnection);
+}
+
+void ScanProgress::addDiscoveredFiles(int filesCount)
+{
+    d->mFilesDiscoveredCounter.fetchAndAddRelaxed(filesCount);
+}
+
+void ScanProgress::addExtractedFiles(int filesCount, qint64 bytesCount)
+{
+    d->mFilesExtractedCounter.fetchAndAddRelaxed(filesCount);
+
+    if (bytesCount > 0) {
+        d->mBytesScannedCounter.fetchAndAddRelaxed(bytesCount);
+    }
+}
+
+void ScanProgress::addWrittenTracks(int tracksCount)
+{
+    d->mTracksWrittenCounter.fetchAndAddRelaxed(tracksCount);
+
+    if (d->mActiveScans.load() == 0) {
+        QMetaObject::invokeMethod(this, "updateProgress", Qt::QueuedConnection);
+    }
+}
+
+void ScanProgress::startUpdates()
+{
+    d->mLastFilesExtracted = 0;
+    d->mFilesPerSecond = 0.;
+    d->mRateTimer.start();
+
+    if (d->mUpdateTimer.interval() > 0) {
+        d->mUpdateTimer.start();
+    }
+
+    updateProgress();
+}
+
+void ScanProgress::updateProgress()
+{
+    const auto isScanning = d->mActiveScans.load() > 0;
+    const auto filesDiscovered = d->mFilesDiscoveredCounter.load();
+    const auto filesExtracted = d->mFilesExtractedCounter.load();
+    const auto tracksWritten = d->mTracksWrittenCounter.load();
+    const auto bytesScanned = d->mBytesScannedCounter.load();
+
+    auto filesPerSecond = d->mFilesPerSecond;
+    auto remainingSeconds = 0;
+
+    if (isScanning) {
+        const auto elapsedTime = d->mRateTimer.isValid() ? d->mRateTimer.restart() : 0;
+
+        if (elapsedTime > 0) {
+            const auto currentRate = (filesExtracted - std::min(filesExtracted, d->mLastFilesExtracted)) * 1000. / elapsedTime;
+            filesPerSecond = (filesPerSecond > 0.) ? 0.7 * filesPerSecond + 0.3 * currentRate : currentRate;
+        }
+
+        d->mLastFilesExtracted = filesExtracted;
+
+        if (filesPerSecond > 0. && filesDiscovered >= filesExtracted) {
+            remainingSeconds = static_cast<int>((filesDiscovered - filesExtracted) / filesPerSecond + 0.5);
+        } else {
+            remainingSeconds = -1;
+        }
+    } else {
+        d->mUpdateTimer.stop();
+        filesPerSecond = 0.;
+    }
+
+    if (isScanning == d->mScanning && filesDiscovered == d->mFilesDiscovered && filesExtracted == d->mFilesExtracted &&
+            tracksWritten == d->mTracksWritten && bytesScanned == d->mBytesScanned && filesPerSecond == d->mFilesPerSecond &&
+            remainingSeconds == d->mRemainingSeconds) {
+        return;
+    }
+
+    d->mScanning = isScanning;
+    d->mFilesDiscovered = filesDiscovered;
+    d->mFilesExtracted = filesExtracted;
+    d->mTracksWritten = tracksWritten;
+    d->mBytesScanned = bytesScanned;
+    d->mFilesPerSecond = filesPerSecond;
+    d->mRemainingSeconds = remainingSeconds;
+
+    Q_EMIT progressChanged();
+}
+
+
+#include "moc_scanprogress.cpp"
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef SCANPROGRESS_H
+#define SCANPROGRESS_H
+
+#include <QObject>
+
+#include <memory>
+
+class ScanProgressPrivate;
+
+class ScanProgress : public QObject
+{
+
+    Q_OBJECT
+
+    Q_CLASSINFO("D-Bus Interface", "org.kde.elisa.ScanProgress")
+
+    Q_PROPERTY(bool scanning
+               READ isScanning
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(qulonglong filesDiscovered
+               READ filesDiscovered
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(qulonglong filesExtracted
+               READ filesExtracted
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(qulonglong tracksWritten
+               READ tracksWritten
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(qulonglong bytesScanned
+               READ bytesScanned
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(double filesPerSecond
+               READ filesPerSecond
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(int remainingSeconds
+               READ remainingSeconds
+               NOTIFY progressChanged)
+
+    Q_PROPERTY(int updateInterval
+               READ updateInterval
+               WRITE setUpdateInterval
+               NOTIFY updateIntervalChanged)
+
+public:
+
+    explicit ScanProgress(QObject *parent = 0);
+
+    virtual ~ScanProgress();
+
+    bool isScanning() const;
+
+    qulonglong filesDiscovered() const;
+
+    qulonglong filesExtracted() const;
+
+    qulonglong tracksWritten() const;
+
+    qulonglong bytesScanned() const;
+
+    double filesPerSecond() const;
+
+    int remainingSeconds() const;
+
+    int updateInterval() const;
+
+    void scanStarted();
+
+    void scanFinished();
+
+    void addDiscoveredFiles(int filesCount);
+
+    void addExtractedFiles(int filesCount, qint64 bytesCount);
+
+    void addWrittenTracks(int tracksCount);
+
+Q_SIGNALS:
+
+    void progressChanged();
+
+    void updateIntervalChanged();
+
+public Q_SLOTS:
+
+    void setUpdateInterval(int updateInterval);
+
+private Q_SLOTS:
+
+    void startUpdates();
+
+    void updateProgress();
+
+private:
+
+    std::unique_ptr<ScanProgressPrivate> d;
+
+};
+
+#endif // SCANPROGRESS_H
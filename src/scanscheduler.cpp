@@ -0,0 +1,308 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "scanscheduler.h"
+
+#include <QThread>
+#include <QThreadStorage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QDir>
+
+#include <QDebug>
+
+#if defined Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+static const int maximumPriorityDirectories = 8;
+
+class ScanSchedulerPrivate
+{
+public:
+
+    mutable QMutex mMutex;
+
+    QWaitCondition mResumed;
+
+    bool mPaused = false;
+
+    int mCancelGeneration = 0;
+
+    int mActiveScans = 0;
+
+    QStringList mPriorityDirectories;
+
+    QAtomicInt mPriorityGeneration;
+
+    QAtomicInt mIdleIoPriority;
+
+    bool mPlaybackActive = false;
+
+};
+
+static QThreadStorage<int> appliedIoPriorities;
+
+static void setCurrentThreadIoPriority(bool idlePriority)
+{
+#if defined Q_OS_LINUX
+    static const int ioPriorityWhoProcess = 1;
+    static const int ioPriorityClassShift = 13;
+    static const int ioPriorityClassBestEffort = 2;
+    static const int ioPriorityClassIdle = 3;
+    static const int ioPriorityDefaultLevel = 4;
+
+    const auto ioPriority = idlePriority ? (ioPriorityClassIdle << ioPriorityClassShift) :
+                                           (ioPriorityClassBestEffort << ioPriorityClassShift | ioPriorityDefaultLevel);
+
+    if (syscall(SYS_ioprio_set, ioPriorityWhoProcess, 0, ioPriority) != 0) {
+        qDebug() << "ScanScheduler::setCurrentThreadIoPriority" << "cannot change I/O priority" << errno;
+    }
+#else
+    Q_UNUSED(idlePriority);
+#endif
+}
+
+ScanScheduler::ScanScheduler(QObject *parent) : QObject(parent), d(new ScanSchedulerPrivate)
+{
+}
+
+ScanScheduler::~ScanScheduler()
+{
+}
+
+bool ScanScheduler::isPaused() const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return d->mPaused;
+}
+
+bool ScanScheduler::isPlaybackActive() const
+{
+    return d->mPlaybackActive;
+}
+
+bool ScanScheduler::isIdleIoPriority() const
+{
+    return d->mIdleIoPriority.load() != 0;
+}
+
+QStringList ScanScheduler::priorityDirectories() const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return d->mPriorityDirectories;
+}
+
+int ScanScheduler::scanStarted()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    ++d->mActiveScans;
+
+    return d->mCancelGeneration;
+}
+
+void ScanScheduler::scanFinished()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    if (d->mActiveScans > 0) {
+        --d->mActiveScans;
+    }
+}
+
+bool ScanScheduler::isCancelled(int scanGeneration) const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return scanGeneration != d->mCancelGeneration;
+}
+
+bool ScanScheduler::waitForScanTurn(int scanGeneration)
+{
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        while (d->mPaused && scanGeneration == d->mCancelGeneration && !QThread::currentThread()->isInterruptionRequested()) {
+            d->mResumed.wait(&d->mMutex, 200);
+        }
+
+        if (scanGeneration != d->mCancelGeneration) {
+            return false;
+        }
+    }
+
+    applyIoPriority();
+
+    return !QThread::currentThread()->isInterruptionRequested();
+}
+
+bool ScanScheduler::isPriorityPath(const QString &localPath) const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return isPriorityPath(localPath, d->mPriorityDirectories);
+}
+
+int ScanScheduler::priorityGeneration() const
+{
+    return d->mPriorityGeneration.load();
+}
+
+bool ScanScheduler::isPriorityPath(const QString &localPath, const QStringList &priorityDirectories)
+{
+    for (const auto &onePriorityDirectory : priorityDirectories) {
+        const auto &shorterPath = localPath.size() < onePriorityDirectory.size() ? localPath : onePriorityDirectory;
+        const auto &longerPath = localPath.size() < onePriorityDirectory.size() ? onePriorityDirectory : localPath;
+
+        if (longerPath.startsWith(shorterPath) &&
+                (longerPath.size() == shorterPath.size() || longerPath.at(shorterPath.size()) == QLatin1Char('/'))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ScanScheduler::applyIoPriority()
+{
+    const auto idlePriority = d->mIdleIoPriority.load();
+
+    if (appliedIoPriorities.hasLocalData() && appliedIoPriorities.localData() == idlePriority) {
+        return;
+    }
+
+    setCurrentThreadIoPriority(idlePriority != 0);
+
+    appliedIoPriorities.setLocalData(idlePriority);
+}
+
+void ScanScheduler::pause()
+{
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (d->mPaused) {
+            return;
+        }
+
+        d->mPaused = true;
+    }
+
+    Q_EMIT pausedChanged();
+}
+
+void ScanScheduler::resume()
+{
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (!d->mPaused) {
+            return;
+        }
+
+        d->mPaused = false;
+        d->mResumed.wakeAll();
+    }
+
+    Q_EMIT pausedChanged();
+}
+
+void ScanScheduler::cancel()
+{
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (d->mActiveScans == 0) {
+            return;
+        }
+
+        ++d->mCancelGeneration;
+        d->mResumed.wakeAll();
+    }
+
+    Q_EMIT scanCancelled();
+}
+
+void ScanScheduler::setPlaybackActive(bool playbackActive)
+{
+    if (d->mPlaybackActive == playbackActive) {
+        return;
+    }
+
+    d->mPlaybackActive = playbackActive;
+    d->mIdleIoPriority.store(playbackActive ? 1 : 0);
+
+    Q_EMIT playbackActiveChanged();
+    Q_EMIT ioPriorityChanged();
+}
+
+void ScanScheduler::prioritizeDirectory(const QString &localPath)
+{
+    const auto &directoryPath = QDir::cleanPath(localPath);
+
+    if (directoryPath.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (!d->mPriorityDirectories.isEmpty() && d->mPriorityDirectories.first() == directoryPath) {
+            return;
+        }
+
+        d->mPriorityDirectories.removeAll(directoryPath);
+        d->mPriorityDirectories.prepend(directoryPath);
+
+        while (d->mPriorityDirectories.size() > maximumPriorityDirectories) {
+            d->mPriorityDirectories.removeLast();
+        }
+
+        d->mPriorityGeneration.ref();
+    }
+
+    Q_EMIT priorityDirectoriesChanged();
+}
+
+void ScanScheduler::clearPriorityDirectories()
+{
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (d->mPriorityDirectories.isEmpty()) {
+            return;
+        }
+
+        d->mPriorityDirectories.clear();
+
+        d->mPriorityGeneration.ref();
+    }
+
+    Q_EMIT priorityDirectoriesChanged();
+}
+
+
+#include "moc_scanscheduler.cpp"
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef SCANSCHEDULER_H
+#define SCANSCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+class ScanSchedulerPrivate;
+
+class ScanScheduler : public QObject
+{
+
+    Q_OBJECT
+
+    Q_CLASSINFO("D-Bus Interface", "org.kde.elisa.ScanScheduler")
+
+    Q_PROPERTY(bool paused
+               READ isPaused
+               NOTIFY pausedChanged)
+
+    Q_PROPERTY(bool playbackActive
+               READ isPlaybackActive
+               WRITE setPlaybackActive
+               NOTIFY playbackActiveChanged)
+
+    Q_PROPERTY(bool idleIoPriority
+               READ isIdleIoPriority
+               NOTIFY ioPriorityChanged)
+
+    Q_PROPERTY(QStringList priorityDirectories
+               READ priorityDirectories
+               NOTIFY priorityDirectoriesChanged)
+
+public:
+
+    explicit ScanScheduler(QObject *parent = 0);
+
+    virtual ~ScanScheduler();
+
+    bool isPaused() const;
+
+    bool isPlaybackActive() const;
+
+    bool isIdleIoPriority() const;
+
+    QStringList priorityDirectories() const;
+
+    int scanStarted();
+
+    void scanFinished();
+
+    bool isCancelled(int scanGeneration) const;
+
+    bool waitForScanTurn(int scanGeneration);
+
+    bool isPriorityPath(const QString &localPath) const;
+
+    int priorityGeneration() const;
+
+    static bool isPriorityPath(const QString &localPath, const QStringList &priorityDirectories);
+
+    void applyIoPriority();
+
+Q_SIGNALS:
+
+    void pausedChanged();
+
+    void playbackActiveChanged();
+
+    void ioPriorityChanged();
+
+    void priorityDirectoriesChanged();
+
+    void scanCancelled();
+
+public Q_SLOTS:
+
+    void pause();
+
+    void resume();
+
+    void cancel();
+
+    void setPlaybackActive(bool playbackActive);
+
+    void prioritizeDirectory(const QString &localPath);
+
+    void clearPriorityDirectories();
+
+private:
+
+    std::unique_ptr<ScanSchedulerPrivate> d;
+
+};
+
+#endif // SCANSCHEDULER_H
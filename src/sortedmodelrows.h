@@ -0,0 +1,294 @@
+/*
+ * Copyright 2026 agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef SORTEDMODELROWS_H
+#define SORTEDMODELROWS_H
+
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QCollator>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+class ModelSortKey
+{
+public:
+
+    ModelSortKey(std::vector<QCollatorSortKey> keys, qulonglong databaseId)
+        : mKeys(std::move(keys)), mDatabaseId(databaseId)
+    {
+    }
+
+    bool operator<(const ModelSortKey &other) const
+    {
+        for (std::size_t i = 0; i < mKeys.size() && i < other.mKeys.size(); ++i) {
+            const auto result = mKeys[i].compare(other.mKeys[i]);
+
+            if (result != 0) {
+                return result < 0;
+            }
+        }
+
+        return mDatabaseId < other.mDatabaseId;
+    }
+
+    std::vector<QCollatorSortKey> mKeys;
+
+    qulonglong mDatabaseId;
+
+};
+
+template <typename Item>
+class SortedModelRows
+{
+public:
+
+    int size() const
+    {
+        return mItems.size();
+    }
+
+    const Item &at(int row) const
+    {
+        return mItems[row];
+    }
+
+    bool contains(qulonglong databaseId) const
+    {
+        return mRowsIndex.contains(databaseId);
+    }
+
+    int insertionRow(const ModelSortKey &key, int skippedRow) const
+    {
+        auto firstRow = 0;
+        auto lastRow = int(mSortKeys.size()) - (skippedRow == -1 ? 0 : 1);
+
+        while (firstRow < lastRow) {
+            const auto middleRow = firstRow + (lastRow - firstRow) / 2;
+            const auto storedRow = (skippedRow != -1 && middleRow >= skippedRow ? middleRow + 1 : middleRow);
+
+            if (key < mSortKeys[storedRow]) {
+                lastRow = middleRow;
+            } else {
+                firstRow = middleRow + 1;
+            }
+        }
+
+        return firstRow;
+    }
+
+    void updateRowsIndex(int firstRow, int lastRow = -1)
+    {
+        if (lastRow == -1) {
+            lastRow = mItems.size() - 1;
+        }
+
+        for (int i = firstRow; i <= lastRow; ++i) {
+            mRowsIndex[mItems[i].databaseId()] = i;
+        }
+    }
+
+    QVector<int> rowsOf(const QList<Item> &items) const
+    {
+        auto result = QVector<int>();
+        result.reserve(items.size());
+
+        for (const auto &oneItem : items) {
+            auto itRow = mRowsIndex.constFind(oneItem.databaseId());
+            if (itRow != mRowsIndex.constEnd()) {
+                result.push_back(itRow.value());
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+
+        return result;
+    }
+
+    template <typename MakeSortKey, typename BeginInsertRows, typename EndInsertRows>
+    void insert(const QList<Item> &newItems, MakeSortKey sortKey, BeginInsertRows beginInsertRows, EndInsertRows endInsertRows)
+    {
+        auto validItems = std::vector<std::pair<ModelSortKey, Item>>();
+        validItems.reserve(newItems.size());
+
+        auto validItemsIds = QSet<qulonglong>();
+
+        for (const auto &oneItem : newItems) {
+            if (oneItem.isValid() && !mRowsIndex.contains(oneItem.databaseId()) && !validItemsIds.contains(oneItem.databaseId())) {
+                validItems.emplace_back(sortKey(oneItem), oneItem);
+                validItemsIds.insert(oneItem.databaseId());
+            }
+        }
+
+        if (validItems.empty()) {
+            return;
+        }
+
+        sortItems(validItems);
+
+        auto insertionRows = QVector<int>();
+        insertionRows.reserve(int(validItems.size()));
+
+        for (const auto &oneItem : validItems) {
+            insertionRows.push_back(insertionRow(oneItem.first, -1));
+        }
+
+        auto lastNewItem = int(validItems.size()) - 1;
+        while (lastNewItem >= 0) {
+            const auto firstRow = insertionRows[lastNewItem];
+
+            auto firstNewItem = lastNewItem;
+            while (firstNewItem > 0 && insertionRows[firstNewItem - 1] == firstRow) {
+                --firstNewItem;
+            }
+
+            beginInsertRows(firstRow, firstRow + lastNewItem - firstNewItem);
+            for (int i = firstNewItem; i <= lastNewItem; ++i) {
+                mItems.insert(firstRow + i - firstNewItem, validItems[i].second);
+                mSortKeys.insert(mSortKeys.begin() + firstRow + i - firstNewItem, validItems[i].first);
+            }
+            endInsertRows();
+
+            lastNewItem = firstNewItem - 1;
+        }
+
+        updateRowsIndex(insertionRows.first());
+    }
+
+    template <typename BeginRemoveRows, typename EndRemoveRows>
+    void remove(const QList<Item> &removedItems, BeginRemoveRows beginRemoveRows, EndRemoveRows endRemoveRows)
+    {
+        const auto &removedRows = rowsOf(removedItems);
+
+        if (removedRows.isEmpty()) {
+            return;
+        }
+
+        for (const auto &oneItem : removedItems) {
+            mRowsIndex.remove(oneItem.databaseId());
+        }
+
+        auto lastRow = removedRows.size() - 1;
+        while (lastRow >= 0) {
+            auto firstRow = lastRow;
+            while (firstRow > 0 && removedRows[firstRow - 1] == removedRows[firstRow] - 1) {
+                --firstRow;
+            }
+
+            beginRemoveRows(removedRows[firstRow], removedRows[lastRow]);
+            mItems.erase(mItems.begin() + removedRows[firstRow], mItems.begin() + removedRows[lastRow] + 1);
+            mSortKeys.erase(mSortKeys.begin() + removedRows[firstRow], mSortKeys.begin() + removedRows[lastRow] + 1);
+            endRemoveRows();
+
+            lastRow = firstRow - 1;
+        }
+
+        updateRowsIndex(removedRows.first());
+    }
+
+    template <typename MakeSortKey, typename BeginMoveRow, typename EndMoveRow, typename RowsChanged>
+    void modify(const QList<Item> &modifiedItems, MakeSortKey sortKey, BeginMoveRow beginMoveRow, EndMoveRow endMoveRow,
+                RowsChanged rowsChanged)
+    {
+        for (const auto &oneItem : modifiedItems) {
+            auto itRow = mRowsIndex.constFind(oneItem.databaseId());
+            if (itRow == mRowsIndex.constEnd()) {
+                continue;
+            }
+
+            const auto currentRow = itRow.value();
+            const auto &newKey = sortKey(oneItem);
+            const auto newRow = insertionRow(newKey, currentRow);
+
+            if (newRow != currentRow) {
+                beginMoveRow(currentRow, (newRow > currentRow ? newRow + 1 : newRow));
+                mItems.move(currentRow, newRow);
+                mSortKeys.erase(mSortKeys.begin() + currentRow);
+                mSortKeys.insert(mSortKeys.begin() + newRow, newKey);
+                updateRowsIndex(std::min(currentRow, newRow), std::max(currentRow, newRow));
+                endMoveRow();
+            } else {
+                mSortKeys[newRow] = newKey;
+            }
+
+            mItems[newRow] = oneItem;
+        }
+
+        const auto &modifiedRows = rowsOf(modifiedItems);
+
+        auto firstRow = 0;
+        while (firstRow < modifiedRows.size()) {
+            auto lastRow = firstRow;
+            while (lastRow + 1 < modifiedRows.size() && modifiedRows[lastRow + 1] == modifiedRows[lastRow] + 1) {
+                ++lastRow;
+            }
+
+            rowsChanged(modifiedRows[firstRow], modifiedRows[lastRow]);
+
+            firstRow = lastRow + 1;
+        }
+    }
+
+    template <typename MakeSortKey>
+    void sort(MakeSortKey sortKey)
+    {
+        auto sortedItems = std::vector<std::pair<ModelSortKey, Item>>();
+        sortedItems.reserve(mItems.size());
+
+        for (const auto &oneItem : mItems) {
+            sortedItems.emplace_back(sortKey(oneItem), oneItem);
+        }
+
+        sortItems(sortedItems);
+
+        mItems.clear();
+        mSortKeys.clear();
+
+        for (const auto &oneItem : sortedItems) {
+            mItems.push_back(oneItem.second);
+            mSortKeys.push_back(oneItem.first);
+        }
+
+        mRowsIndex.clear();
+        updateRowsIndex(0);
+    }
+
+    QVector<Item> mItems;
+
+    std::vector<ModelSortKey> mSortKeys;
+
+    QHash<qulonglong, int> mRowsIndex;
+
+private:
+
+    static void sortItems(std::vector<std::pair<ModelSortKey, Item>> &items)
+    {
+        std::sort(items.begin(), items.end(), [](const std::pair<ModelSortKey, Item> &first, const std::pair<ModelSortKey, Item> &second) {
+            return first.first < second.first;
+        });
+    }
+
+};
+
+#endif // SORTEDMODELROWS_H
@@ -35,6 +35,8 @@ public:
 
     QList<std::array<QString, 3>> mTracksByNameSet;
 
+    QList<QString> mPendingArtists;
+
     DatabaseInterface *mDatabase = nullptr;
 
 };
@@ -66,10 +68,25 @@ void TracksListener::trackAdded(MusicAudioTrack newTrack)
     }
 }
 
+void TracksListener::tracksAdded(const QList<MusicAudioTrack> &newTracks)
+{
+    if (d->mTracksByIdSet.isEmpty() && d->mTracksByNameSet.isEmpty()) {
+        return;
+    }
+
+    for (const auto &oneTrack : newTracks) {
+        trackAdded(oneTrack);
+    }
+}
+
 void TracksListener::trackByNameInList(QString title, QString artist, QString album)
 {
     d->mTracksByNameSet.push_back({title, artist, album});
 
+    if (!d->mDatabase->isInitialized()) {
+        return;
+    }
+
     auto newTrackId = d->mDatabase->trackIdFromTitleAlbumArtist(title, album, artist);
     if (newTrackId == 0) {
         return;
@@ -86,6 +103,10 @@ void TracksListener::trackByIdInList(qulonglong newTrackId)
 {
     d->mTracksByIdSet.insert(newTrackId);
 
+    if (!d->mDatabase->isInitialized()) {
+        return;
+    }
+
     auto newTrack = d->mDatabase->trackFromDatabaseId(newTrackId);
     if (newTrack.isValid()) {
         Q_EMIT trackChanged(newTrack);
@@ -94,6 +115,11 @@ void TracksListener::trackByIdInList(qulonglong newTrackId)
 
 void TracksListener::newArtistInList(QString artist)
 {
+    if (!d->mDatabase->isInitialized()) {
+        d->mPendingArtists.push_back(artist);
+        return;
+    }
+
     auto newTracks = d->mDatabase->tracksFromAuthor(artist);
     if (newTracks.isEmpty()) {
         return;
@@ -102,5 +128,34 @@ void TracksListener::newArtistInList(QString artist)
     Q_EMIT albumAdded(newTracks);
 }
 
+void TracksListener::databaseReady()
+{
+    for (auto oneTrackId : d->mTracksByIdSet) {
+        auto newTrack = d->mDatabase->trackFromDatabaseId(oneTrackId);
+        if (newTrack.isValid()) {
+            Q_EMIT trackChanged(newTrack);
+        }
+    }
+
+    for (const auto &oneTrack : d->mTracksByNameSet) {
+        auto newTrackId = d->mDatabase->trackIdFromTitleAlbumArtist(oneTrack[0], oneTrack[2], oneTrack[1]);
+        if (newTrackId == 0) {
+            continue;
+        }
+
+        auto newTrack = d->mDatabase->trackFromDatabaseId(newTrackId);
+        if (newTrack.isValid()) {
+            Q_EMIT trackChanged(newTrack);
+        }
+    }
+
+    const auto pendingArtists = d->mPendingArtists;
+    d->mPendingArtists.clear();
+
+    for (const auto &oneArtist : pendingArtists) {
+        newArtistInList(oneArtist);
+    }
+}
+
 
 #include "moc_trackslistener.cpp"
@@ -45,12 +45,16 @@ public Q_SLOTS:
 
     void trackAdded(MusicAudioTrack newTrack);
 
+    void tracksAdded(const QList<MusicAudioTrack> &newTracks);
+
     void trackByNameInList(QString title, QString artist, QString album);
 
     void trackByIdInList(qulonglong newTrackId);
 
     void newArtistInList(QString artist);
 
+    void databaseReady();
+
 private:
 
     TracksListenerPrivate *d = nullptr;
@@ -49,6 +49,8 @@
 #include "allartistsmodel.h"
 #include "musicaudiotrack.h"
 #include "musiclistenersmanager.h"
+#include "scanprogress.h"
+#include "scanscheduler.h"
 #include "albumfilterproxymodel.h"
 #include "elisaapplication.h"
 #include "audiowrapper.h"
@@ -135,6 +137,8 @@ int __attribute__((visibility("default"))) main(int argc, char *argv[])
     qmlRegisterType<AllArtistsModel>("org.mgallien.QmlExtension", 1, 0, "AllArtistsModel");
     qmlRegisterType<AlbumModel>("org.mgallien.QmlExtension", 1, 0, "AlbumModel");
     qmlRegisterType<MusicListenersManager>("org.mgallien.QmlExtension", 1, 0, "MusicListenersManager");
+    qmlRegisterUncreatableType<ScanProgress>("org.mgallien.QmlExtension", 1, 0, "ScanProgress", QStringLiteral("owned by MusicListenersManager"));
+    qmlRegisterUncreatableType<ScanScheduler>("org.mgallien.QmlExtension", 1, 0, "ScanScheduler", QStringLiteral("owned by MusicListenersManager"));
     qmlRegisterType<QSortFilterProxyModel>("org.mgallien.QmlExtension", 1, 0, "SortFilterProxyModel");
     qmlRegisterType<AlbumFilterProxyModel>("org.mgallien.QmlExtension", 1, 0, "AlbumFilterProxyModel");
     qmlRegisterType<AudioWrapper>("org.mgallien.QmlExtension", 1, 0, "AudioWrapper");
@@ -152,6 +156,9 @@ int __attribute__((visibility("default"))) main(int argc, char *argv[])
     qRegisterMetaType<QHash<qulonglong,int>>("QHash<qulonglong,int>");
     qRegisterMetaType<MusicAlbum>("MusicAlbum");
     qRegisterMetaType<MusicArtist>("MusicArtist");
+    qRegisterMetaType<QList<MusicAlbum>>("QList<MusicAlbum>");
+    qRegisterMetaType<QList<MusicArtist>>("QList<MusicArtist>");
+    qRegisterMetaType<QList<qulonglong>>("QList<qulonglong>");
     qRegisterMetaType<QAction*>();
     qmlRegisterUncreatableType<ElisaApplication>("org.mgallien.QmlExtension", 1, 0, "ElisaApplication", QStringLiteral("only one and done in c++"));
 